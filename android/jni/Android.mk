@@ -45,16 +45,20 @@ include $(CLEAR_VARS)
 LOCAL_MODULE    := platformer-sample
 LOCAL_SRC_FILES :=  ../external/GamePlay/gameplay/src/gameplay-main-android.cpp \
                     AudioComponent.cpp \
+                    AudioVoicePool.cpp \
                     CameraComponent.cpp \
                     CharacterRenderer.cpp \
                     Common.cpp \
                     Debug.cpp \
                     EnemyComponent.cpp \
+                    LevelActivationComponent.cpp \
                     LevelCollisionComponent.cpp \
                     LevelCollision.cpp \
                     LevelLoaderComponent.cpp \
                     LevelPlatformsComponent.cpp \
                     LevelRendererComponent.cpp \
+                    LoadPipeline.cpp \
+                    LogWriter.cpp \
                     PhysicsLoaderComponent.cpp \
                     Platformer.cpp \
                     PlayerComponent.cpp \
@@ -65,6 +69,7 @@ LOCAL_SRC_FILES :=  ../external/GamePlay/gameplay/src/gameplay-main-android.cpp
                     SpriteAnimationComponent.cpp \
                     SpriteSheet.cpp \
                     UI.cpp \
+                    World.cpp \
 
 
 LOCAL_CPPFLAGS += -std=c++11 -Wno-switch-enum -Wno-switch
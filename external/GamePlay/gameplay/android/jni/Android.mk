@@ -26,6 +26,7 @@ LOCAL_SRC_FILES := \
     AnimationController.cpp \
     AnimationTarget.cpp \
     AnimationValue.cpp \
+    Arena.cpp \
     AudioBuffer.cpp \
     AudioController.cpp \
     AudioListener.cpp \
@@ -52,9 +53,11 @@ LOCAL_SRC_FILES := \
     Frustum.cpp \
     Game.cpp \
     Gamepad.cpp \
+    GLStateCache.cpp \
     HeightField.cpp \
     Image.cpp \
     ImageControl.cpp \
+    JobController.cpp \
     Joint.cpp \
     JoystickControl.cpp \
     Label.cpp \
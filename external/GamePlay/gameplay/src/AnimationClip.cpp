@@ -15,7 +15,7 @@ AnimationClip::AnimationClip(const char* id, Animation* animation, unsigned long
     : _id(id), _animation(animation), _startTime(startTime), _endTime(endTime), _duration(_endTime - _startTime), 
       _stateBits(0x00), _repeatCount(1.0f), _loopBlendTime(0), _activeDuration(_duration * _repeatCount), _speed(1.0f), _timeStarted(0), 
       _elapsedTime(0), _crossFadeToClip(NULL), _crossFadeOutElapsed(0), _crossFadeOutDuration(0), _blendWeight(1.0f),
-      _beginListeners(NULL), _endListeners(NULL), _listeners(NULL), _listenerItr(NULL)
+      _appliedBlendWeight(1.0f), _percentComplete(0.0f), _beginListeners(NULL), _endListeners(NULL), _listeners(NULL), _listenerItr(NULL)
 {
     GP_REGISTER_SCRIPT_EVENTS();
 
@@ -399,9 +399,25 @@ void AnimationClip::removeEndListener(AnimationClip::Listener* listener)
 
 bool AnimationClip::update(float elapsedTime)
 {
-    if (isClipStateBitSet(CLIP_IS_PAUSED_BIT))
+    switch (advance(elapsedTime))
     {
+    case ADVANCE_PAUSED:
         return false;
+    case ADVANCE_ENDED:
+        return true;
+    default:
+        break;
+    }
+
+    evaluate();
+    return apply();
+}
+
+AnimationClip::AdvanceResult AnimationClip::advance(float elapsedTime)
+{
+    if (isClipStateBitSet(CLIP_IS_PAUSED_BIT))
+    {
+        return ADVANCE_PAUSED;
     }
 
     if (isClipStateBitSet(CLIP_IS_MARKED_FOR_REMOVAL_BIT))
@@ -410,7 +426,7 @@ bool AnimationClip::update(float elapsedTime)
         // after the last update call. Reset the flag, and return true so the AnimationClip is removed from the 
         // running clips on the AnimationController.
         onEnd();
-        return true;
+        return ADVANCE_ENDED;
     }
 
     if (!isClipStateBitSet(CLIP_IS_STARTED_BIT))
@@ -498,10 +514,10 @@ bool AnimationClip::update(float elapsedTime)
     // Compute percentage complete for the current loop (prevent a divide by zero if _duration==0).
     // Note that we don't use (currentTime/(_duration+_loopBlendTime)). That's because we want a
     // % value that is outside the 0-1 range for loop smoothing/blending purposes.
-    float percentComplete = _duration == 0 ? 1 : currentTime / (float)_duration;
+    _percentComplete = _duration == 0 ? 1 : currentTime / (float)_duration;
 
     if (_loopBlendTime == 0.0f)
-        percentComplete = MATH_CLAMP(percentComplete, 0.0f, 1.0f);
+        _percentComplete = MATH_CLAMP(_percentComplete, 0.0f, 1.0f);
 
     // If we're cross fading, compute blend weights
     if (isClipStateBitSet(CLIP_IS_FADING_OUT_BIT))
@@ -550,11 +566,19 @@ bool AnimationClip::update(float elapsedTime)
             SAFE_RELEASE(_crossFadeToClip);
         }
     }
-    
-    // Evaluate this clip.
+
+    // Clips that are cross fading change each other's weight, keep the weight this clip had when it was advanced
+    _appliedBlendWeight = _blendWeight;
+
+    return ADVANCE_EVALUATE;
+}
+
+void AnimationClip::evaluate()
+{
+    GP_ASSERT(_animation);
+
     Animation::Channel* channel = NULL;
     AnimationValue* value = NULL;
-    AnimationTarget* target = NULL;
     size_t channelCount = _animation->_channels.size();
     float percentageStart = (float)_startTime / (float)_animation->_duration;
     float percentageEnd = (float)_endTime / (float)_animation->_duration;
@@ -563,17 +587,31 @@ bool AnimationClip::update(float elapsedTime)
     {
         channel = _animation->_channels[i];
         GP_ASSERT(channel);
-        target = channel->_target;
-        GP_ASSERT(target);
         value = _values[i];
         GP_ASSERT(value);
 
         // Evaluate the point on Curve
         GP_ASSERT(channel->getCurve());
-        channel->getCurve()->evaluate(percentComplete, percentageStart, percentageEnd, percentageBlend, value->_value);
+        channel->getCurve()->evaluate(_percentComplete, percentageStart, percentageEnd, percentageBlend, value->_value);
+    }
+}
+
+bool AnimationClip::apply()
+{
+    GP_ASSERT(_animation);
+
+    Animation::Channel* channel = NULL;
+    AnimationTarget* target = NULL;
+    size_t channelCount = _animation->_channels.size();
+    for (size_t i = 0; i < channelCount; i++)
+    {
+        channel = _animation->_channels[i];
+        GP_ASSERT(channel);
+        target = channel->_target;
+        GP_ASSERT(target);
 
         // Set the animation value on the target property.
-        target->setAnimationPropertyValue(channel->_propertyId, value, _blendWeight);
+        target->setAnimationPropertyValue(channel->_propertyId, _values[i], _appliedBlendWeight);
     }
 
     // When ended. Probably should move to it's own method so we can call it when the clip is ended early.
@@ -347,11 +347,42 @@ private:
      */
     AnimationClip& operator=(const AnimationClip&);
 
+    /**
+     * The result of advancing a clip.
+     */
+    enum AdvanceResult
+    {
+        ADVANCE_PAUSED,
+        ADVANCE_ENDED,
+        ADVANCE_EVALUATE
+    };
+
     /**
      * Updates the animation with the elapsed time.
      */
     bool update(float elapsedTime);
 
+    /**
+     * Advances the time and blend weights of the clip and notifies its listeners.
+     *
+     * When the result is ADVANCE_EVALUATE the clip must be evaluated and applied.
+     */
+    AdvanceResult advance(float elapsedTime);
+
+    /**
+     * Evaluates the curves of the clip at the time it was advanced to.
+     *
+     * Only writes to the clip's own values, so clips can be evaluated in parallel.
+     */
+    void evaluate();
+
+    /**
+     * Sets the evaluated values on the animation targets.
+     *
+     * @return True if the clip ended and should be removed from the AnimationController.
+     */
+    bool apply();
+
     /**
      * Handles when the AnimationClip begins.
      */
@@ -402,6 +433,8 @@ private:
     float _crossFadeOutElapsed;                         // The amount of time that has elapsed for the crossfade.
     unsigned long _crossFadeOutDuration;                // The duration of the cross fade.
     float _blendWeight;                                 // The clip's blendweight.
+    float _appliedBlendWeight;                          // The blend weight when the clip was advanced.
+    float _percentComplete;                             // The percentage of the current loop when the clip was advanced.
     std::vector<AnimationValue*> _values;               // AnimationValue holder.
     std::vector<Listener*>* _beginListeners;            // Collection of begin listeners on the clip.
     std::vector<Listener*>* _endListeners;              // Collection of end listeners on the clip.
@@ -3,6 +3,10 @@
 #include "Game.h"
 #include "Curve.h"
 
+// Below this many running clips the curves are evaluated without jobs
+#define PARALLEL_UPDATE_MIN_CLIPS 16
+#define EVALUATE_GRAIN_SIZE 8
+
 namespace gameplay
 {
 
@@ -100,6 +104,16 @@ void AnimationController::update(float elapsedTime)
     
     Transform::suspendTransformChanged();
 
+    if (_runningClips.size() >= PARALLEL_UPDATE_MIN_CLIPS && Game::getInstance()->getJobController()->getWorkerCount() > 0)
+    {
+        updateParallel(elapsedTime);
+        Transform::resumeTransformChanged();
+
+        if (_runningClips.empty())
+            _state = IDLE;
+        return;
+    }
+
     // Loop through running clips and call update() on them.
     std::list<AnimationClip*>::iterator clipIter = _runningClips.begin();
     while (clipIter != _runningClips.end())
@@ -133,4 +147,67 @@ void AnimationController::update(float elapsedTime)
         _state = IDLE;
 }
 
+void AnimationController::updateParallel(float elapsedTime)
+{
+    PROFILE();
+
+    // Advance the clips in order since their listeners can start and stop other clips.
+    std::list<AnimationClip*>::iterator clipIter = _runningClips.begin();
+    while (clipIter != _runningClips.end())
+    {
+        AnimationClip* clip = (*clipIter);
+        GP_ASSERT(clip);
+        clip->addRef();
+        if (clip->isClipStateBitSet(AnimationClip::CLIP_IS_RESTARTED_BIT))
+        {   // If the CLIP_IS_RESTARTED_BIT is set, we should end the clip and 
+            // move it from where it is in the running clips list to the back.
+            clip->onEnd();
+            clip->setClipStateBit(AnimationClip::CLIP_IS_PLAYING_BIT);
+            _runningClips.push_back(clip);
+            clipIter = _runningClips.erase(clipIter);
+        }
+        else
+        {
+            AnimationClip::AdvanceResult result = clip->advance(elapsedTime);
+            if (result == AnimationClip::ADVANCE_ENDED)
+            {
+                clip->release();
+                clipIter = _runningClips.erase(clipIter);
+            }
+            else
+            {
+                if (result == AnimationClip::ADVANCE_EVALUATE)
+                {
+                    clip->addRef();
+                    _evaluatedClips.push_back(clip);
+                }
+                clipIter++;
+            }
+        }
+        clip->release();
+    }
+
+    // Evaluating the curves only writes to each clip's own values.
+    Game::getInstance()->getJobController()->parallelFor(_evaluatedClips.size(), EVALUATE_GRAIN_SIZE, [this](unsigned int begin, unsigned int end)
+    {
+        for (unsigned int i = begin; i < end; ++i)
+        {
+            _evaluatedClips[i]->evaluate();
+        }
+    });
+
+    // Several clips can blend into the same property, so the values are applied in order.
+    for (size_t i = 0; i < _evaluatedClips.size(); ++i)
+    {
+        AnimationClip* clip = _evaluatedClips[i];
+        if (clip->apply())
+        {
+            unschedule(clip);
+        }
+        clip->release();
+    }
+
+    _evaluatedClips.clear();
+}
+
 }
@@ -95,9 +95,15 @@ private:
      * Callback for when the controller receives a frame update event.
      */
     void update(float elapsedTime);
+
+    /**
+     * Updates the running clips with their curves evaluated in jobs.
+     */
+    void updateParallel(float elapsedTime);
     
     State _state;                                 // The current state of the AnimationController.
     std::list<AnimationClip*> _runningClips;      // A list of running AnimationClips.
+    std::vector<AnimationClip*> _evaluatedClips;  // The clips advanced in this update that are waiting to be evaluated.
 };
 
 }
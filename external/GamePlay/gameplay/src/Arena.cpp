@@ -0,0 +1,229 @@
+#include "Base.h"
+#include "Arena.h"
+
+// The arena calls the global operators itself, so that its heap allocations are still recorded by DebugNew
+#ifdef GP_USE_MEM_LEAK_DETECTION
+#undef new
+#endif
+
+namespace gameplay
+{
+
+// The arena made current on the calling thread
+static thread_local Arena* __currentArena = NULL;
+
+// Objects are rounded up to a multiple of the granularity, which also keeps them aligned
+#define ARENA_GRANULARITY 16
+
+// Objects up to this size, including their header, are pooled and larger ones come from the heap
+#define ARENA_MAX_POOLED_SIZE 2048
+
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+// The header is padded to the granularity so that the object after it stays aligned
+#define ARENA_HEADER_SIZE ARENA_GRANULARITY
+
+Arena::Scope::Scope(Arena* arena)
+    : _previous(__currentArena)
+{
+    GP_ASSERT(!arena || !arena->_retired);
+    __currentArena = arena;
+}
+
+Arena::Scope::~Scope()
+{
+    __currentArena = _previous;
+}
+
+Arena::Scope::Scope(const Scope& copy)
+{
+    // Hidden
+}
+
+Arena::Arena(size_t blockSize)
+    : _blockSize(blockSize), _cursor(NULL), _end(NULL), _freeLists(ARENA_MAX_POOLED_SIZE / ARENA_GRANULARITY, NULL),
+      _liveBytes(0), _liveObjects(0), _retired(false)
+{
+}
+
+Arena::Arena(const Arena& copy)
+{
+    // Hidden
+}
+
+Arena::~Arena()
+{
+    GP_ASSERT(_liveObjects == 0);
+
+    for (size_t i = 0; i < _blocks.size(); ++i)
+    {
+        ::operator delete(_blocks[i]);
+    }
+}
+
+Arena* Arena::create(size_t blockSize)
+{
+    return new Arena(std::max<size_t>(blockSize > 0 ? blockSize : ARENA_DEFAULT_BLOCK_SIZE, ARENA_MAX_POOLED_SIZE));
+}
+
+void Arena::retire()
+{
+    bool release;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        GP_ASSERT(!_retired);
+        _retired = true;
+        release = _liveObjects == 0;
+    }
+
+    if (release)
+    {
+        delete this;
+    }
+}
+
+Arena::Stats Arena::getStats() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    Stats stats;
+    stats.blocks = _blocks.size();
+    stats.reservedBytes = _blocks.size() * _blockSize;
+    stats.liveBytes = _liveBytes;
+    stats.liveObjects = _liveObjects;
+    return stats;
+}
+
+Arena* Arena::getCurrent()
+{
+    return __currentArena;
+}
+
+void* Arena::allocate(size_t size)
+{
+    const size_t totalSize = size + ARENA_HEADER_SIZE;
+    Header* header;
+
+    if (__currentArena && totalSize <= ARENA_MAX_POOLED_SIZE)
+    {
+        header = static_cast<Header*>(__currentArena->allocateObject((totalSize - 1) / ARENA_GRANULARITY));
+    }
+    else
+    {
+        header = static_cast<Header*>(::operator new(totalSize));
+        header->arena = NULL;
+    }
+
+    return reinterpret_cast<char*>(header) + ARENA_HEADER_SIZE;
+}
+
+#ifdef GP_USE_MEM_LEAK_DETECTION
+void* Arena::allocate(size_t size, const char* file, int line)
+{
+    const size_t totalSize = size + ARENA_HEADER_SIZE;
+
+    if (__currentArena && totalSize <= ARENA_MAX_POOLED_SIZE)
+    {
+        return allocate(size);
+    }
+
+    Header* header = static_cast<Header*>(::operator new(totalSize, file, line));
+    header->arena = NULL;
+    return reinterpret_cast<char*>(header) + ARENA_HEADER_SIZE;
+}
+#endif
+
+void Arena::deallocate(void* memory)
+{
+    if (!memory)
+        return;
+
+    Header* header = reinterpret_cast<Header*>(static_cast<char*>(memory) - ARENA_HEADER_SIZE);
+
+    if (header->arena)
+    {
+        header->arena->deallocateObject(header);
+    }
+    else
+    {
+        ::operator delete(header);
+    }
+}
+
+void* Arena::allocateObject(unsigned int sizeClass)
+{
+    const size_t size = (sizeClass + 1) * ARENA_GRANULARITY;
+    Header* header;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    GP_ASSERT(!_retired);
+
+    if (_freeLists[sizeClass])
+    {
+        // A free object keeps the next free object of its size where its arena pointer was
+        header = _freeLists[sizeClass];
+        _freeLists[sizeClass] = reinterpret_cast<Header*>(header->arena);
+    }
+    else
+    {
+        if (_cursor + size > _end)
+        {
+            // The rest of the current block is given up, it is smaller than the largest object
+            _blocks.push_back(static_cast<char*>(::operator new(_blockSize)));
+            _cursor = _blocks.back();
+            _end = _cursor + _blockSize;
+        }
+
+        header = reinterpret_cast<Header*>(_cursor);
+        _cursor += size;
+    }
+
+    header->arena = this;
+    header->sizeClass = sizeClass;
+    _liveBytes += size;
+    ++_liveObjects;
+    return header;
+}
+
+void Arena::deallocateObject(Header* header)
+{
+    bool release;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        GP_ASSERT(_liveObjects > 0);
+        const unsigned int sizeClass = header->sizeClass;
+        header->arena = reinterpret_cast<Arena*>(_freeLists[sizeClass]);
+        _freeLists[sizeClass] = header;
+        _liveBytes -= (sizeClass + 1) * ARENA_GRANULARITY;
+        --_liveObjects;
+        release = _retired && _liveObjects == 0;
+    }
+
+    if (release)
+    {
+        delete this;
+    }
+}
+
+void* ArenaObject::operator new(std::size_t size)
+{
+    return Arena::allocate(size);
+}
+
+void ArenaObject::operator delete(void* memory)
+{
+    Arena::deallocate(memory);
+}
+
+#ifdef GP_USE_MEM_LEAK_DETECTION
+void* ArenaObject::operator new(std::size_t size, const char* file, int line)
+{
+    return Arena::allocate(size, file, line);
+}
+
+void ArenaObject::operator delete(void* memory, const char* file, int line)
+{
+    Arena::deallocate(memory);
+}
+#endif
+
+}
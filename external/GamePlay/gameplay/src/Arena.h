@@ -0,0 +1,167 @@
+#ifndef ARENA_H_
+#define ARENA_H_
+
+#include "Base.h"
+
+namespace gameplay
+{
+
+/**
+ * Allocates objects that share a lifetime, such as those of a level, from a few large blocks that are released together.
+ *
+ * Classes opt in by deriving from ArenaObject. Objects of those classes that are created while an arena is current on
+ * the calling thread, see Arena::Scope, come from that arena and the others come from the heap. Deleting an object
+ * puts its memory on a free list for its size, so objects which come and go during the lifetime of the arena reuse it.
+ *
+ * An arena is retired rather than deleted, its blocks are released once the last of its objects has been deleted,
+ * which is usually straight away.
+ *
+ * @script{ignore}
+ */
+class Arena
+{
+public:
+
+    /**
+     * Makes an arena current on the calling thread until it goes out of scope.
+     */
+    class Scope
+    {
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param arena The arena to allocate from, or NULL to allocate from the heap.
+         */
+        explicit Scope(Arena* arena);
+
+        /**
+         * Destructor, makes the previous arena current again.
+         */
+        ~Scope();
+
+    private:
+
+        Scope(const Scope& copy);
+
+        Arena* _previous;
+    };
+
+    /**
+     * What an arena holds.
+     */
+    struct Stats
+    {
+        /** The number of blocks. */
+        unsigned int blocks;
+        /** The size of the blocks in bytes. */
+        size_t reservedBytes;
+        /** The bytes of the objects that haven't been deleted. */
+        size_t liveBytes;
+        /** The number of objects that haven't been deleted. */
+        unsigned int liveObjects;
+    };
+
+    /**
+     * Creates an arena.
+     *
+     * @param blockSize The size of the blocks in bytes, or 0 for the default.
+     * @return The new arena.
+     */
+    static Arena* create(size_t blockSize = 0);
+
+    /**
+     * Releases the arena once all of its objects have been deleted, no more objects can be allocated from it.
+     */
+    void retire();
+
+    /**
+     * Gets what the arena holds.
+     *
+     * @return The stats.
+     */
+    Stats getStats() const;
+
+    /**
+     * Gets the arena that is current on the calling thread.
+     *
+     * @return The current arena, or NULL if there isn't one.
+     */
+    static Arena* getCurrent();
+
+    /**
+     * Allocates memory from the current arena, or the heap if there isn't one or the size is too large to pool.
+     *
+     * @param size The size in bytes.
+     * @return The memory, aligned to 16 bytes.
+     */
+    static void* allocate(size_t size);
+
+#ifdef GP_USE_MEM_LEAK_DETECTION
+    /**
+     * Allocates memory the same way as allocate(size), heap allocations are recorded against the file and line.
+     */
+    static void* allocate(size_t size, const char* file, int line);
+#endif
+
+    /**
+     * Frees memory returned by allocate().
+     *
+     * @param memory The memory, or NULL.
+     */
+    static void deallocate(void* memory);
+
+private:
+
+    struct Header
+    {
+        Arena* arena;
+        unsigned int sizeClass;
+    };
+
+    Arena(size_t blockSize);
+
+    Arena(const Arena& copy);
+
+    ~Arena();
+
+    void* allocateObject(unsigned int sizeClass);
+
+    void deallocateObject(Header* header);
+
+    mutable std::mutex _mutex;
+    size_t _blockSize;
+    std::vector<char*> _blocks;
+    char* _cursor;
+    char* _end;
+    std::vector<Header*> _freeLists;
+    size_t _liveBytes;
+    unsigned int _liveObjects;
+    bool _retired;
+};
+
+/**
+ * A base class for classes whose objects are allocated from the current Arena.
+ *
+ * @script{ignore}
+ */
+class ArenaObject
+{
+public:
+
+#ifdef GP_USE_MEM_LEAK_DETECTION
+#undef new
+#endif
+    static void* operator new(std::size_t size);
+    static void operator delete(void* memory);
+#ifdef GP_USE_MEM_LEAK_DETECTION
+    static void* operator new(std::size_t size, const char* file, int line);
+    static void operator delete(void* memory, const char* file, int line);
+#define new DEBUG_NEW
+#endif
+};
+
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "Base.h"
 #include "AudioBuffer.h"
 #include "FileSystem.h"
+#include "Properties.h"
 
 namespace gameplay
 {
@@ -8,6 +9,61 @@ namespace gameplay
 // Audio buffer cache
 static std::vector<AudioBuffer*> __buffers;
 
+/**
+ * The header of a sound bank.
+ *
+ * It is followed by the entry table, sorted by path, the null terminated paths and the PCM
+ * data of each entry aligned to SOUND_BANK_ALIGNMENT bytes from the start of the bank.
+ *
+ * @script{ignore}
+ */
+struct sound_bank_header
+{
+    char identifier[8];
+    unsigned int version;
+    unsigned int entryCount;
+};
+
+/** @script{ignore} */
+struct sound_bank_entry
+{
+    unsigned int pathOffset;
+    unsigned int offset;
+    unsigned int size;
+    unsigned int format;
+    unsigned int frequency;
+};
+
+static const char SOUND_BANK_IDENTIFIER[8] = { 'G', 'P', 'S', 'B', 'A', 'N', 'K', '\0' };
+static const unsigned int SOUND_BANK_VERSION = 1;
+// Each sound starts on its own page so only the pages of the sounds being loaded are read in
+static const unsigned int SOUND_BANK_ALIGNMENT = 4096;
+
+static Stream* __soundBank = NULL;
+static const sound_bank_entry* __soundBankEntries = NULL;
+static unsigned int __soundBankEntryCount = 0;
+
+/**
+ * Finds the entry for the given path in the mounted sound bank.
+ *
+ * @return The entry or NULL if no sound bank is mounted or it doesn't contain the path.
+ */
+static const sound_bank_entry* findSoundBankEntry(const char* path)
+{
+    if (!__soundBank)
+        return NULL;
+
+    const char* data = (const char*)__soundBank->getData();
+    const sound_bank_entry* last = __soundBankEntries + __soundBankEntryCount;
+    const sound_bank_entry* entry = std::lower_bound(__soundBankEntries, last, path, [data](const sound_bank_entry& e, const char* p)
+    {
+        return strcmp(data + e.pathOffset, p) < 0;
+    });
+    if (entry != last && strcmp(data + entry->pathOffset, path) == 0)
+        return entry;
+    return NULL;
+}
+
 // Callbacks for loading an ogg file using Stream
 static size_t readStream(void* ptr, size_t size, size_t nmemb, void* datasource)
 {
@@ -39,7 +95,7 @@ static long tellStream(void* datasource)
 }
 
 AudioBuffer::AudioBuffer(const char* path, ALuint* buffer, bool streamed)
-: _filePath(path), _streamed(streamed), _buffersNeededCount(0)
+: _filePath(path), _streamed(streamed), _buffersNeededCount(0), _decodeAheadStart(0), _decodeAheadSize(0)
 {
     memcpy(_alBufferQueue, buffer, sizeof(_alBufferQueue));
 }
@@ -98,6 +154,25 @@ AudioBuffer* AudioBuffer::create(const char* path, bool streamed)
     ALuint alBuffer[STREAMING_BUFFER_QUEUE_SIZE];
     memset(alBuffer, 0, sizeof(alBuffer));
 
+    // Sounds in the sound bank are uploaded straight from its mapping without being decoded
+    const sound_bank_entry* bankEntry = streamed ? NULL : findSoundBankEntry(FileSystem::resolvePath(path));
+    if (bankEntry)
+    {
+        AL_CHECK(alGenBuffers(1, &alBuffer[0]));
+        if (AL_LAST_ERROR())
+        {
+            GP_ERROR("Failed to create OpenAL buffer; alGenBuffers error: %d", AL_LAST_ERROR());
+            return NULL;
+        }
+
+        const char* data = (const char*)__soundBank->getData() + bankEntry->offset;
+        AL_CHECK(alBufferData(alBuffer[0], bankEntry->format, data, bankEntry->size, bankEntry->frequency));
+
+        buffer = new AudioBuffer(path, alBuffer, false);
+        __buffers.push_back(buffer);
+        return buffer;
+    }
+
     // Create 1 buffer for non-streamed sounds or full queue for streamed ones.
     unsigned int queueSize = streamed ? STREAMING_BUFFER_QUEUE_SIZE : 1;
     for (unsigned int i = 0; i < queueSize; i++)
@@ -170,6 +245,8 @@ AudioBuffer* AudioBuffer::create(const char* path, bool streamed)
 
     if (!streamed)
         __buffers.push_back(buffer);
+    else
+        buffer->_decodeAhead.resize(STREAMING_DECODE_AHEAD_SIZE);
 
     return buffer;
     
@@ -182,7 +259,7 @@ cleanup:
     return NULL;
 }
 
-bool AudioBuffer::loadWav(Stream* stream, ALuint buffer, bool streamed, AudioStreamStateWav* streamState)
+bool AudioBuffer::loadWav(Stream* stream, ALuint buffer, bool streamed, AudioStreamStateWav* streamState, std::vector<char>* decoded)
 {
     GP_ASSERT(stream);
 
@@ -313,13 +390,13 @@ bool AudioBuffer::loadWav(Stream* stream, ALuint buffer, bool streamed, AudioStr
                 return false;
             }
 
+            streamState->format = format;
+            streamState->frequency = frequency;
             if (streamed)
             {
                 // Save streaming state for later use.
                 streamState->dataStart = stream->position();
                 streamState->dataSize = dataSize;
-                streamState->format = format;
-                streamState->frequency = frequency;
             
                 // Limit data size to STREAMING_BUFFER_SIZE.
                 if (dataSize > STREAMING_BUFFER_SIZE)
@@ -334,7 +411,10 @@ bool AudioBuffer::loadWav(Stream* stream, ALuint buffer, bool streamed, AudioStr
                 return false;
             }
 
-            AL_CHECK( alBufferData(buffer, format, data, dataSize, frequency) );
+            if (decoded)
+                decoded->assign(data, data + dataSize);
+            else
+                AL_CHECK( alBufferData(buffer, format, data, dataSize, frequency) );
             SAFE_DELETE_ARRAY(data);
 
             // We've read the data, so return now.
@@ -381,7 +461,7 @@ bool AudioBuffer::loadWav(Stream* stream, ALuint buffer, bool streamed, AudioStr
     return false;
 }
 
-bool AudioBuffer::loadOgg(Stream* stream, ALuint buffer, bool streamed, AudioStreamStateOgg* streamState)
+bool AudioBuffer::loadOgg(Stream* stream, ALuint buffer, bool streamed, AudioStreamStateOgg* streamState, std::vector<char>* decoded)
 {
     GP_ASSERT(stream);
 
@@ -415,13 +495,13 @@ bool AudioBuffer::loadOgg(Stream* stream, ALuint buffer, bool streamed, AudioStr
     // size = #samples * #channels * 2 (for 16 bit).
     long data_size = ov_pcm_total(&streamState->oggFile, -1) * info->channels * 2;
 
+    streamState->format = format;
+    streamState->frequency = info->rate;
     if (streamed)
     {
         // Save streaming state for later use.
         streamState->dataStart = ov_pcm_tell(&streamState->oggFile);
         streamState->dataSize = data_size;
-        streamState->format = format;
-        streamState->frequency = info->rate;
         
         // Limit data size to STREAMING_BUFFER_SIZE.
         if (data_size > STREAMING_BUFFER_SIZE)
@@ -456,7 +536,10 @@ bool AudioBuffer::loadOgg(Stream* stream, ALuint buffer, bool streamed, AudioStr
         return false;
     }
 
-    AL_CHECK(alBufferData(buffer, format, data, size, info->rate));
+    if (decoded)
+        decoded->assign(data, data + size);
+    else
+        AL_CHECK(alBufferData(buffer, format, data, size, info->rate));
 
     SAFE_DELETE_ARRAY(data);
 
@@ -469,48 +552,318 @@ bool AudioBuffer::loadOgg(Stream* stream, ALuint buffer, bool streamed, AudioStr
 bool AudioBuffer::streamData(ALuint buffer, bool looped)
 {
     static char buffers[STREAMING_BUFFER_SIZE];
-    
-    if (_streamStateWav.get())
+
+    // Only decode here when decoding ahead fell behind
+    if (_decodeAheadSize < STREAMING_BUFFER_SIZE)
+        decodeAhead(looped);
+
+    unsigned int capacity = (unsigned int)_decodeAhead.size();
+    unsigned int bytesRead = std::min<unsigned int>(_decodeAheadSize, STREAMING_BUFFER_SIZE);
+    unsigned int tailSize = std::min(bytesRead, capacity - _decodeAheadStart);
+    memcpy(buffers, &_decodeAhead[_decodeAheadStart], tailSize);
+    memcpy(buffers + tailSize, &_decodeAhead[0], bytesRead - tailSize);
+    _decodeAheadStart = (_decodeAheadStart + bytesRead) % capacity;
+    _decodeAheadSize -= bytesRead;
+
+    if (bytesRead > 0)
+    {
+        if (_streamStateWav.get())
+            AL_CHECK(alBufferData(buffer, _streamStateWav->format, buffers, bytesRead, _streamStateWav->frequency));
+        else if (_streamStateOgg.get())
+            AL_CHECK(alBufferData(buffer, _streamStateOgg->format, buffers, bytesRead, _streamStateOgg->frequency));
+    }
+
+    return bytesRead > 0 || looped;
+}
+
+bool AudioBuffer::decodeAhead(bool looped)
+{
+    unsigned int capacity = (unsigned int)_decodeAhead.size();
+    unsigned int decoded = 0;
+    while (_decodeAheadSize < capacity)
     {
-        ALsizei bytesRead = _fileStream->read(buffers, sizeof(char), STREAMING_BUFFER_SIZE);
-        if (bytesRead != STREAMING_BUFFER_SIZE)
+        // Decode into the free space up to the end of the ring before wrapping around to its start
+        unsigned int end = (_decodeAheadStart + _decodeAheadSize) % capacity;
+        unsigned int size = std::min(capacity - _decodeAheadSize, capacity - end);
+        unsigned int bytesRead = decode(&_decodeAhead[end], size, looped);
+        _decodeAheadSize += bytesRead;
+        decoded += bytesRead;
+        if (bytesRead < size)
+            break;
+    }
+    return decoded > 0;
+}
+
+unsigned int AudioBuffer::decode(char* data, unsigned int size, bool looped)
+{
+    unsigned int bytesRead = 0;
+    bool rewound = false;
+
+    while (bytesRead < size)
+    {
+        unsigned int result = 0;
+        if (_streamStateWav.get())
+        {
+            // Stop at the end of the data chunk instead of reading any chunks that follow it
+            long remaining = _streamStateWav->dataStart + (long)_streamStateWav->dataSize - (long)_fileStream->position();
+            if (remaining > 0)
+                result = (unsigned int)_fileStream->read(data + bytesRead, sizeof(char), std::min<long>(size - bytesRead, remaining));
+        }
+        else if (_streamStateOgg.get())
+        {
+            int section;
+            long oggResult = ov_read(&_streamStateOgg->oggFile, data + bytesRead, size - bytesRead, 0, 2, 1, &section);
+            if (oggResult > 0)
+                result = (unsigned int)oggResult;
+        }
+        else
+        {
+            break;
+        }
+
+        if (result > 0)
+        {
+            bytesRead += result;
+            rewound = false;
+        }
+        else if (looped && !rewound)
         {
-            if (looped)
+            if (_streamStateWav.get())
                 _fileStream->seek(_streamStateWav->dataStart, SEEK_SET);
+            else
+                ov_pcm_seek(&_streamStateOgg->oggFile, _streamStateOgg->dataStart);
+            rewound = true;
         }
-        if (bytesRead > 0)
-            AL_CHECK(alBufferData(buffer, _streamStateWav->format, buffers, bytesRead, _streamStateWav->frequency));
-        
-        return bytesRead > 0 || looped;
+        else
+        {
+            break;
+        }
+    }
+
+    return bytesRead;
+}
+
+float AudioBuffer::getDuration() const
+{
+    if (_streamed)
+    {
+        unsigned int dataSize = _streamStateWav.get() ? _streamStateWav->dataSize : (_streamStateOgg.get() ? _streamStateOgg->dataSize : 0);
+        return getStreamingBufferTime() * dataSize / STREAMING_BUFFER_SIZE;
+    }
+
+    ALint size = 0;
+    ALint frequency = 0;
+    ALint channels = 0;
+    ALint bits = 0;
+    AL_CHECK( alGetBufferi(_alBufferQueue[0], AL_SIZE, &size) );
+    AL_CHECK( alGetBufferi(_alBufferQueue[0], AL_FREQUENCY, &frequency) );
+    AL_CHECK( alGetBufferi(_alBufferQueue[0], AL_CHANNELS, &channels) );
+    AL_CHECK( alGetBufferi(_alBufferQueue[0], AL_BITS, &bits) );
+
+    int bytesPerSecond = frequency * channels * bits / 8;
+    return bytesPerSecond > 0 ? size * 1000.0f / bytesPerSecond : 0.0f;
+}
+
+float AudioBuffer::getStreamingBufferTime() const
+{
+    ALuint format = 0;
+    ALuint frequency = 0;
+    if (_streamStateWav.get())
+    {
+        format = _streamStateWav->format;
+        frequency = _streamStateWav->frequency;
     }
     else if (_streamStateOgg.get())
     {
-        int section;
-        int result = 0;
-        ALsizei bytesRead = 0;
+        format = _streamStateOgg->format;
+        frequency = _streamStateOgg->frequency;
+    }
+
+    unsigned int bytesPerSample = 4;
+    if (format == AL_FORMAT_MONO8)
+        bytesPerSample = 1;
+    else if (format == AL_FORMAT_STEREO8 || format == AL_FORMAT_MONO16)
+        bytesPerSample = 2;
+
+    return frequency > 0 ? STREAMING_BUFFER_SIZE * 1000.0f / (frequency * bytesPerSample) : 0.0f;
+}
+
+bool AudioBuffer::decode(const char* path, std::vector<char>* data, ALuint* format, ALuint* frequency)
+{
+    GP_ASSERT(path && data && format && frequency);
+
+    std::unique_ptr<Stream> stream(FileSystem::open(path));
+    char header[12];
+    if (stream.get() == NULL || !stream->canRead() || stream->read(header, 1, 12) != 12)
+    {
+        GP_ERROR("Failed to load audio file %s.", path);
+        return false;
+    }
+
+    if (memcmp(header, "RIFF", 4) == 0)
+    {
+        AudioStreamStateWav streamState;
+        if (!loadWav(stream.get(), 0, false, &streamState, data))
+            return false;
+        *format = streamState.format;
+        *frequency = streamState.frequency;
+        return true;
+    }
+    else if (memcmp(header, "OggS", 4) == 0)
+    {
+        AudioStreamStateOgg streamState;
+        if (!loadOgg(stream.get(), 0, false, &streamState, data))
+            return false;
+        *format = streamState.format;
+        *frequency = streamState.frequency;
+        return true;
+    }
+
+    GP_ERROR("Unsupported audio file: %s", path);
+    return false;
+}
 
-        while (bytesRead < STREAMING_BUFFER_SIZE)
+bool AudioBuffer::createSoundBank(const char* bankPath, Properties* directories)
+{
+    GP_ASSERT(bankPath);
+    GP_ASSERT(directories);
+
+    struct BankSound
+    {
+        std::string path;
+        std::vector<char> data;
+        ALuint format;
+        ALuint frequency;
+    };
+    std::vector<BankSound> sounds;
+
+    directories->rewind();
+    while (const char* dirPath = directories->getNextProperty())
+    {
+        std::vector<std::string> fileNames;
+        if (!FileSystem::listFiles(dirPath, fileNames))
         {
-            result = ov_read(&_streamStateOgg->oggFile, buffers + bytesRead, STREAMING_BUFFER_SIZE - bytesRead, 0, 2, 1, &section);
-            if (result > 0)
-            {
-                bytesRead += result;
-            }
-            else
-            {
-                if (looped)
-                    ov_pcm_seek(&_streamStateOgg->oggFile, _streamStateOgg->dataStart);
-                break;
-            }
+            GP_WARN("Skipping missing directory '%s' while creating sound bank '%s'.", dirPath, bankPath);
+            continue;
         }
 
-        if (bytesRead > 0)
-            AL_CHECK(alBufferData(buffer, _streamStateOgg->format, buffers, bytesRead, _streamStateOgg->frequency));
-        
-        return (bytesRead > 0) || looped;
+        for (const std::string& fileName : fileNames)
+        {
+            std::string extension = FileSystem::getExtension(fileName.c_str());
+            if (extension != ".OGG" && extension != ".WAV")
+                continue;
+
+            BankSound sound;
+            sound.path = std::string(dirPath) + "/" + fileName;
+            if (!decode(sound.path.c_str(), &sound.data, &sound.format, &sound.frequency))
+                return false;
+            sounds.push_back(sound);
+        }
     }
-    
-    return false;
+    directories->rewind();
+
+    std::sort(sounds.begin(), sounds.end(), [](const BankSound& a, const BankSound& b)
+    {
+        return strcmp(a.path.c_str(), b.path.c_str()) < 0;
+    });
+
+    sound_bank_header header;
+    memcpy(header.identifier, SOUND_BANK_IDENTIFIER, sizeof(SOUND_BANK_IDENTIFIER));
+    header.version = SOUND_BANK_VERSION;
+    header.entryCount = (unsigned int)sounds.size();
+
+    std::vector<sound_bank_entry> entries(sounds.size());
+    size_t offset = sizeof(sound_bank_header) + sizeof(sound_bank_entry) * entries.size();
+    for (size_t i = 0; i < sounds.size(); ++i)
+    {
+        entries[i].pathOffset = (unsigned int)offset;
+        offset += sounds[i].path.size() + 1;
+    }
+    for (size_t i = 0; i < sounds.size(); ++i)
+    {
+        offset = (offset + SOUND_BANK_ALIGNMENT - 1) & ~(size_t)(SOUND_BANK_ALIGNMENT - 1);
+        entries[i].offset = (unsigned int)offset;
+        entries[i].size = (unsigned int)sounds[i].data.size();
+        entries[i].format = sounds[i].format;
+        entries[i].frequency = sounds[i].frequency;
+        offset += entries[i].size;
+    }
+
+    std::unique_ptr<Stream> stream(FileSystem::open(bankPath, FileSystem::WRITE));
+    if (!stream)
+    {
+        GP_ERROR("Failed to open '%s' for writing.", bankPath);
+        return false;
+    }
+
+    bool written = stream->write(&header, sizeof(header), 1) == 1 &&
+        (entries.empty() || stream->write(entries.data(), sizeof(sound_bank_entry), entries.size()) == entries.size());
+    size_t position = sizeof(sound_bank_header) + sizeof(sound_bank_entry) * entries.size();
+    for (size_t i = 0; written && i < sounds.size(); ++i)
+    {
+        written = stream->write(sounds[i].path.c_str(), 1, sounds[i].path.size() + 1) == sounds[i].path.size() + 1;
+        position += sounds[i].path.size() + 1;
+    }
+    std::vector<char> padding(SOUND_BANK_ALIGNMENT, 0);
+    for (size_t i = 0; written && i < sounds.size(); ++i)
+    {
+        size_t paddingSize = entries[i].offset - position;
+        written = (paddingSize == 0 || stream->write(padding.data(), 1, paddingSize) == paddingSize) &&
+            (entries[i].size == 0 || stream->write(sounds[i].data.data(), 1, entries[i].size) == entries[i].size);
+        position = entries[i].offset + entries[i].size;
+    }
+
+    if (!written)
+        GP_ERROR("Failed to write sound bank '%s'.", bankPath);
+    return written;
+}
+
+bool AudioBuffer::mountSoundBank(const char* bankPath)
+{
+    GP_ASSERT(bankPath);
+
+    unmountSoundBank();
+
+    Stream* stream = FileSystem::open(bankPath, FileSystem::READ | FileSystem::MAPPED);
+    if (!stream)
+        return false;
+
+    const char* data = (const char*)stream->getData();
+    size_t length = stream->length();
+    const sound_bank_header* header = (const sound_bank_header*)data;
+    if (!data || length < sizeof(sound_bank_header) || memcmp(header->identifier, SOUND_BANK_IDENTIFIER, sizeof(SOUND_BANK_IDENTIFIER)) != 0 ||
+        header->version != SOUND_BANK_VERSION || (length - sizeof(sound_bank_header)) / sizeof(sound_bank_entry) < header->entryCount)
+    {
+        GP_WARN("Sound bank '%s' could not be mapped or is not a version %u sound bank.", bankPath, SOUND_BANK_VERSION);
+        SAFE_DELETE(stream);
+        return false;
+    }
+
+    const sound_bank_entry* entries = (const sound_bank_entry*)(data + sizeof(sound_bank_header));
+    for (unsigned int i = 0; i < header->entryCount; ++i)
+    {
+        const sound_bank_entry& entry = entries[i];
+        if (entry.pathOffset >= length || memchr(data + entry.pathOffset, '\0', length - entry.pathOffset) == NULL ||
+            entry.offset > length || entry.size > length - entry.offset)
+        {
+            GP_WARN("Sound bank '%s' is truncated or corrupt.", bankPath);
+            SAFE_DELETE(stream);
+            return false;
+        }
+    }
+
+    __soundBank = stream;
+    __soundBankEntries = entries;
+    __soundBankEntryCount = header->entryCount;
+    return true;
+}
+
+void AudioBuffer::unmountSoundBank()
+{
+    // Buffers created from the bank hold their own copy of the data once it is uploaded
+    SAFE_DELETE(__soundBank);
+    __soundBankEntries = NULL;
+    __soundBankEntryCount = 0;
 }
 
 }
@@ -8,6 +8,7 @@ namespace gameplay
 {
 
 class AudioSource;
+class Properties;
 
 /**
  * Defines the actual audio buffer data.
@@ -44,6 +45,26 @@ private:
      */
     static AudioBuffer* create(const char* path, bool streamed);
 
+    /**
+     * @see AudioSource::createSoundBank
+     */
+    static bool createSoundBank(const char* bankPath, Properties* directories);
+
+    /**
+     * @see AudioSource::mountSoundBank
+     */
+    static bool mountSoundBank(const char* bankPath);
+
+    /**
+     * @see AudioSource::unmountSoundBank
+     */
+    static void unmountSoundBank();
+
+    /**
+     * Decodes a whole .ogg or .wav file into PCM data.
+     */
+    static bool decode(const char* path, std::vector<char>* data, ALuint* format, ALuint* frequency);
+
     struct AudioStreamStateWav
     {
         long dataStart;
@@ -63,13 +84,47 @@ private:
 
     enum { STREAMING_BUFFER_QUEUE_SIZE = 3 };
     enum { STREAMING_BUFFER_SIZE = 48000 };
+    enum { STREAMING_DECODE_AHEAD_SIZE = 4 * STREAMING_BUFFER_SIZE };
 
-    static bool loadWav(Stream* stream, ALuint buffer, bool streamed, AudioStreamStateWav* streamState);
+    /**
+     * Loads a .wav file into the buffer, or into decoded instead when it isn't NULL.
+     */
+    static bool loadWav(Stream* stream, ALuint buffer, bool streamed, AudioStreamStateWav* streamState, std::vector<char>* decoded = NULL);
     
-    static bool loadOgg(Stream* stream, ALuint buffer, bool streamed, AudioStreamStateOgg* streamState);
+    /**
+     * Loads a .ogg file into the buffer, or into decoded instead when it isn't NULL.
+     */
+    static bool loadOgg(Stream* stream, ALuint buffer, bool streamed, AudioStreamStateOgg* streamState, std::vector<char>* decoded = NULL);
 
+    /**
+     * Fills a queue buffer with the next data of a streamed file.
+     */
     bool streamData(ALuint buffer, bool looped);
 
+    /**
+     * Decodes data of a streamed file until the decode ahead ring is full.
+     *
+     * @return true if any data was decoded.
+     */
+    bool decodeAhead(bool looped);
+
+    /**
+     * Reads PCM data from the streamed file, continuing from the start of the data when looped.
+     *
+     * @return The number of bytes read.
+     */
+    unsigned int decode(char* data, unsigned int size, bool looped);
+
+    /**
+     * Gets the time it takes to play the whole file, in milliseconds.
+     */
+    float getDuration() const;
+
+    /**
+     * Gets the time it takes to play a full queue buffer of the streamed file, in milliseconds.
+     */
+    float getStreamingBufferTime() const;
+
     ALuint _alBufferQueue[STREAMING_BUFFER_QUEUE_SIZE];
     std::string _filePath;
     bool _streamed;
@@ -77,6 +132,9 @@ private:
     std::unique_ptr<AudioStreamStateWav> _streamStateWav;
     std::unique_ptr<AudioStreamStateOgg> _streamStateOgg;
     int _buffersNeededCount;
+    std::vector<char> _decodeAhead;
+    unsigned int _decodeAheadStart;
+    unsigned int _decodeAheadSize;
 };
 
 }
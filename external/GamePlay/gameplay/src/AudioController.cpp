@@ -5,11 +5,15 @@
 #include "AudioSource.h"
 #include "ProfilerController.h"
 
+// The number of start/stop requests that can be waiting for the streaming thread
+#define STREAMING_COMMAND_QUEUE_SIZE 64
+
 namespace gameplay
 {
 
 AudioController::AudioController() 
-: _alcDevice(NULL), _alcContext(NULL), _pausingSource(NULL), _streamingThreadActive(true)
+: _alcDevice(NULL), _alcContext(NULL), _pausingSource(NULL), _streamingThreadActive(true),
+  _streamingCommandsPushed(0), _streamingCommandsProcessed(0), _streamingWakeRequested(false)
 {
 }
 
@@ -42,16 +46,18 @@ void AudioController::initialize()
         GP_ERROR("Unable to make OpenAL context current. Error: %d\n", alcErr);
     }
     _streamingMutex.reset(new std::mutex());
+    _streamingCommands.reset(new LockFreeQueue<StreamingCommand>(STREAMING_COMMAND_QUEUE_SIZE));
 }
 
 void AudioController::finalize()
 {
-    GP_ASSERT(_streamingSources.empty());
     if (_streamingThread.get())
     {
         _streamingThreadActive = false;
+        wakeStreamingThread();
         _streamingThread->join();
         _streamingThread.reset(NULL);
+        GP_ASSERT(_streamingSources.empty());
     }
 
     alcMakeContextCurrent(NULL);
@@ -105,6 +111,7 @@ void AudioController::resume()
         source->resume();
         itr++;
     }
+    wakeStreamingThread();
 }
 
 void AudioController::update(float elapsedTime)
@@ -128,16 +135,18 @@ void AudioController::addPlayingSource(AudioSource* source)
 
         if (source->isStreamed())
         {
-            GP_ASSERT(_streamingSources.find(source) == _streamingSources.end());
-            bool startThread = _streamingSources.empty() && _streamingThread.get() == NULL;
-            _streamingMutex->lock();
-            _streamingSources.insert(source);
-            _streamingMutex->unlock();
+            bool startThread = _streamingThread.get() == NULL;
+            pushStreamingCommand(source, true);
 
             if (startThread)
                 _streamingThread.reset(new std::thread(&streamingThreadProc, this));
         }
     }
+    else if (source->isStreamed())
+    {
+        // A source that was paused or ran out of data is playing again and needs its queue refilled
+        wakeStreamingThread();
+    }
 }
 
 void AudioController::removePlayingSource(AudioSource* source)
@@ -150,30 +159,93 @@ void AudioController::removePlayingSource(AudioSource* source)
             _playingSources.erase(iter);
  
             if (source->isStreamed())
-            {
-                GP_ASSERT(_streamingSources.find(source) != _streamingSources.end());
-                _streamingMutex->lock();
-                _streamingSources.erase(source);
-                _streamingMutex->unlock();
-            }
+                pushStreamingCommand(source, false);
         }
     } 
 }
 
+void AudioController::pushStreamingCommand(AudioSource* source, bool streamed)
+{
+    StreamingCommand command = { source, streamed };
+    while (!_streamingCommands->push(command))
+    {
+        wakeStreamingThread();
+        std::this_thread::yield();
+    }
+    ++_streamingCommandsPushed;
+    wakeStreamingThread();
+}
+
+void AudioController::wakeStreamingThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(*_streamingMutex);
+        _streamingWakeRequested = true;
+    }
+    _streamingWake.notify_one();
+}
+
+void AudioController::waitForStreamingThread()
+{
+    std::unique_lock<std::mutex> lock(*_streamingMutex);
+    unsigned int pushed = _streamingCommandsPushed;
+    _streamingCommandsHandled.wait(lock, [this, pushed] { return _streamingCommandsProcessed == pushed || !_streamingThread.get(); });
+}
+
+void AudioController::processStreamingCommands()
+{
+    // Take over the sources that started or stopped since the last wake up
+    StreamingCommand command;
+    unsigned int processed = 0;
+    while (_streamingCommands->pop(&command))
+    {
+        if (command.streamed)
+            _streamingSources.insert(command.source);
+        else
+            _streamingSources.erase(command.source);
+        ++processed;
+    }
+
+    if (processed > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(*_streamingMutex);
+            _streamingCommandsProcessed += processed;
+        }
+        _streamingCommandsHandled.notify_all();
+    }
+}
+
 void AudioController::streamingThreadProc(void* arg)
 {
     AudioController* controller = (AudioController*)arg;
 
     while (controller->_streamingThreadActive)
     {
-        controller->_streamingMutex->lock();
+        controller->processStreamingCommands();
 
+        // Refill the queues of every source before decoding ahead so a slow decode can't starve another source
         std::for_each(controller->_streamingSources.begin(), controller->_streamingSources.end(), std::mem_fn(&AudioSource::streamDataIfNeeded));
-        
-        controller->_streamingMutex->unlock();
-   
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::for_each(controller->_streamingSources.begin(), controller->_streamingSources.end(), std::mem_fn(&AudioSource::decodeAhead));
+
+        // Sleep until the first playing source could have finished another buffer, or indefinitely while nothing plays
+        float waitTime = -1.0f;
+        for (std::set<AudioSource*>::const_iterator itr = controller->_streamingSources.begin(); itr != controller->_streamingSources.end(); ++itr)
+        {
+            float bufferTime = (*itr)->getStreamingWaitTime();
+            if (bufferTime >= 0.0f && (waitTime < 0.0f || bufferTime < waitTime))
+                waitTime = bufferTime;
+        }
+
+        std::unique_lock<std::mutex> lock(*controller->_streamingMutex);
+        if (waitTime < 0.0f)
+            controller->_streamingWake.wait(lock, [controller] { return controller->_streamingWakeRequested; });
+        else
+            controller->_streamingWake.wait_for(lock, std::chrono::milliseconds((long long)waitTime), [controller] { return controller->_streamingWakeRequested; });
+        controller->_streamingWakeRequested = false;
     }
+
+    controller->processStreamingCommands();
 }
 
 }
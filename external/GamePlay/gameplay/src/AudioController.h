@@ -1,6 +1,8 @@
 #ifndef AUDIOCONTROLLER_H_
 #define AUDIOCONTROLLER_H_
 
+#include "LockFreeQueue.h"
+
 namespace gameplay
 {
 
@@ -54,21 +56,59 @@ private:
      */
     void update(float elapsedTime);
 
+    /**
+     * A request for the streaming thread to start or stop streaming a source.
+     */
+    struct StreamingCommand
+    {
+        AudioSource* source;
+        bool streamed;
+    };
+
     void addPlayingSource(AudioSource* source);
     
     void removePlayingSource(AudioSource* source);
 
+    /**
+     * Hands a start/stop request over to the streaming thread without blocking it.
+     */
+    void pushStreamingCommand(AudioSource* source, bool streamed);
+
+    /**
+     * Wakes the streaming thread so that it handles state changes before its next buffer is due.
+     */
+    void wakeStreamingThread();
+
+    /**
+     * Blocks until the streaming thread has handled every request pushed so far,
+     * after which it no longer references any source that was removed.
+     */
+    void waitForStreamingThread();
+
+    /**
+     * Applies the requests pushed to the streaming thread, called on the streaming thread.
+     */
+    void processStreamingCommands();
+
     static void streamingThreadProc(void* arg);
 
     ALCdevice* _alcDevice;
     ALCcontext* _alcContext;
     std::set<AudioSource*> _playingSources;
-    std::set<AudioSource*> _streamingSources;
     AudioSource* _pausingSource;
 
-    bool _streamingThreadActive;
+    // Only accessed by the streaming thread once it is running
+    std::set<AudioSource*> _streamingSources;
+
+    std::atomic<bool> _streamingThreadActive;
     std::unique_ptr<std::thread> _streamingThread;
     std::unique_ptr<std::mutex> _streamingMutex;
+    std::condition_variable _streamingWake;
+    std::condition_variable _streamingCommandsHandled;
+    std::unique_ptr<LockFreeQueue<StreamingCommand> > _streamingCommands;
+    unsigned int _streamingCommandsPushed;
+    unsigned int _streamingCommandsProcessed;
+    bool _streamingWakeRequested;
 };
 
 }
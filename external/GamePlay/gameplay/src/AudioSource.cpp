@@ -39,6 +39,10 @@ AudioSource::~AudioSource()
         GP_ASSERT(audioController);
         audioController->removePlayingSource(this);
 
+        // The streaming thread has to let go of the source before it can be deleted
+        if (isStreamed())
+            audioController->waitForStreamingThread();
+
         AL_CHECK(alDeleteSources(1, &_alSource));
         _alSource = 0;
     }
@@ -135,6 +139,21 @@ AudioSource* AudioSource::create(Properties* properties)
     return audio;
 }
 
+bool AudioSource::createSoundBank(const char* bankPath, Properties* directories)
+{
+    return AudioBuffer::createSoundBank(bankPath, directories);
+}
+
+bool AudioSource::mountSoundBank(const char* bankPath)
+{
+    return AudioBuffer::mountSoundBank(bankPath);
+}
+
+void AudioSource::unmountSoundBank()
+{
+    AudioBuffer::unmountSoundBank();
+}
+
 AudioSource::State AudioSource::getState() const
 {
     ALint state;
@@ -257,6 +276,33 @@ void AudioSource::setVelocity(float x, float y, float z)
     setVelocity(Vector3(x, y, z));
 }
 
+float AudioSource::getDuration() const
+{
+    GP_ASSERT(_buffer);
+    return _buffer->getDuration();
+}
+
+void AudioSource::setOffset(float offset)
+{
+    AL_CHECK( alSourcef(_alSource, AL_SEC_OFFSET, offset * 0.001f) );
+}
+
+void AudioSource::shareBuffer(AudioSource* source)
+{
+    GP_ASSERT(source && source->_buffer);
+    GP_ASSERT(!isStreamed() && !source->isStreamed());
+
+    if (_buffer != source->_buffer)
+    {
+        // A buffer can only be detached from a source that isn't playing
+        stop();
+        AL_CHECK( alSourcei(_alSource, AL_BUFFER, source->_buffer->_alBufferQueue[0]) );
+        source->_buffer->addRef();
+        SAFE_RELEASE(_buffer);
+        _buffer = source->_buffer;
+    }
+}
+
 Node* AudioSource::getNode() const
 {
     return _node;
@@ -361,4 +407,20 @@ bool AudioSource::streamDataIfNeeded()
     return true;
 }
 
+bool AudioSource::decodeAhead()
+{
+    GP_ASSERT( isStreamed() );
+    return _buffer->decodeAhead(_looped);
+}
+
+float AudioSource::getStreamingWaitTime() const
+{
+    GP_ASSERT( isStreamed() );
+    if (getState() != PLAYING)
+        return -1.0f;
+
+    // Waking twice per buffer keeps at least one full buffer queued ahead of the one being played
+    return _buffer->getStreamingBufferTime() * 0.5f;
+}
+
 }
@@ -58,6 +58,42 @@ public:
      */
     static AudioSource* create(Properties* properties);
 
+    /**
+     * Creates a sound bank holding the decoded PCM data of the .ogg and .wav files in the given directories.
+     *
+     * Each property name in <code>directories</code> is a directory relative to the resource path, sub directories
+     * are not included. The data of each sound is aligned to a page so it can be uploaded straight from a mapping
+     * of the bank. Only short sounds should be added, streamed sources always decode their files.
+     *
+     * @param bankPath The path of the sound bank to write, relative to the currently set resource path.
+     * @param directories The directories to add to the sound bank.
+     *
+     * @return True if the sound bank was written successfully.
+     */
+    static bool createSoundBank(const char* bankPath, Properties* directories);
+
+    /**
+     * Mounts a sound bank so that sources which aren't streamed load the sounds it contains from it
+     * instead of decoding their files.
+     *
+     * The bank is mapped into memory for as long as it is mounted. Any sound bank that is already mounted is unmounted first.
+     *
+     * @param bankPath The path to the sound bank, relative to the currently set resource path.
+     *
+     * @return True if the sound bank was mounted, false if it could not be opened or is invalid.
+     *
+     * @see createSoundBank(const char*, Properties*)
+     * @script{ignore}
+     */
+    static bool mountSoundBank(const char* bankPath);
+
+    /**
+     * Unmounts the currently mounted sound bank, if any.
+     *
+     * @script{ignore}
+     */
+    static void unmountSoundBank();
+
     /**
      * Plays the audio source.
      */
@@ -162,6 +198,30 @@ public:
      */
     void setVelocity(float x, float y, float z);
 
+    /**
+     * Gets the length of the audio played by this source.
+     *
+     * @return The duration in milliseconds.
+     */
+    float getDuration() const;
+
+    /**
+     * Moves the playback position of the audio source.
+     *
+     * @param offset The offset from the start of the audio in milliseconds.
+     */
+    void setOffset(float offset);
+
+    /**
+     * Makes this audio source play the audio of another source, both then share the same audio buffer.
+     *
+     * This allows a fixed number of audio sources to play any loaded sound. Neither source may be streamed,
+     * this source is stopped if it was playing.
+     *
+     * @param source The audio source to share the audio buffer of.
+     */
+    void shareBuffer(AudioSource* source);
+
     /**
      * Gets the node that this source is attached to.
      * 
@@ -206,6 +266,18 @@ private:
 
     bool streamDataIfNeeded();
 
+    /**
+     * Decodes data of a streamed source ahead of the buffers that are queued to play.
+     */
+    bool decodeAhead();
+
+    /**
+     * Gets how long the streaming thread can wait before this source needs another buffer queued.
+     *
+     * @return The time in milliseconds, or -1 if the source isn't playing.
+     */
+    float getStreamingWaitTime() const;
+
     ALuint _alSource;
     AudioBuffer* _buffer;
     bool _looped;
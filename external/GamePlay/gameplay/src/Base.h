@@ -31,6 +31,8 @@
 #include <typeinfo>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include <chrono>
 #include "Logger.h"
 
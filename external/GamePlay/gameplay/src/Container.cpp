@@ -664,7 +664,7 @@ unsigned int Container::draw(Form* form, const Rectangle& clip)
     for (size_t i = 0, count = _controls.size(); i < count; ++i)
     {
         Control* control = _controls[i];
-        if (control && control->_absoluteClipBounds.intersects(_absoluteClipBounds))
+        if (control && control->_absoluteClipBounds.intersects(_absoluteClipBounds) && control->_absoluteClipBounds.intersects(form->_redrawRegion))
         {
             drawCalls += control->draw(form, _viewportClipBounds);
         }
@@ -1568,6 +1568,7 @@ void Container::setAnimationPropertyValue(int propertyId, AnimationValue* value,
     {
     case ANIMATE_SCROLLBAR_OPACITY:
         _scrollBarOpacity = Curve::lerp(blendWeight, _opacity, value->getFloat(0));
+        markForRedraw();
         break;
     default:
         Control::setAnimationPropertyValue(propertyId, value, blendWeight);
@@ -1090,6 +1090,7 @@ void Control::controlEvent(Control::Listener::EventType evt)
 void Control::setDirty(int bits)
 {
     _dirtyBits |= bits;
+    markForRedraw();
 }
 
 bool Control::isDirty(int bit) const
@@ -1097,6 +1098,13 @@ bool Control::isDirty(int bit) const
     return (_dirtyBits & bit) == bit;
 }
 
+void Control::markForRedraw()
+{
+    Form* form = getTopLevelForm();
+    if (form)
+        form->addRedrawRegion(_absoluteClipBounds);
+}
+
 void Control::update(float elapsedTime)
 {
     State state = getState();
@@ -1107,9 +1115,12 @@ void Control::update(float elapsedTime)
 
     // Since opacity is pre-multiplied, we compute it every frame so that we don't need to
     // dirty the entire hierarchy any time a state changes (which could affect opacity).
+    float opacity = _opacity;
     _opacity = getOpacity(state);
     if (_parent)
         _opacity *= _parent->_opacity;
+    if (_opacity != opacity)
+        markForRedraw();
 }
 
 void Control::updateState(State state)
@@ -1160,6 +1171,12 @@ bool Control::updateBoundsInternal(const Vector2& offset)
             if (isContainer())
                 static_cast<Container*>(this)->setChildrenDirty(DIRTY_BOUNDS, true);
             changed = true;
+
+            // Both the area that was covered and the one that is covered now have to be redrawn
+            Form* form = getTopLevelForm();
+            if (form)
+                form->addRedrawRegion(oldAbsoluteClipBounds);
+            markForRedraw();
         }
     }
 
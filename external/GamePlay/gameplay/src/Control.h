@@ -1329,6 +1329,14 @@ protected:
      */
     bool isDirty(int bit) const;
 
+    /**
+     * Marks the area covered by this control as needing to be redrawn by its form.
+     *
+     * Changing the state or bounds through setDirty already does this, controls that draw something
+     * that changed without dirtying themselves (such as a new value or caret position) call this directly.
+     */
+    void markForRedraw();
+
     /**
      * Gets the Alignment by string.
      *
@@ -33,6 +33,10 @@ struct MemoryAllocationRecord
 MemoryAllocationRecord* __memoryAllocations = 0;
 int __memoryAllocationCount = 0;
 
+// Allocations made by each thread since it started, sampled by the profiler to count the allocations of frames and events
+static thread_local unsigned int __threadAllocationCount = 0;
+static thread_local unsigned long long __threadAllocationBytes = 0;
+
 static std::mutex& getMemoryAllocationMutex()
 {
     static std::mutex m;
@@ -105,6 +109,9 @@ void operator delete[] (void* p, const char* file, int line) throw()
 
 void* debugAlloc(std::size_t size, const char* file, int line)
 {
+    ++__threadAllocationCount;
+    __threadAllocationBytes += size;
+
     // Allocate memory + size for a MemoryAlloctionRecord
     unsigned char* mem = (unsigned char*)malloc(size + sizeof(MemoryAllocationRecord));
 
@@ -309,6 +316,12 @@ extern void printMemoryLeaks()
     }
 }
 
+void getThreadMemoryAllocations(unsigned int* count, unsigned long long* bytes)
+{
+    *count = __threadAllocationCount;
+    *bytes = __threadAllocationBytes;
+}
+
 #if defined(WIN32)
 void setTrackStackTrace(bool trackStackTrace)
 {
@@ -321,4 +334,12 @@ void toggleTrackStackTrace()
 }
 #endif
 
+#else
+
+void getThreadMemoryAllocations(unsigned int* count, unsigned long long* bytes)
+{
+    *count = 0;
+    *bytes = 0;
+}
+
 #endif
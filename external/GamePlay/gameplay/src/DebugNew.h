@@ -194,6 +194,17 @@ T* bullet_new(const T1& t1, const T2& t2, const T3& t3, const T4& t4, const T5&
 #endif
 }
 
+/**
+ * Gets the number of heap allocations made by the calling thread and their total size in bytes.
+ *
+ * Both only ever increase so the allocations made by a section of code are the difference
+ * between two calls. They are always zero unless GP_USE_MEM_LEAK_DETECTION is defined.
+ *
+ * @param count Set to the number of allocations.
+ * @param bytes Set to the number of bytes allocated.
+ */
+void getThreadMemoryAllocations(unsigned int* count, unsigned long long* bytes);
+
 #if defined(WIN32)
 
 /**
@@ -1,10 +1,16 @@
 #include "Base.h"
 #include "Effect.h"
 #include "FileSystem.h"
+#include "GLStateCache.h"
 #include "Game.h"
 
 #define OPENGL_ES_DEFINE  "OPENGL_ES"
 
+// Linked programs are only cached where GLEW can tell us whether the driver supports program binaries
+#ifdef GLEW_STATIC
+#define GP_USE_PROGRAM_BINARY_CACHE
+#endif
+
 namespace gameplay
 {
 
@@ -12,6 +18,44 @@ namespace gameplay
 static std::map<std::string, Effect*> __effectCache;
 static Effect* __currentEffect = NULL;
 
+/**
+ * The header of the program cache file, followed by entryCount programs each made up of
+ * a program_cache_entry and the binary itself.
+ *
+ * @script{ignore}
+ */
+struct program_cache_header
+{
+    char identifier[8];
+    unsigned int version;
+    unsigned int entryCount;
+    unsigned long long driverHash;
+};
+
+/** @script{ignore} */
+struct program_cache_entry
+{
+    unsigned long long key;
+    unsigned int format;
+    unsigned int length;
+};
+
+/** @script{ignore} */
+struct ProgramBinary
+{
+    GLenum format;
+    std::vector<char> data;
+};
+
+static const char PROGRAM_CACHE_IDENTIFIER[8] = { 'G', 'P', 'P', 'R', 'O', 'G', '\0', '\0' };
+static const unsigned int PROGRAM_CACHE_VERSION = 1;
+
+static std::map<unsigned long long, ProgramBinary> __programBinaries;
+static std::string __programCachePath;
+static unsigned long long __programCacheDriverHash = 0;
+static bool __programCacheEnabled = false;
+static bool __programCacheDirty = false;
+
 Effect::Effect() : _program(0)
 {
 }
@@ -32,15 +76,170 @@ Effect::~Effect()
         // If our program object is currently bound, unbind it before we're destroyed.
         if (__currentEffect == this)
         {
-            GL_ASSERT( glUseProgram(0) );
+            GLStateCache::useProgram(0);
             __currentEffect = NULL;
         }
 
-        GL_ASSERT( glDeleteProgram(_program) );
+        GLStateCache::deleteProgram(_program);
         _program = 0;
     }
 }
 
+/**
+ * Combines a string into a 64-bit FNV-1a hash.
+ */
+static unsigned long long hashString(const char* str, unsigned long long hash = 14695981039346656037ULL)
+{
+    for (; str && *str; ++str)
+    {
+        hash ^= (unsigned char)*str;
+        hash *= 1099511628211ULL;
+    }
+    // Separate consecutive strings so that "ab" + "c" and "a" + "bc" differ
+    hash ^= 0xFF;
+    hash *= 1099511628211ULL;
+    return hash;
+}
+
+static unsigned long long getProgramKey(const char* defines, const char* vshSource, const char* fshSource)
+{
+    return hashString(fshSource, hashString(vshSource, hashString(defines)));
+}
+
+void Effect::setProgramCachePath(const char* path)
+{
+    __programBinaries.clear();
+    __programCachePath = path ? path : "";
+    __programCacheEnabled = false;
+    __programCacheDirty = false;
+
+#ifdef GP_USE_PROGRAM_BINARY_CACHE
+    GLint formatCount = 0;
+    if (__programCachePath.empty() || !GLEW_ARB_get_program_binary)
+        return;
+    GL_ASSERT( glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount) );
+    if (formatCount <= 0)
+        return;
+    __programCacheEnabled = true;
+
+    // Binaries are only valid for the driver that linked them
+    __programCacheDriverHash = hashString((const char*)glGetString(GL_VERSION),
+        hashString((const char*)glGetString(GL_RENDERER), hashString((const char*)glGetString(GL_VENDOR))));
+
+    if (!FileSystem::fileExists(__programCachePath.c_str()))
+        return;
+
+    std::unique_ptr<Stream> stream(FileSystem::open(__programCachePath.c_str(), FileSystem::READ | FileSystem::MAPPED));
+    program_cache_header header;
+    if (!stream.get() || stream->read(&header, sizeof(header), 1) != 1 ||
+        memcmp(header.identifier, PROGRAM_CACHE_IDENTIFIER, sizeof(PROGRAM_CACHE_IDENTIFIER)) != 0 ||
+        header.version != PROGRAM_CACHE_VERSION || header.driverHash != __programCacheDriverHash)
+    {
+        // Rewrite the cache for this driver
+        __programCacheDirty = true;
+        return;
+    }
+
+    for (unsigned int i = 0; i < header.entryCount; ++i)
+    {
+        program_cache_entry entry;
+        if (stream->read(&entry, sizeof(entry), 1) != 1 || entry.length > stream->length() - stream->position())
+        {
+            GP_WARN("Program cache '%s' is truncated.", __programCachePath.c_str());
+            __programCacheDirty = true;
+            break;
+        }
+        ProgramBinary& binary = __programBinaries[entry.key];
+        binary.format = entry.format;
+        binary.data.resize(entry.length);
+        if (entry.length > 0)
+            stream->read(binary.data.data(), 1, entry.length);
+    }
+#endif
+}
+
+void Effect::saveProgramCache()
+{
+    if (!__programCacheEnabled || !__programCacheDirty)
+        return;
+
+    std::unique_ptr<Stream> stream(FileSystem::open(__programCachePath.c_str(), FileSystem::WRITE));
+    if (!stream.get())
+    {
+        GP_WARN("Failed to open program cache '%s' for writing.", __programCachePath.c_str());
+        return;
+    }
+
+    program_cache_header header;
+    memcpy(header.identifier, PROGRAM_CACHE_IDENTIFIER, sizeof(PROGRAM_CACHE_IDENTIFIER));
+    header.version = PROGRAM_CACHE_VERSION;
+    header.entryCount = (unsigned int)__programBinaries.size();
+    header.driverHash = __programCacheDriverHash;
+    stream->write(&header, sizeof(header), 1);
+
+    for (std::map<unsigned long long, ProgramBinary>::const_iterator itr = __programBinaries.begin(); itr != __programBinaries.end(); ++itr)
+    {
+        program_cache_entry entry;
+        entry.key = itr->first;
+        entry.format = itr->second.format;
+        entry.length = (unsigned int)itr->second.data.size();
+        stream->write(&entry, sizeof(entry), 1);
+        if (entry.length > 0)
+            stream->write(itr->second.data.data(), 1, entry.length);
+    }
+    __programCacheDirty = false;
+}
+
+/**
+ * Creates a program from a cached binary.
+ *
+ * @return The linked program or 0 if there is no binary for the key or the driver rejected it.
+ */
+static GLuint loadProgramBinary(unsigned long long key)
+{
+    GLuint program = 0;
+#ifdef GP_USE_PROGRAM_BINARY_CACHE
+    std::map<unsigned long long, ProgramBinary>::iterator itr = __programBinaries.find(key);
+    if (itr == __programBinaries.end())
+        return 0;
+
+    GLint success;
+    GL_ASSERT( program = glCreateProgram() );
+    GL_ASSERT( glProgramBinary(program, itr->second.format, itr->second.data.data(), (GLsizei)itr->second.data.size()) );
+    GL_ASSERT( glGetProgramiv(program, GL_LINK_STATUS, &success) );
+    if (success != GL_TRUE)
+    {
+        // The driver can reject binaries it wrote itself (e.g. after an update), relink from source
+        GLStateCache::deleteProgram(program);
+        __programBinaries.erase(itr);
+        __programCacheDirty = true;
+        return 0;
+    }
+#endif
+    return program;
+}
+
+/**
+ * Adds the binary of a newly linked program to the cache.
+ */
+static void storeProgramBinary(unsigned long long key, GLuint program)
+{
+#ifdef GP_USE_PROGRAM_BINARY_CACHE
+    if (!__programCacheEnabled)
+        return;
+
+    GLint length = 0;
+    GL_ASSERT( glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length) );
+    if (length <= 0)
+        return;
+
+    ProgramBinary& binary = __programBinaries[key];
+    binary.data.resize(length);
+    GL_ASSERT( glGetProgramBinary(program, length, NULL, &binary.format, binary.data.data()) );
+    __programCacheDirty = true;
+#endif
+}
+
 Effect* Effect::createFromFile(const char* vshPath, const char* fshPath, const char* defines)
 {
     GP_ASSERT(vshPath);
@@ -254,39 +453,6 @@ Effect* Effect::createFromSource(const char* vshPath, const char* vshSource, con
         if (vshSource && strlen(vshSource) != 0)
             vshSourceStr += "\n";
     }
-    shaderSource[2] = vshPath ? vshSourceStr.c_str() :  vshSource;
-    GL_ASSERT( vertexShader = glCreateShader(GL_VERTEX_SHADER) );
-    GL_ASSERT( glShaderSource(vertexShader, SHADER_SOURCE_LENGTH, shaderSource, NULL) );
-    GL_ASSERT( glCompileShader(vertexShader) );
-    GL_ASSERT( glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success) );
-    if (success != GL_TRUE)
-    {
-        GL_ASSERT( glGetShaderiv(vertexShader, GL_INFO_LOG_LENGTH, &length) );
-        if (length == 0)
-        {
-            length = 4096;
-        }
-        if (length > 0)
-        {
-            infoLog = new char[length];
-            GL_ASSERT( glGetShaderInfoLog(vertexShader, length, NULL, infoLog) );
-            infoLog[length-1] = '\0';
-        }
-
-        // Write out the expanded shader file.
-        if (vshPath)
-            writeShaderToErrorFile(vshPath, shaderSource[2]);
-
-        GP_ERROR("Compile failed for vertex shader '%s' with error '%s'.", vshPath == NULL ? vshSource : vshPath, infoLog == NULL ? "" : infoLog);
-        SAFE_DELETE_ARRAY(infoLog);
-
-        // Clean up.
-        GL_ASSERT( glDeleteShader(vertexShader) );
-
-        return NULL;
-    }
-
-    // Compile the fragment shader.
     std::string fshSourceStr;
     if (fshPath)
     {
@@ -295,71 +461,127 @@ Effect* Effect::createFromSource(const char* vshPath, const char* vshSource, con
         if (fshSource && strlen(fshSource) != 0)
             fshSourceStr += "\n";
     }
-    shaderSource[2] = fshPath ? fshSourceStr.c_str() : fshSource;
-    GL_ASSERT( fragmentShader = glCreateShader(GL_FRAGMENT_SHADER) );
-    GL_ASSERT( glShaderSource(fragmentShader, SHADER_SOURCE_LENGTH, shaderSource, NULL) );
-    GL_ASSERT( glCompileShader(fragmentShader) );
-    GL_ASSERT( glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success) );
-    if (success != GL_TRUE)
+    const char* vshSourceExpanded = vshPath ? vshSourceStr.c_str() : vshSource;
+    const char* fshSourceExpanded = fshPath ? fshSourceStr.c_str() : fshSource;
+
+    // Use the program binary linked by a previous run when there is one
+    unsigned long long programKey = 0;
+    program = 0;
+    if (__programCacheEnabled)
+    {
+        programKey = getProgramKey(definesStr.c_str(), vshSourceExpanded, fshSourceExpanded);
+        program = loadProgramBinary(programKey);
+    }
+
+    if (program == 0)
     {
-        GL_ASSERT( glGetShaderiv(fragmentShader, GL_INFO_LOG_LENGTH, &length) );
-        if (length == 0)
+        shaderSource[2] = vshSourceExpanded;
+        GL_ASSERT( vertexShader = glCreateShader(GL_VERTEX_SHADER) );
+        GL_ASSERT( glShaderSource(vertexShader, SHADER_SOURCE_LENGTH, shaderSource, NULL) );
+        GL_ASSERT( glCompileShader(vertexShader) );
+        GL_ASSERT( glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success) );
+        if (success != GL_TRUE)
         {
-            length = 4096;
+            GL_ASSERT( glGetShaderiv(vertexShader, GL_INFO_LOG_LENGTH, &length) );
+            if (length == 0)
+            {
+                length = 4096;
+            }
+            if (length > 0)
+            {
+                infoLog = new char[length];
+                GL_ASSERT( glGetShaderInfoLog(vertexShader, length, NULL, infoLog) );
+                infoLog[length-1] = '\0';
+            }
+
+            // Write out the expanded shader file.
+            if (vshPath)
+                writeShaderToErrorFile(vshPath, shaderSource[2]);
+
+            GP_ERROR("Compile failed for vertex shader '%s' with error '%s'.", vshPath == NULL ? vshSource : vshPath, infoLog == NULL ? "" : infoLog);
+            SAFE_DELETE_ARRAY(infoLog);
+
+            // Clean up.
+            GL_ASSERT( glDeleteShader(vertexShader) );
+
+            return NULL;
         }
-        if (length > 0)
+
+        // Compile the fragment shader.
+        shaderSource[2] = fshSourceExpanded;
+        GL_ASSERT( fragmentShader = glCreateShader(GL_FRAGMENT_SHADER) );
+        GL_ASSERT( glShaderSource(fragmentShader, SHADER_SOURCE_LENGTH, shaderSource, NULL) );
+        GL_ASSERT( glCompileShader(fragmentShader) );
+        GL_ASSERT( glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success) );
+        if (success != GL_TRUE)
         {
-            infoLog = new char[length];
-            GL_ASSERT( glGetShaderInfoLog(fragmentShader, length, NULL, infoLog) );
-            infoLog[length-1] = '\0';
-        }
+            GL_ASSERT( glGetShaderiv(fragmentShader, GL_INFO_LOG_LENGTH, &length) );
+            if (length == 0)
+            {
+                length = 4096;
+            }
+            if (length > 0)
+            {
+                infoLog = new char[length];
+                GL_ASSERT( glGetShaderInfoLog(fragmentShader, length, NULL, infoLog) );
+                infoLog[length-1] = '\0';
+            }
         
-        // Write out the expanded shader file.
-        if (fshPath)
-            writeShaderToErrorFile(fshPath, shaderSource[2]);
+            // Write out the expanded shader file.
+            if (fshPath)
+                writeShaderToErrorFile(fshPath, shaderSource[2]);
 
-        GP_ERROR("Compile failed for fragment shader (%s): %s", fshPath == NULL ? fshSource : fshPath, infoLog == NULL ? "" : infoLog);
-        SAFE_DELETE_ARRAY(infoLog);
+            GP_ERROR("Compile failed for fragment shader (%s): %s", fshPath == NULL ? fshSource : fshPath, infoLog == NULL ? "" : infoLog);
+            SAFE_DELETE_ARRAY(infoLog);
 
-        // Clean up.
-        GL_ASSERT( glDeleteShader(vertexShader) );
-        GL_ASSERT( glDeleteShader(fragmentShader) );
+            // Clean up.
+            GL_ASSERT( glDeleteShader(vertexShader) );
+            GL_ASSERT( glDeleteShader(fragmentShader) );
 
-        return NULL;
-    }
-
-    // Link program.
-    GL_ASSERT( program = glCreateProgram() );
-    GL_ASSERT( glAttachShader(program, vertexShader) );
-    GL_ASSERT( glAttachShader(program, fragmentShader) );
-    GL_ASSERT( glLinkProgram(program) );
-    GL_ASSERT( glGetProgramiv(program, GL_LINK_STATUS, &success) );
-
-    // Delete shaders after linking.
-    GL_ASSERT( glDeleteShader(vertexShader) );
-    GL_ASSERT( glDeleteShader(fragmentShader) );
+            return NULL;
+        }
 
-    // Check link status.
-    if (success != GL_TRUE)
-    {
-        GL_ASSERT( glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length) );
-        if (length == 0)
+        // Link program.
+        GL_ASSERT( program = glCreateProgram() );
+#ifdef GP_USE_PROGRAM_BINARY_CACHE
+        if (__programCacheEnabled)
         {
-            length = 4096;
+            GL_ASSERT( glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE) );
         }
-        if (length > 0)
+#endif
+        GL_ASSERT( glAttachShader(program, vertexShader) );
+        GL_ASSERT( glAttachShader(program, fragmentShader) );
+        GL_ASSERT( glLinkProgram(program) );
+        GL_ASSERT( glGetProgramiv(program, GL_LINK_STATUS, &success) );
+
+        // Delete shaders after linking.
+        GL_ASSERT( glDeleteShader(vertexShader) );
+        GL_ASSERT( glDeleteShader(fragmentShader) );
+
+        // Check link status.
+        if (success != GL_TRUE)
         {
-            infoLog = new char[length];
-            GL_ASSERT( glGetProgramInfoLog(program, length, NULL, infoLog) );
-            infoLog[length-1] = '\0';
-        }
-        GP_ERROR("Linking program failed (%s,%s): %s", vshPath == NULL ? "NULL" : vshPath, fshPath == NULL ? "NULL" : fshPath, infoLog == NULL ? "" : infoLog);
-        SAFE_DELETE_ARRAY(infoLog);
+            GL_ASSERT( glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length) );
+            if (length == 0)
+            {
+                length = 4096;
+            }
+            if (length > 0)
+            {
+                infoLog = new char[length];
+                GL_ASSERT( glGetProgramInfoLog(program, length, NULL, infoLog) );
+                infoLog[length-1] = '\0';
+            }
+            GP_ERROR("Linking program failed (%s,%s): %s", vshPath == NULL ? "NULL" : vshPath, fshPath == NULL ? "NULL" : fshPath, infoLog == NULL ? "" : infoLog);
+            SAFE_DELETE_ARRAY(infoLog);
 
-        // Clean up.
-        GL_ASSERT( glDeleteProgram(program) );
+            // Clean up.
+            GLStateCache::deleteProgram(program);
 
-        return NULL;
+            return NULL;
+        }
+
+        storeProgramBinary(programKey, program);
     }
 
     // Create and return the new Effect.
@@ -613,7 +835,7 @@ void Effect::setValue(Uniform* uniform, const Texture::Sampler* sampler)
     GP_ASSERT((sampler->getTexture()->getType() == Texture::TEXTURE_2D && uniform->_type == GL_SAMPLER_2D) || 
         (sampler->getTexture()->getType() == Texture::TEXTURE_CUBE && uniform->_type == GL_SAMPLER_CUBE));
 
-    GL_ASSERT( glActiveTexture(GL_TEXTURE0 + uniform->_index) );
+    GLStateCache::activeTexture(GL_TEXTURE0 + uniform->_index);
 
     // Bind the sampler - this binds the texture and applies sampler state
     const_cast<Texture::Sampler*>(sampler)->bind();
@@ -633,7 +855,7 @@ void Effect::setValue(Uniform* uniform, const Texture::Sampler** values, unsigne
     {
         GP_ASSERT((const_cast<Texture::Sampler*>(values[i])->getTexture()->getType() == Texture::TEXTURE_2D && uniform->_type == GL_SAMPLER_2D) || 
             (const_cast<Texture::Sampler*>(values[i])->getTexture()->getType() == Texture::TEXTURE_CUBE && uniform->_type == GL_SAMPLER_CUBE));
-        GL_ASSERT( glActiveTexture(GL_TEXTURE0 + uniform->_index + i) );
+        GLStateCache::activeTexture(GL_TEXTURE0 + uniform->_index + i);
 
         // Bind the sampler - this binds the texture and applies sampler state
         const_cast<Texture::Sampler*>(values[i])->bind();
@@ -647,7 +869,7 @@ void Effect::setValue(Uniform* uniform, const Texture::Sampler** values, unsigne
 
 void Effect::bind()
 {
-   GL_ASSERT( glUseProgram(_program) );
+    GLStateCache::useProgram(_program);
 
     __currentEffect = this;
 }
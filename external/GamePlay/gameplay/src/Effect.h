@@ -49,6 +49,31 @@ public:
      */
     static Effect* createFromSource(const char* vshSource, const char* fshSource, const char* defines = NULL);
 
+    /**
+     * Sets the file that linked program binaries are cached in between runs and loads the binaries it contains.
+     *
+     * Programs are looked up by a hash of their preprocessed sources and defines, a cached binary
+     * is used instead of compiling and linking the shaders whenever one is found. Binaries written
+     * by a different GL driver are discarded. Caching is only available where the driver supports
+     * program binaries (GL_ARB_get_program_binary), otherwise shaders are always compiled.
+     *
+     * Must be called once the GL context has been created.
+     *
+     * @param path The path of the cache file relative to the resource path, NULL disables the cache.
+     *
+     * @script{ignore}
+     */
+    static void setProgramCachePath(const char* path);
+
+    /**
+     * Writes the program binaries linked since the cache was loaded back to the cache file.
+     *
+     * Does nothing if no new programs have been linked.
+     *
+     * @script{ignore}
+     */
+    static void saveProgramCache();
+
     /**
      * Returns the unique string identifier for the effect, which is a concatenation of
      * the shader paths it was loaded from.
@@ -3,6 +3,7 @@
 #include "Properties.h"
 #include "Stream.h"
 #include "Platform.h"
+#include "zlib.h"
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -18,6 +19,9 @@
     #define __EXT_POSIX2
     #include <libgen.h>
     #include <dirent.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
     #define gp_stat stat
     #define gp_stat_struct struct stat
 #endif
@@ -145,6 +149,58 @@ private:
     bool _canWrite;
 };
 
+/**
+ * A read only stream over a file that has been mapped into memory.
+ *
+ * Also used for files inside a mounted pack, which are either a view into the mapped pack or
+ * a buffer holding the inflated contents of a compressed entry.
+ *
+ * @script{ignore}
+ */
+class MappedFileStream : public Stream
+{
+public:
+    friend class FileSystem;
+
+    ~MappedFileStream();
+    virtual bool canRead();
+    virtual bool canWrite();
+    virtual bool canSeek();
+    virtual void close();
+    virtual size_t read(void* ptr, size_t size, size_t count);
+    virtual char* readLine(char* str, int num);
+    virtual size_t write(const void* ptr, size_t size, size_t count);
+    virtual bool eof();
+    virtual size_t length();
+    virtual long int position();
+    virtual bool seek(long int offset, int origin);
+    virtual bool rewind();
+    virtual const void* getData();
+
+    /**
+     * How the memory behind the stream is released when it is closed.
+     */
+    enum Release
+    {
+        UNMAP,
+        DELETE_ARRAY,
+        NONE
+    };
+
+    static MappedFileStream* create(const char* filePath);
+
+    static MappedFileStream* create(const char* data, size_t length, Release release);
+
+private:
+    MappedFileStream(const char* data, size_t length, Release release);
+
+private:
+    const char* _data;
+    size_t _length;
+    size_t _position;
+    Release _release;
+};
+
 #ifdef __ANDROID__
 
 /**
@@ -169,6 +225,7 @@ public:
     virtual long int position();
     virtual bool seek(long int offset, int origin);
     virtual bool rewind();
+    virtual const void* getData();
 
     static FileStreamAndroid* create(const char* filePath, const char* mode);
 
@@ -181,6 +238,121 @@ private:
 
 #endif
 
+/**
+ * The header of a pack file.
+ *
+ * It is followed by the entry table, sorted by path, the null terminated paths and
+ * the contents of each entry aligned to PACK_ALIGNMENT bytes.
+ *
+ * @script{ignore}
+ */
+struct pack_header
+{
+    char identifier[8];
+    unsigned int version;
+    unsigned int entryCount;
+};
+
+/** @script{ignore} */
+struct pack_entry
+{
+    unsigned int pathOffset;
+    unsigned int offset;
+    unsigned int size;
+    unsigned int uncompressedSize;
+};
+
+static const char PACK_IDENTIFIER[8] = { 'G', 'P', 'P', 'A', 'C', 'K', '\0', '\0' };
+static const unsigned int PACK_VERSION = 1;
+static const unsigned int PACK_ALIGNMENT = 16;
+
+static Stream* __pack = NULL;
+static const pack_entry* __packEntries = NULL;
+static unsigned int __packEntryCount = 0;
+
+static const char* getPackData()
+{
+    return (const char*)__pack->getData();
+}
+
+/**
+ * Finds the entry for the given path in the mounted pack.
+ *
+ * @param path The path relative to the resource path, aliases resolved.
+ *
+ * @return The entry or NULL if no pack is mounted or it doesn't contain the path.
+ */
+static const pack_entry* findPackEntry(const char* path)
+{
+    if (!__pack || FileSystem::isAbsolutePath(path))
+        return NULL;
+
+    const char* data = getPackData();
+    const pack_entry* first = __packEntries;
+    const pack_entry* last = __packEntries + __packEntryCount;
+    const pack_entry* entry = std::lower_bound(first, last, path, [data](const pack_entry& e, const char* p)
+    {
+        return strcmp(data + e.pathOffset, p) < 0;
+    });
+    if (entry != last && strcmp(data + entry->pathOffset, path) == 0)
+        return entry;
+    return NULL;
+}
+
+/**
+ * Lists the files directly inside dirPath of the mounted pack.
+ *
+ * @return True if the pack contains at least one file in the directory.
+ */
+static bool listPackFiles(const char* dirPath, std::vector<std::string>& files)
+{
+    if (!__pack || !dirPath || FileSystem::isAbsolutePath(dirPath))
+        return false;
+
+    std::string prefix(dirPath);
+    while (!prefix.empty() && prefix[prefix.size() - 1] == '/')
+        prefix.erase(prefix.size() - 1);
+    if (!prefix.empty())
+        prefix += '/';
+
+    // Entries are sorted so every path in the directory follows the prefix
+    const char* data = getPackData();
+    const pack_entry* last = __packEntries + __packEntryCount;
+    const pack_entry* entry = std::lower_bound(__packEntries, last, prefix.c_str(), [data](const pack_entry& e, const char* p)
+    {
+        return strcmp(data + e.pathOffset, p) < 0;
+    });
+    size_t count = files.size();
+    for (; entry != last; ++entry)
+    {
+        const char* entryPath = data + entry->pathOffset;
+        if (strncmp(entryPath, prefix.c_str(), prefix.size()) != 0)
+            break;
+        const char* fileName = entryPath + prefix.size();
+        if (strchr(fileName, '/') == NULL)
+            files.push_back(fileName);
+    }
+    return files.size() > count;
+}
+
+static Stream* openPackEntry(const pack_entry* entry)
+{
+    const char* data = getPackData() + entry->offset;
+    if (entry->size == entry->uncompressedSize)
+        return MappedFileStream::create(data, entry->size, MappedFileStream::NONE);
+
+    char* buffer = new char[entry->uncompressedSize];
+    uLongf size = entry->uncompressedSize;
+    int result = uncompress((Bytef*)buffer, &size, (const Bytef*)data, entry->size);
+    if (result != Z_OK || size != entry->uncompressedSize)
+    {
+        GP_ERROR("Failed to inflate '%s' from pack (zlib error %d).", getPackData() + entry->pathOffset, result);
+        SAFE_DELETE_ARRAY(buffer);
+        return NULL;
+    }
+    return MappedFileStream::create(buffer, size, MappedFileStream::DELETE_ARRAY);
+}
+
 /////////////////////////////
 
 FileSystem::FileSystem()
@@ -250,6 +422,9 @@ const char* FileSystem::resolvePath(const char* path)
 
 bool FileSystem::listFiles(const char* dirPath, std::vector<std::string>& files)
 {
+    if (listPackFiles(dirPath, files))
+        return true;
+
 #ifdef WIN32
     std::string path(FileSystem::getResourcePath());
     if (dirPath && strlen(dirPath) > 0)
@@ -344,6 +519,9 @@ bool FileSystem::fileExists(const char* filePath)
 {
     GP_ASSERT(filePath);
 
+    if (findPackEntry(resolvePath(filePath)))
+        return true;
+
     std::string fullPath;
 
 #ifdef __ANDROID__
@@ -363,11 +541,30 @@ bool FileSystem::fileExists(const char* filePath)
 
 }
 
+unsigned long long FileSystem::getModifiedTime(const char* filePath)
+{
+    GP_ASSERT(filePath);
+
+    if (findPackEntry(resolvePath(filePath)))
+        return 0;
+
+    std::string fullPath;
+    getFullPath(filePath, fullPath);
+
+    gp_stat_struct s;
+    if (stat(fullPath.c_str(), &s) != 0)
+        return 0;
+
+    return (unsigned long long)s.st_mtime;
+}
+
 Stream* FileSystem::open(const char* path, size_t streamMode)
 {
     char modeStr[] = "rb";
     if ((streamMode & WRITE) != 0)
         modeStr[0] = 'w';
+    else if (const pack_entry* entry = findPackEntry(resolvePath(path)))
+        return openPackEntry(entry);
 #ifdef __ANDROID__
     std::string fullPath(__resourcePath);
     fullPath += resolvePath(path);
@@ -404,6 +601,14 @@ Stream* FileSystem::open(const char* path, size_t streamMode)
 #else
     std::string fullPath;
     getFullPath(path, fullPath);
+
+    if ((streamMode & MAPPED) != 0 && (streamMode & WRITE) == 0)
+    {
+        // Fall back to a regular stream if the file can't be mapped (e.g. it is empty)
+        if (MappedFileStream* stream = MappedFileStream::create(fullPath.c_str()))
+            return stream;
+    }
+
     FileStream* stream = FileStream::create(fullPath.c_str(), modeStr);
     return stream;
 #endif
@@ -456,6 +661,180 @@ char* FileSystem::readAll(const char* filePath, int* fileSize)
     return buffer;
 }
 
+bool FileSystem::mountPack(const char* packPath)
+{
+    GP_ASSERT(packPath);
+
+    unmountPack();
+
+    Stream* stream = open(packPath, READ | MAPPED);
+    if (!stream)
+        return false;
+
+    const char* data = (const char*)stream->getData();
+    size_t length = stream->length();
+    const pack_header* header = (const pack_header*)data;
+    if (!data || length < sizeof(pack_header) || memcmp(header->identifier, PACK_IDENTIFIER, sizeof(PACK_IDENTIFIER)) != 0 ||
+        header->version != PACK_VERSION || (length - sizeof(pack_header)) / sizeof(pack_entry) < header->entryCount)
+    {
+        GP_WARN("Pack '%s' could not be mapped or is not a version %u pack.", packPath, PACK_VERSION);
+        SAFE_DELETE(stream);
+        return false;
+    }
+
+    const pack_entry* entries = (const pack_entry*)(data + sizeof(pack_header));
+    for (unsigned int i = 0; i < header->entryCount; ++i)
+    {
+        const pack_entry& entry = entries[i];
+        if (entry.pathOffset >= length || memchr(data + entry.pathOffset, '\0', length - entry.pathOffset) == NULL ||
+            entry.offset > length || entry.size > length - entry.offset)
+        {
+            GP_WARN("Pack '%s' is truncated or corrupt.", packPath);
+            SAFE_DELETE(stream);
+            return false;
+        }
+    }
+
+    __pack = stream;
+    __packEntries = entries;
+    __packEntryCount = header->entryCount;
+    return true;
+}
+
+void FileSystem::unmountPack()
+{
+    SAFE_DELETE(__pack);
+    __packEntries = NULL;
+    __packEntryCount = 0;
+}
+
+bool FileSystem::isPackMounted()
+{
+    return __pack != NULL;
+}
+
+bool FileSystem::createPack(const char* packPath, Properties* directories)
+{
+    GP_ASSERT(packPath);
+    GP_ASSERT(directories);
+
+    if (__pack)
+    {
+        GP_ERROR("Failed to create pack '%s', a pack is mounted so directories can't be listed from disk.", packPath);
+        return false;
+    }
+
+    struct PackFile
+    {
+        std::string path;
+        std::vector<char> contents;
+        unsigned int uncompressedSize;
+    };
+    std::vector<PackFile> packFiles;
+
+    directories->rewind();
+    while (const char* dirPath = directories->getNextProperty())
+    {
+        bool compress = directories->getBool();
+        std::vector<std::string> fileNames;
+        if (!listFiles(dirPath, fileNames))
+        {
+            GP_WARN("Skipping missing directory '%s' while creating pack '%s'.", dirPath, packPath);
+            continue;
+        }
+
+        for (const std::string& fileName : fileNames)
+        {
+            PackFile file;
+            file.path = std::string(dirPath) + "/" + fileName;
+            int size = 0;
+            std::unique_ptr<char[]> data(readAll(file.path.c_str(), &size));
+            if (!data)
+                return false;
+            file.uncompressedSize = (unsigned int)size;
+            file.contents.assign(data.get(), data.get() + size);
+
+            if (compress && size > 0)
+            {
+                // Keep entries stored when compression doesn't pay off
+                uLongf compressedSize = compressBound(size);
+                std::vector<char> compressed(compressedSize);
+                if (compress2((Bytef*)compressed.data(), &compressedSize, (const Bytef*)data.get(), size, Z_BEST_COMPRESSION) == Z_OK &&
+                    compressedSize < (uLongf)size)
+                {
+                    compressed.resize(compressedSize);
+                    file.contents.swap(compressed);
+                }
+            }
+            packFiles.push_back(file);
+        }
+    }
+    directories->rewind();
+
+    std::sort(packFiles.begin(), packFiles.end(), [](const PackFile& a, const PackFile& b)
+    {
+        return strcmp(a.path.c_str(), b.path.c_str()) < 0;
+    });
+    for (size_t i = 1; i < packFiles.size(); ++i)
+    {
+        if (packFiles[i].path == packFiles[i - 1].path)
+        {
+            GP_ERROR("Failed to create pack '%s', '%s' is listed twice.", packPath, packFiles[i].path.c_str());
+            return false;
+        }
+    }
+
+    pack_header header;
+    memcpy(header.identifier, PACK_IDENTIFIER, sizeof(PACK_IDENTIFIER));
+    header.version = PACK_VERSION;
+    header.entryCount = (unsigned int)packFiles.size();
+
+    std::vector<pack_entry> entries(packFiles.size());
+    size_t offset = sizeof(pack_header) + sizeof(pack_entry) * entries.size();
+    for (size_t i = 0; i < packFiles.size(); ++i)
+    {
+        entries[i].pathOffset = (unsigned int)offset;
+        offset += packFiles[i].path.size() + 1;
+    }
+    for (size_t i = 0; i < packFiles.size(); ++i)
+    {
+        offset = (offset + PACK_ALIGNMENT - 1) & ~(size_t)(PACK_ALIGNMENT - 1);
+        entries[i].offset = (unsigned int)offset;
+        entries[i].size = (unsigned int)packFiles[i].contents.size();
+        entries[i].uncompressedSize = packFiles[i].uncompressedSize;
+        offset += entries[i].size;
+    }
+
+    std::unique_ptr<Stream> stream(open(packPath, WRITE));
+    if (!stream)
+    {
+        GP_ERROR("Failed to open '%s' for writing.", packPath);
+        return false;
+    }
+
+    bool written = stream->write(&header, sizeof(header), 1) == 1 &&
+        (entries.empty() || stream->write(entries.data(), sizeof(pack_entry), entries.size()) == entries.size());
+    for (size_t i = 0; written && i < packFiles.size(); ++i)
+    {
+        written = stream->write(packFiles[i].path.c_str(), 1, packFiles[i].path.size() + 1) == packFiles[i].path.size() + 1;
+    }
+    static const char padding[PACK_ALIGNMENT] = {};
+    size_t position = entries.empty() ? 0 : entries[0].pathOffset;
+    for (size_t i = 0; i < packFiles.size(); ++i)
+        position += packFiles[i].path.size() + 1;
+    for (size_t i = 0; written && i < packFiles.size(); ++i)
+    {
+        size_t paddingSize = entries[i].offset - position;
+        written = (paddingSize == 0 || stream->write(padding, 1, paddingSize) == paddingSize) &&
+            (entries[i].size == 0 || stream->write(packFiles[i].contents.data(), 1, entries[i].size) == entries[i].size);
+        position = entries[i].offset + entries[i].size;
+    }
+
+    if (!written)
+        GP_ERROR("Failed to write pack '%s'.", packPath);
+    return written;
+}
+
 bool FileSystem::isAbsolutePath(const char* filePath)
 {
     if (filePath == 0 || filePath[0] == '\0')
@@ -717,6 +1096,184 @@ bool FileStream::rewind()
 
 ////////////////////////////////
 
+MappedFileStream::MappedFileStream(const char* data, size_t length, Release release)
+    : _data(data), _length(length), _position(0), _release(release)
+{
+}
+
+MappedFileStream::~MappedFileStream()
+{
+    if (_data)
+    {
+        close();
+    }
+}
+
+MappedFileStream* MappedFileStream::create(const char* filePath)
+{
+    const char* data = NULL;
+    size_t length = 0;
+#ifdef WIN32
+    HANDLE file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping)
+        {
+            // The view keeps the mapping alive once both handles are closed
+            data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            length = (size_t)size.QuadPart;
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    int file = ::open(filePath, O_RDONLY);
+    if (file == -1)
+        return NULL;
+
+    gp_stat_struct s;
+    if (fstat(file, &s) == 0 && s.st_size > 0)
+    {
+        void* mapping = mmap(NULL, (size_t)s.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapping != MAP_FAILED)
+        {
+            data = (const char*)mapping;
+            length = (size_t)s.st_size;
+        }
+    }
+    ::close(file);
+#endif
+    if (!data)
+        return NULL;
+
+    return new MappedFileStream(data, length, UNMAP);
+}
+
+MappedFileStream* MappedFileStream::create(const char* data, size_t length, Release release)
+{
+    return new MappedFileStream(data, length, release);
+}
+
+bool MappedFileStream::canRead()
+{
+    return _data != NULL;
+}
+
+bool MappedFileStream::canWrite()
+{
+    return false;
+}
+
+bool MappedFileStream::canSeek()
+{
+    return _data != NULL;
+}
+
+void MappedFileStream::close()
+{
+    if (_data && _release == UNMAP)
+    {
+#ifdef WIN32
+        UnmapViewOfFile(_data);
+#else
+        munmap((void*)_data, _length);
+#endif
+    }
+    else if (_data && _release == DELETE_ARRAY)
+    {
+        delete[] _data;
+    }
+    _data = NULL;
+    _length = 0;
+    _position = 0;
+}
+
+size_t MappedFileStream::read(void* ptr, size_t size, size_t count)
+{
+    if (!_data || size == 0)
+        return 0;
+    count = std::min(count, (_length - _position) / size);
+    memcpy(ptr, _data + _position, size * count);
+    _position += size * count;
+    return count;
+}
+
+char* MappedFileStream::readLine(char* str, int num)
+{
+    if (!_data || num <= 0 || _position >= _length)
+        return NULL;
+
+    // Matches fgets(), the line break is kept and the string is always terminated
+    int i = 0;
+    while (i < num - 1 && _position < _length)
+    {
+        char c = _data[_position++];
+        str[i++] = c;
+        if (c == '\n')
+            break;
+    }
+    str[i] = '\0';
+    return str;
+}
+
+size_t MappedFileStream::write(const void* ptr, size_t size, size_t count)
+{
+    return 0;
+}
+
+bool MappedFileStream::eof()
+{
+    return _position >= _length;
+}
+
+size_t MappedFileStream::length()
+{
+    return _length;
+}
+
+long int MappedFileStream::position()
+{
+    if (!_data)
+        return -1;
+    return (long int)_position;
+}
+
+bool MappedFileStream::seek(long int offset, int origin)
+{
+    if (!_data)
+        return false;
+
+    long int base = 0;
+    if (origin == SEEK_CUR)
+        base = (long int)_position;
+    else if (origin == SEEK_END)
+        base = (long int)_length;
+    else if (origin != SEEK_SET)
+        return false;
+
+    if (base + offset < 0 || (size_t)(base + offset) > _length)
+        return false;
+    _position = (size_t)(base + offset);
+    return true;
+}
+
+bool MappedFileStream::rewind()
+{
+    return seek(0, SEEK_SET);
+}
+
+const void* MappedFileStream::getData()
+{
+    return _data;
+}
+
+////////////////////////////////
+
 #ifdef __ANDROID__
 
 FileStreamAndroid::FileStreamAndroid(AAsset* asset)
@@ -862,6 +1419,12 @@ bool FileStreamAndroid::rewind()
     return false;
 }
 
+const void* FileStreamAndroid::getData()
+{
+    // Uncompressed assets are mapped directly from the APK
+    return AAsset_getBuffer(_asset);
+}
+
 #endif
 
 }
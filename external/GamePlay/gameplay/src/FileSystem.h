@@ -24,7 +24,8 @@ public:
     enum StreamMode
     {
         READ = 1,
-        WRITE = 2
+        WRITE = 2,
+        MAPPED = 4
     };
 
     /**
@@ -146,12 +147,28 @@ public:
      */
     static bool fileExists(const char* filePath);
 
+    /**
+     * Gets the time the file at the given path was last modified.
+     *
+     * @param filePath The path to the file.
+     *
+     * @return The modification time in seconds since the epoch, or 0 if the file doesn't exist or is in a mounted pack
+     *      or the Android assets, which don't record it.
+     */
+    static unsigned long long getModifiedTime(const char* filePath);
+
     /**
      * Opens a byte stream for the given resource path.
      *
      * If <code>path</code> is a file path, the file at the specified location is opened relative to the currently set
      * resource path.
      *
+     * Files inside a mounted pack are opened from the pack, see mountPack(const char*).
+     *
+     * If <code>streamMode</code> is READ | MAPPED the file is mapped into memory and its contents are
+     * available through Stream::getData(). Platforms that cannot map the file fall back to a regular
+     * read stream, in which case Stream::getData() returns NULL.
+     *
      * @param path The path to the resource to be opened, relative to the currently set resource path.
      * @param streamMode The stream mode used to open the file.
      * 
@@ -192,6 +209,58 @@ public:
      */
     static char* readAll(const char* filePath, int* fileSize = NULL);
 
+    /**
+     * Mounts a pack so that files inside it are opened, listed and checked for existence from the pack
+     * before the file system is searched.
+     *
+     * The pack is mapped into memory for as long as it is mounted. Stored entries are returned as streams
+     * over the mapped memory without copying and compressed entries are inflated when they are opened.
+     * Only relative paths are looked up in the pack, openFile() always uses the file system.
+     * Any pack that is already mounted is unmounted first.
+     *
+     * @param packPath The path to the pack, relative to the currently set resource path.
+     *
+     * @return True if the pack was mounted, false if it could not be opened or is invalid.
+     *
+     * @see createPack(const char*, Properties*)
+     * @script{ignore}
+     */
+    static bool mountPack(const char* packPath);
+
+    /**
+     * Unmounts the currently mounted pack, if any.
+     *
+     * Streams opened from the pack must have been closed before it is unmounted.
+     *
+     * @script{ignore}
+     */
+    static void unmountPack();
+
+    /**
+     * Returns true if a pack is currently mounted.
+     *
+     * @return True if a pack is mounted.
+     *
+     * @script{ignore}
+     */
+    static bool isPackMounted();
+
+    /**
+     * Creates a pack containing the files in the given directories.
+     *
+     * Each property name in <code>directories</code> is a directory relative to the resource path,
+     * sub directories are not included. When the value of the property is true the files in that
+     * directory are compressed, unless that doesn't make them any smaller.
+     *
+     * The pack can't be created while a pack is mounted.
+     *
+     * @param packPath The path of the pack to write, relative to the currently set resource path.
+     * @param directories The directories to add to the pack.
+     *
+     * @return True if the pack was written successfully.
+     */
+    static bool createPack(const char* packPath, Properties* directories);
+
     /**
      * Determines if the file path is an absolute path for the current platform.
      * 
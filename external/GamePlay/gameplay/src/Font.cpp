@@ -16,6 +16,9 @@ namespace gameplay
 
 static std::vector<Font*> __fontCache;
 
+// Triangle strip indices for text runs, the sprites of a run are joined by degenerate triangles
+static std::vector<unsigned short> __runIndices;
+
 static Effect* __fontEffect = NULL;
 
 Font::Font() :
@@ -205,6 +208,15 @@ void Font::lazyStart()
         _batch->setProjectionMatrix(projectionMatrix);
     }
 
+    if (_format == DISTANCE_FIELD)
+    {
+        // The shader derives the edge smoothing from the screen space rate of change of the distance,
+        // so one cutoff gives sharp edges at every size the atlas is scaled to
+        if (_cutoffParam == NULL)
+            _cutoffParam = _batch->getMaterial()->getParameter("u_cutoff");
+        _cutoffParam->setVector2(Vector2(1.0f, 1.0f));
+    }
+
     _batch->start();
 }
 
@@ -224,6 +236,18 @@ void Font::finish()
 
 Font* Font::findClosestSize(int size)
 {
+    if (_format == DISTANCE_FIELD)
+    {
+        // A distance field scales to any size, so the largest one serves all sizes and text of mixed sizes shares a batch
+        Font* largest = this;
+        for (size_t i = 0, count = _sizes.size(); i < count; ++i)
+        {
+            if (_sizes[i]->_size > largest->_size)
+                largest = _sizes[i];
+        }
+        return largest;
+    }
+
     if (size == (int)_size)
         return this;
 
@@ -362,13 +386,6 @@ void Font::drawText(const char* text, int x, int y, const Vector4& color, unsign
                 {
                     Glyph& g = _glyphs[index];
 
-                    if (getFormat() == DISTANCE_FIELD )
-                    {
-                        if (_cutoffParam == NULL)
-                            _cutoffParam = _batch->getMaterial()->getParameter("u_cutoff");
-                        // TODO: Fix me so that smaller font are much smoother
-                        _cutoffParam->setVector2(Vector2(1.0, 1.0));
-                    }
                     PROFILE();
                     _batch->draw(xPos + (int)(g.bearingX * scale), yPos, g.width * scale, size, g.uvs[0], g.uvs[1], g.uvs[2], g.uvs[3], color);
                     xPos += floor(g.advance * scale + spacing);
@@ -394,6 +411,156 @@ void Font::drawText(const char* text, int x, int y, float red, float green, floa
     drawText(text, x, y, Vector4(red, green, blue, alpha), size, rightToLeft);
 }
 
+Font::TextRun::TextRun() : _font(NULL), _size(0), _x(0), _y(0), _color(Vector4::one())
+{
+}
+
+const char* Font::TextRun::getText() const
+{
+    return _text.c_str();
+}
+
+void Font::layoutText(TextRun* run, const char* text, unsigned int size)
+{
+    GP_ASSERT(_size);
+    GP_ASSERT(run);
+    GP_ASSERT(text);
+
+    if (size == 0)
+        size = _size;
+
+    Font* font = findClosestSize(size);
+    GP_ASSERT(font->_glyphs);
+    GP_ASSERT(font->_batch);
+
+    // Find how much of the current layout can be kept
+    size_t prefix = 0;
+    if (run->_font == font && run->_size == size)
+    {
+        const size_t length = run->_text.length();
+        while (prefix < length && text[prefix] == run->_text[prefix])
+            ++prefix;
+
+        if (prefix == length && text[prefix] == 0)
+            return;
+    }
+    else
+    {
+        run->_cursors.clear();
+        run->_vertices.clear();
+        run->_font = font;
+        run->_size = size;
+    }
+
+    int xPos = 0, yPos = 0;
+    if (prefix < run->_cursors.size())
+    {
+        const TextRun::Cursor& cursor = run->_cursors[prefix];
+        xPos = cursor.x;
+        yPos = cursor.y;
+        run->_vertices.resize(cursor.vertex);
+        run->_cursors.resize(prefix);
+    }
+
+    float scale = (float)size / font->_size;
+    int spacing = (int)(size * font->_spacing);
+    const Glyph* glyphs = font->_glyphs;
+
+    for (const char* c = text + prefix; ; ++c)
+    {
+        TextRun::Cursor cursor = { xPos, yPos, (unsigned int)run->_vertices.size() };
+        run->_cursors.push_back(cursor);
+        if (*c == 0)
+            break;
+
+        switch (*c)
+        {
+        case ' ':
+            xPos += glyphs[0].advance;
+            break;
+        case '\r':
+        case '\n':
+            yPos += size;
+            xPos = 0;
+            break;
+        case '\t':
+            xPos += glyphs[0].advance * 4;
+            break;
+        default:
+            int index = *c - 32; // HACK for ASCII
+            if (index >= 0 && index < (int)font->_glyphCount)
+            {
+                const Glyph& g = glyphs[index];
+                size_t vertex = run->_vertices.size();
+                run->_vertices.resize(vertex + 4);
+                font->_batch->addSprite(run->_x + xPos + (int)(g.bearingX * scale), run->_y + yPos, g.width * scale, size,
+                    g.uvs[0], g.uvs[1], g.uvs[2], g.uvs[3], run->_color, &run->_vertices[vertex]);
+                xPos += floor(g.advance * scale + spacing);
+            }
+            break;
+        }
+    }
+
+    run->_text = text;
+}
+
+void Font::drawText(TextRun* run, int x, int y, const Vector4& color)
+{
+    GP_ASSERT(run);
+
+    Font* font = run->_font;
+    if (!font || run->_vertices.empty())
+        return;
+
+    GP_ASSERT(font == findClosestSize(run->_size));
+    GP_ASSERT(run->_vertices.size() <= USHRT_MAX);
+
+    // The vertices are kept where the run was last drawn, so they only change when the run moves or changes color
+    if (x != run->_x || y != run->_y)
+    {
+        float dx = (float)(x - run->_x);
+        float dy = (float)(y - run->_y);
+        for (size_t i = 0, count = run->_vertices.size(); i < count; ++i)
+        {
+            run->_vertices[i].x += dx;
+            run->_vertices[i].y += dy;
+        }
+        run->_x = x;
+        run->_y = y;
+    }
+    if (color != run->_color)
+    {
+        for (size_t i = 0, count = run->_vertices.size(); i < count; ++i)
+        {
+            SpriteBatch::SpriteVertex& vertex = run->_vertices[i];
+            vertex.r = color.x;
+            vertex.g = color.y;
+            vertex.b = color.z;
+            vertex.a = color.w;
+        }
+        run->_color = color;
+    }
+
+    unsigned int glyphCount = (unsigned int)run->_vertices.size() / 4;
+    unsigned int indexCount = glyphCount * 6 - 2;
+    for (unsigned int glyph = (unsigned int)(__runIndices.size() + 2) / 6; __runIndices.size() < indexCount; ++glyph)
+    {
+        unsigned short vertex = (unsigned short)(glyph * 4);
+        if (glyph > 0)
+        {
+            __runIndices.push_back(vertex - 1);
+            __runIndices.push_back(vertex);
+        }
+        __runIndices.push_back(vertex);
+        __runIndices.push_back(vertex + 1);
+        __runIndices.push_back(vertex + 2);
+        __runIndices.push_back(vertex + 3);
+    }
+
+    font->lazyStart();
+    font->_batch->draw(&run->_vertices[0], (unsigned int)run->_vertices.size(), &__runIndices[0], indexCount);
+}
+
 void Font::drawText(const char* text, const Rectangle& area, const Vector4& color, unsigned int size, Justify justify, bool wrap, bool rightToLeft, const Rectangle& clip)
 {
     GP_ASSERT(text);
@@ -527,13 +694,6 @@ void Font::drawText(const char* text, const Rectangle& area, const Vector4& colo
                     // Draw this character.
                     if (draw)
                     {
-                        if (getFormat() == DISTANCE_FIELD)
-                        {
-                            if (_cutoffParam == NULL)
-                                _cutoffParam = _batch->getMaterial()->getParameter("u_cutoff");
-                            // TODO: Fix me so that smaller font are much smoother
-                            _cutoffParam->setVector2(Vector2(1.0, 1.0));
-                        }
                         if (clip != Rectangle(0, 0, 0, 0))
                         {
                             PROFILE();
@@ -59,6 +59,51 @@ public:
         DISTANCE_FIELD = 1
     };
 
+    /**
+     * Text laid out by a font into glyph quads that are ready to be appended to the font's sprite batch.
+     *
+     * A run is kept by its owner across frames. Laying it out again with text that starts like its current
+     * text only lays out the characters that follow the common prefix, and drawing it at the same position
+     * and in the same color as before appends its vertices to the batch as they are.
+     *
+     * @see Font::layoutText
+     * @script{ignore}
+     */
+    class TextRun
+    {
+        friend class Font;
+
+    public:
+
+        /**
+         * Constructor.
+         */
+        TextRun();
+
+        /**
+         * Gets the text the run was laid out with.
+         */
+        const char* getText() const;
+
+    private:
+
+        struct Cursor
+        {
+            int x;
+            int y;
+            unsigned int vertex;
+        };
+
+        std::string _text;
+        Font* _font;                                    // The sized font that laid out the run
+        unsigned int _size;
+        int _x;
+        int _y;
+        Vector4 _color;
+        std::vector<SpriteBatch::SpriteVertex> _vertices;
+        std::vector<Cursor> _cursors;                   // Pen position and first vertex of each character
+    };
+
     /**
      * Creates a font from the given bundle.
      *
@@ -157,6 +202,28 @@ public:
                   Justify justify = ALIGN_TOP_LEFT, bool wrap = true, bool rightToLeft = false,
                   const Rectangle& clip = Rectangle(0, 0, 0, 0));
 
+    /**
+     * Lays out left to right text into a run that can be drawn many times.
+     *
+     * Only the characters that follow the prefix the new text has in common with the text
+     * the run was previously laid out with are laid out again.
+     *
+     * @param run The run to lay the text out into.
+     * @param text The text to lay out.
+     * @param size The size to draw text (0 for default size).
+     */
+    void layoutText(TextRun* run, const char* text, unsigned int size = 0);
+
+    /**
+     * Draws a run laid out by layoutText in a solid color.
+     *
+     * @param run The run to draw.
+     * @param x The viewport x position to draw the run at.
+     * @param y The viewport y position to draw the run at.
+     * @param color The color of text.
+     */
+    void drawText(TextRun* run, int x, int y, const Vector4& color);
+
     /**
      * Finishes text batching for this font and renders all drawn text.
      */
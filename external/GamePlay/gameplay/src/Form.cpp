@@ -10,6 +10,7 @@
 #include "CheckBox.h"
 #include "Scene.h"
 #include "ProfilerController.h"
+#include "GLStateCache.h"
 
 // Scroll speed when using a joystick.
 static const float GAMEPAD_SCROLL_SPEED = 600.0f;
@@ -43,12 +44,15 @@ struct FormInit
 };
 static FormInit __init;
 
-Form::Form() : Drawable(), _batched(true)
+Form::Form() : Drawable(), _batched(true), _retained(true), _frameBuffer(NULL), _frameBufferBatch(NULL)
 {
 }
 
 Form::~Form()
 {
+    SAFE_DELETE(_frameBufferBatch);
+    SAFE_RELEASE(_frameBuffer);
+
     // Remove this Form from the global list.
     std::vector<Form*>::iterator it = std::find(__forms.begin(), __forms.end(), this);
     if (it != __forms.end())
@@ -103,6 +107,7 @@ Form* Form::create(const char* url)
     }
 
     form->_batched = formProperties->getBool("batchingEnabled", true);
+    form->_retained = formProperties->getBool("retainedRenderingEnabled", true);
 
     // Initialize the form and all of its child controls
     form->initialize("Form", style, formProperties);
@@ -255,10 +260,21 @@ unsigned int Form::draw(bool wireframe)
     else
     {
         // Setup an ortho matrix that maps to the current viewport
-        const Rectangle& viewport = Game::getInstance()->getViewport();
         Matrix::createOrthographicOffCenter(0, viewport.width, viewport.height, 0, 0, 1, &_projectionMatrix);
+
+        if (_retained && updateFrameBuffer())
+            return drawRetained(viewport);
     }
 
+    // Draw the whole form
+    _redrawRegion = _absoluteClipBounds;
+    unsigned int drawCalls = drawControls();
+    _redrawRegion = Rectangle();
+    return drawCalls;
+}
+
+unsigned int Form::drawControls()
+{
     // Draw the form
     unsigned int drawCalls = Container::draw(this, _absoluteClipBounds);
 
@@ -274,6 +290,95 @@ unsigned int Form::draw(bool wireframe)
     return drawCalls;
 }
 
+unsigned int Form::drawRetained(const Rectangle& viewport)
+{
+    unsigned int drawCalls = 0;
+    Rectangle region;
+    if (Rectangle::intersect(_redrawRegion, _frameBufferBounds, &region) && region.width > 0 && region.height > 0)
+    {
+        Game* game = Game::getInstance();
+        FrameBuffer* previousFrameBuffer = _frameBuffer->bind();
+        game->setViewport(Rectangle(0, 0, _frameBufferBounds.width, _frameBufferBounds.height));
+
+        // Only the changed area is cleared and redrawn, the rest of the frame buffer is kept from previous frames
+        int left = (int)floorf(region.x - _frameBufferBounds.x);
+        int top = (int)floorf(region.y - _frameBufferBounds.y);
+        int right = (int)ceilf(region.right() - _frameBufferBounds.x);
+        int bottom = (int)ceilf(region.bottom() - _frameBufferBounds.y);
+        GLStateCache::setEnabled(GL_SCISSOR_TEST, true);
+        GL_ASSERT( glScissor(left, (int)_frameBufferBounds.height - bottom, right - left, bottom - top) );
+        game->clear(Game::CLEAR_COLOR, Vector4::zero(), 1.0f, 0);
+
+        // Accumulate coverage in the alpha channel so the frame buffer holds premultiplied colors
+        GLStateCache::setBlendAlphaOverride(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        Matrix::createOrthographicOffCenter(_frameBufferBounds.x, _frameBufferBounds.right(), _frameBufferBounds.bottom(), _frameBufferBounds.y, 0, 1, &_projectionMatrix);
+        _redrawRegion = region;
+        drawCalls = drawControls();
+        GLStateCache::clearBlendAlphaOverride();
+        GLStateCache::setEnabled(GL_SCISSOR_TEST, false);
+
+        game->setViewport(viewport);
+        previousFrameBuffer->bind();
+    }
+    _redrawRegion = Rectangle();
+
+    Matrix projectionMatrix;
+    Matrix::createOrthographicOffCenter(0, viewport.width, viewport.height, 0, 0, 1, &projectionMatrix);
+    _frameBufferBatch->setProjectionMatrix(projectionMatrix);
+    _frameBufferBatch->start();
+    _frameBufferBatch->draw(_frameBufferBounds, Rectangle(0, 0, _frameBufferBounds.width, _frameBufferBounds.height));
+    _frameBufferBatch->finish();
+
+    return drawCalls + 1;
+}
+
+bool Form::updateFrameBuffer()
+{
+    Rectangle bounds(floorf(_absoluteClipBounds.x), floorf(_absoluteClipBounds.y), 0, 0);
+    bounds.width = ceilf(_absoluteClipBounds.right()) - bounds.x;
+    bounds.height = ceilf(_absoluteClipBounds.bottom()) - bounds.y;
+
+    if (!_frameBuffer || bounds.width != _frameBufferBounds.width || bounds.height != _frameBufferBounds.height)
+    {
+        SAFE_DELETE(_frameBufferBatch);
+        SAFE_RELEASE(_frameBuffer);
+
+        std::string id = std::string("form_") + _id;
+        _frameBuffer = FrameBuffer::create(id.c_str(), (unsigned int)bounds.width, (unsigned int)bounds.height);
+        if (!_frameBuffer)
+        {
+            GP_WARN("Failed to create the frame buffer of form '%s', drawing it without retained rendering.", _id.c_str());
+            _retained = false;
+            return false;
+        }
+
+        _frameBufferBatch = SpriteBatch::create(_frameBuffer->getRenderTarget()->getTexture());
+        _frameBufferBatch->getSampler()->setFilterMode(Texture::NEAREST, Texture::NEAREST);
+        _frameBufferBatch->getSampler()->setWrapMode(Texture::CLAMP, Texture::CLAMP);
+        _frameBufferBatch->getStateBlock()->setBlendSrc(RenderState::BLEND_ONE);
+        _frameBufferBatch->getStateBlock()->setBlendDst(RenderState::BLEND_ONE_MINUS_SRC_ALPHA);
+    }
+
+    if (bounds != _frameBufferBounds)
+    {
+        // Everything moved within the frame buffer
+        _frameBufferBounds = bounds;
+        _redrawRegion = bounds;
+    }
+    return true;
+}
+
+void Form::addRedrawRegion(const Rectangle& region)
+{
+    if (region.width <= 0 || region.height <= 0)
+        return;
+
+    if (_redrawRegion.width <= 0 || _redrawRegion.height <= 0)
+        _redrawRegion = region;
+    else
+        Rectangle::combine(_redrawRegion, region, &_redrawRegion);
+}
+
 Drawable* Form::clone(NodeCloneContext& context)
 {
     // TODO:
@@ -290,6 +395,22 @@ void Form::setBatchingEnabled(bool enabled)
     _batched = enabled;
 }
 
+bool Form::isRetainedRenderingEnabled() const
+{
+    return _retained;
+}
+
+void Form::setRetainedRenderingEnabled(bool enabled)
+{
+    _retained = enabled;
+    if (!_retained)
+    {
+        SAFE_DELETE(_frameBufferBatch);
+        SAFE_RELEASE(_frameBuffer);
+        _frameBufferBounds = Rectangle();
+    }
+}
+
 void Form::updateInternal(float elapsedTime)
 {
     PROFILE();
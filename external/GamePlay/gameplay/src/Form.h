@@ -140,6 +140,24 @@ public:
      */
     void setBatchingEnabled(bool enabled);
 
+    /**
+     * Determines whether retained rendering is enabled for this form.
+     *
+     * @return True if retained rendering is enabled for this form, false otherwise.
+     */
+    bool isRetainedRenderingEnabled() const;
+
+    /**
+     * Turns retained rendering on or off for this form.
+     *
+     * A retained form that isn't attached to a node keeps what it draws in a frame buffer of its own and
+     * only redraws the area covered by the controls whose state, bounds or contents changed since the
+     * previous frame, all other frames draw the frame buffer as a single quad.
+     *
+     * @param enabled True to enable retained rendering (default), false to draw all controls every frame.
+     */
+    void setRetainedRenderingEnabled(bool enabled);
+
 private:
     
     /**
@@ -252,6 +270,28 @@ private:
      */
     bool projectPoint(int x, int y, Vector3* point);
 
+    /**
+     * Adds an area, in absolute coordinates, that has to be redrawn by the next draw.
+     */
+    void addRedrawRegion(const Rectangle& region);
+
+    /**
+     * Draws all controls that intersect the redraw region and flushes the batches they were drawn into.
+     */
+    unsigned int drawControls();
+
+    /**
+     * Redraws the changed area of the frame buffer and draws the frame buffer.
+     */
+    unsigned int drawRetained(const Rectangle& viewport);
+
+    /**
+     * Creates the frame buffer used for retained rendering, recreating it when the size of the form changed.
+     *
+     * @return True if the frame buffer is available.
+     */
+    bool updateFrameBuffer();
+
     const Matrix& getProjectionMatrix() const;
 
     static bool pointerEventInternal(bool mouse, int evt, int x, int y, int param);
@@ -279,6 +319,11 @@ private:
     Matrix _projectionMatrix;           // Projection matrix to be set on SpriteBatch objects when rendering the form
     std::vector<SpriteBatch*> _batches;
     bool _batched;
+    bool _retained;                     // Whether the form is drawn through _frameBuffer
+    FrameBuffer* _frameBuffer;          // Holds everything drawn by the form when retained
+    SpriteBatch* _frameBufferBatch;     // Draws _frameBuffer
+    Rectangle _frameBufferBounds;       // Pixel aligned absolute bounds covered by _frameBuffer
+    Rectangle _redrawRegion;            // Absolute area that changed since the previous draw
 };
 
 }
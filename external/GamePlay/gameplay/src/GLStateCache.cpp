@@ -0,0 +1,382 @@
+#include "Base.h"
+#include "GLStateCache.h"
+#include "Game.h"
+
+// Shadowed texture units and vertex attributes, anything beyond these is always issued
+#define GL_STATE_CACHE_MAX_TEXTURE_UNITS 32
+#define GL_STATE_CACHE_MAX_VERTEX_ATTRIBS 32
+
+namespace gameplay
+{
+
+// Marks a shadowed value that doesn't match a known GL state
+static const GLuint UNKNOWN = 0xFFFFFFFF;
+
+/** @script{ignore} */
+struct GLState
+{
+    GLuint program;
+    GLuint activeTexture;
+    GLuint texture2D[GL_STATE_CACHE_MAX_TEXTURE_UNITS];
+    GLuint textureCube[GL_STATE_CACHE_MAX_TEXTURE_UNITS];
+    GLuint arrayBuffer;
+    GLuint elementArrayBuffer;
+    GLuint vertexArray;
+    GLuint vertexAttribArrayEnabled[GL_STATE_CACHE_MAX_VERTEX_ATTRIBS];
+    GLuint blend;
+    GLuint cullFace;
+    GLuint depthTest;
+    GLuint stencilTest;
+    GLuint blendSrc;
+    GLuint blendDst;
+    GLuint blendSrcAlpha;
+    GLuint blendDstAlpha;
+    GLuint cullFaceMode;
+    GLuint frontFaceMode;
+    GLuint depthMask;
+    GLuint depthFunc;
+    GLuint stencilMask;
+    GLuint stencilFunc;
+    GLint stencilFuncRef;
+    GLuint stencilFuncMask;
+    GLuint stencilOpSfail;
+    GLuint stencilOpDpfail;
+    GLuint stencilOpDppass;
+};
+
+static GLState __state;
+static bool __stateValid = false;
+static bool __blendAlphaOverride = false;
+static GLenum __blendSrcAlphaOverride = GL_ONE;
+static GLenum __blendDstAlphaOverride = GL_ONE_MINUS_SRC_ALPHA;
+static GLStateCache::FrameStats __frameStats = { 0, 0 };
+static GLStateCache::FrameStats __lastFrameStats = { 0, 0 };
+
+static GLState& getState()
+{
+    // The GL context belongs to the main thread
+    GP_ASSERT_MAIN_THREAD();
+
+    if (!__stateValid)
+    {
+        GLStateCache::invalidate();
+    }
+    return __state;
+}
+
+/**
+ * Updates a shadowed value.
+ *
+ * @return True if the value changed and the GL call has to be issued.
+ */
+static bool change(GLuint& shadow, GLuint value)
+{
+    if (shadow == value)
+    {
+        ++__frameStats.skipped;
+        return false;
+    }
+    shadow = value;
+    ++__frameStats.issued;
+    return true;
+}
+
+static GLuint* getTextureBinding(GLenum target)
+{
+    GLState& state = getState();
+    GLuint unit = state.activeTexture - GL_TEXTURE0;
+    if (state.activeTexture == UNKNOWN || unit >= GL_STATE_CACHE_MAX_TEXTURE_UNITS)
+        return NULL;
+    if (target == GL_TEXTURE_2D)
+        return &state.texture2D[unit];
+    if (target == GL_TEXTURE_CUBE_MAP)
+        return &state.textureCube[unit];
+    return NULL;
+}
+
+static GLuint* getCapability(GLenum capability)
+{
+    GLState& state = getState();
+    switch (capability)
+    {
+    case GL_BLEND:
+        return &state.blend;
+    case GL_CULL_FACE:
+        return &state.cullFace;
+    case GL_DEPTH_TEST:
+        return &state.depthTest;
+    case GL_STENCIL_TEST:
+        return &state.stencilTest;
+    default:
+        return NULL;
+    }
+}
+
+void GLStateCache::useProgram(GLuint program)
+{
+    if (change(getState().program, program))
+        GL_ASSERT( glUseProgram(program) );
+}
+
+void GLStateCache::activeTexture(GLenum unit)
+{
+    if (change(getState().activeTexture, unit))
+        GL_ASSERT( glActiveTexture(unit) );
+}
+
+void GLStateCache::bindTexture(GLenum target, GLuint texture)
+{
+    GLuint* binding = getTextureBinding(target);
+    if (!binding)
+    {
+        ++__frameStats.issued;
+        GL_ASSERT( glBindTexture(target, texture) );
+    }
+    else if (change(*binding, texture))
+    {
+        GL_ASSERT( glBindTexture(target, texture) );
+    }
+}
+
+void GLStateCache::bindBuffer(GLenum target, GLuint buffer)
+{
+    GLState& state = getState();
+    GLuint* binding = target == GL_ARRAY_BUFFER ? &state.arrayBuffer : (target == GL_ELEMENT_ARRAY_BUFFER ? &state.elementArrayBuffer : NULL);
+    if (!binding)
+    {
+        ++__frameStats.issued;
+        GL_ASSERT( glBindBuffer(target, buffer) );
+    }
+    else if (change(*binding, buffer))
+    {
+        GL_ASSERT( glBindBuffer(target, buffer) );
+    }
+}
+
+void GLStateCache::bindVertexArray(GLuint vertexArray)
+{
+    GLState& state = getState();
+    if (change(state.vertexArray, vertexArray))
+    {
+        GL_ASSERT( glBindVertexArray(vertexArray) );
+
+        state.elementArrayBuffer = UNKNOWN;
+        for (unsigned int i = 0; i < GL_STATE_CACHE_MAX_VERTEX_ATTRIBS; ++i)
+            state.vertexAttribArrayEnabled[i] = UNKNOWN;
+    }
+}
+
+void GLStateCache::setVertexAttribArrayEnabled(GLuint index, bool enabled)
+{
+    if (index >= GL_STATE_CACHE_MAX_VERTEX_ATTRIBS || change(getState().vertexAttribArrayEnabled[index], enabled ? GL_TRUE : GL_FALSE))
+    {
+        if (index >= GL_STATE_CACHE_MAX_VERTEX_ATTRIBS)
+            ++__frameStats.issued;
+
+        if (enabled)
+            GL_ASSERT( glEnableVertexAttribArray(index) );
+        else
+            GL_ASSERT( glDisableVertexAttribArray(index) );
+    }
+}
+
+void GLStateCache::setEnabled(GLenum capability, bool enabled)
+{
+    GLuint* shadow = getCapability(capability);
+    if (!shadow || change(*shadow, enabled ? GL_TRUE : GL_FALSE))
+    {
+        if (!shadow)
+            ++__frameStats.issued;
+
+        if (enabled)
+            GL_ASSERT( glEnable(capability) );
+        else
+            GL_ASSERT( glDisable(capability) );
+    }
+}
+
+void GLStateCache::blendFunc(GLenum src, GLenum dst)
+{
+    GLState& state = getState();
+    GLenum srcAlpha = __blendAlphaOverride ? __blendSrcAlphaOverride : src;
+    GLenum dstAlpha = __blendAlphaOverride ? __blendDstAlphaOverride : dst;
+    if (state.blendSrc == src && state.blendDst == dst && state.blendSrcAlpha == srcAlpha && state.blendDstAlpha == dstAlpha)
+    {
+        ++__frameStats.skipped;
+        return;
+    }
+    state.blendSrc = src;
+    state.blendDst = dst;
+    state.blendSrcAlpha = srcAlpha;
+    state.blendDstAlpha = dstAlpha;
+    ++__frameStats.issued;
+    if (srcAlpha == src && dstAlpha == dst)
+        GL_ASSERT( glBlendFunc(src, dst) );
+    else
+        GL_ASSERT( glBlendFuncSeparate(src, dst, srcAlpha, dstAlpha) );
+}
+
+static void reapplyBlendFunc()
+{
+    // RenderState only sets the blend function when it changes, so the current one is re-issued with the new alpha factors
+    GLState& state = getState();
+    GLenum src = state.blendSrc;
+    GLenum dst = state.blendDst;
+    if (src == UNKNOWN || dst == UNKNOWN)
+    {
+        GLint value;
+        GL_ASSERT( glGetIntegerv(GL_BLEND_SRC_RGB, &value) );
+        src = (GLenum)value;
+        GL_ASSERT( glGetIntegerv(GL_BLEND_DST_RGB, &value) );
+        dst = (GLenum)value;
+    }
+    GLStateCache::blendFunc(src, dst);
+}
+
+void GLStateCache::setBlendAlphaOverride(GLenum srcAlpha, GLenum dstAlpha)
+{
+    __blendAlphaOverride = true;
+    __blendSrcAlphaOverride = srcAlpha;
+    __blendDstAlphaOverride = dstAlpha;
+    reapplyBlendFunc();
+}
+
+void GLStateCache::clearBlendAlphaOverride()
+{
+    if (__blendAlphaOverride)
+    {
+        __blendAlphaOverride = false;
+        reapplyBlendFunc();
+    }
+}
+
+void GLStateCache::cullFace(GLenum mode)
+{
+    if (change(getState().cullFaceMode, mode))
+        GL_ASSERT( glCullFace(mode) );
+}
+
+void GLStateCache::frontFace(GLenum mode)
+{
+    if (change(getState().frontFaceMode, mode))
+        GL_ASSERT( glFrontFace(mode) );
+}
+
+void GLStateCache::depthMask(bool enabled)
+{
+    if (change(getState().depthMask, enabled ? GL_TRUE : GL_FALSE))
+        GL_ASSERT( glDepthMask(enabled ? GL_TRUE : GL_FALSE) );
+}
+
+void GLStateCache::depthFunc(GLenum func)
+{
+    if (change(getState().depthFunc, func))
+        GL_ASSERT( glDepthFunc(func) );
+}
+
+void GLStateCache::stencilMask(GLuint mask)
+{
+    GLState& state = getState();
+    if (state.stencilMask == mask && mask != UNKNOWN)
+    {
+        ++__frameStats.skipped;
+        return;
+    }
+    // All ones is a valid mask, so it is never treated as already current
+    state.stencilMask = mask;
+    ++__frameStats.issued;
+    GL_ASSERT( glStencilMask(mask) );
+}
+
+void GLStateCache::stencilFunc(GLenum func, GLint ref, GLuint mask)
+{
+    GLState& state = getState();
+    if (state.stencilFunc == func && state.stencilFuncRef == ref && state.stencilFuncMask == mask)
+    {
+        ++__frameStats.skipped;
+        return;
+    }
+    state.stencilFunc = func;
+    state.stencilFuncRef = ref;
+    state.stencilFuncMask = mask;
+    ++__frameStats.issued;
+    GL_ASSERT( glStencilFunc(func, ref, mask) );
+}
+
+void GLStateCache::stencilOp(GLenum sfail, GLenum dpfail, GLenum dppass)
+{
+    GLState& state = getState();
+    if (state.stencilOpSfail == sfail && state.stencilOpDpfail == dpfail && state.stencilOpDppass == dppass)
+    {
+        ++__frameStats.skipped;
+        return;
+    }
+    state.stencilOpSfail = sfail;
+    state.stencilOpDpfail = dpfail;
+    state.stencilOpDppass = dppass;
+    ++__frameStats.issued;
+    GL_ASSERT( glStencilOp(sfail, dpfail, dppass) );
+}
+
+void GLStateCache::deleteTexture(GLuint texture)
+{
+    // GL unbinds a deleted texture from every unit, and its name may be reused by the next texture
+    GLState& state = getState();
+    for (unsigned int i = 0; i < GL_STATE_CACHE_MAX_TEXTURE_UNITS; ++i)
+    {
+        if (state.texture2D[i] == texture)
+            state.texture2D[i] = 0;
+        if (state.textureCube[i] == texture)
+            state.textureCube[i] = 0;
+    }
+    GL_ASSERT( glDeleteTextures(1, &texture) );
+}
+
+void GLStateCache::deleteBuffer(GLuint buffer)
+{
+    GLState& state = getState();
+    if (state.arrayBuffer == buffer)
+        state.arrayBuffer = 0;
+    if (state.elementArrayBuffer == buffer)
+        state.elementArrayBuffer = 0;
+    GL_ASSERT( glDeleteBuffers(1, &buffer) );
+}
+
+void GLStateCache::deleteProgram(GLuint program)
+{
+    GLState& state = getState();
+    if (state.program == program)
+        state.program = UNKNOWN;
+    GL_ASSERT( glDeleteProgram(program) );
+}
+
+void GLStateCache::deleteVertexArray(GLuint vertexArray)
+{
+    GLState& state = getState();
+    if (state.vertexArray == vertexArray)
+        bindVertexArray(0);
+    GL_ASSERT( glDeleteVertexArrays(1, &vertexArray) );
+}
+
+void GLStateCache::invalidate()
+{
+    // Every shadowed value is a GLuint so they can all be marked unknown at once
+    GLuint* values = (GLuint*)&__state;
+    for (size_t i = 0; i < sizeof(GLState) / sizeof(GLuint); ++i)
+        values[i] = UNKNOWN;
+    __stateValid = true;
+}
+
+void GLStateCache::nextFrame()
+{
+    __lastFrameStats = __frameStats;
+    __frameStats.issued = 0;
+    __frameStats.skipped = 0;
+}
+
+const GLStateCache::FrameStats& GLStateCache::getFrameStats()
+{
+    return __lastFrameStats;
+}
+
+}
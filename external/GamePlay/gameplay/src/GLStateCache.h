@@ -0,0 +1,164 @@
+#ifndef GLSTATECACHE_H_
+#define GLSTATECACHE_H_
+
+namespace gameplay
+{
+
+/**
+ * Shadows the GL state that is changed while rendering so that calls which would not change anything are skipped.
+ *
+ * All bindings of programs, textures, buffers and vertex arrays as well as the fixed function state managed
+ * by RenderState must go through this class, otherwise the shadowed state no longer matches the driver.
+ * Code that changes any of this state directly must call invalidate() afterwards.
+ *
+ * @script{ignore}
+ */
+class GLStateCache
+{
+public:
+
+    /**
+     * The number of state changes requested in a frame.
+     */
+    struct FrameStats
+    {
+        /** The calls that reached GL. */
+        unsigned int issued;
+        /** The calls that were skipped because the state was already current. */
+        unsigned int skipped;
+    };
+
+    /**
+     * Wraps glUseProgram.
+     */
+    static void useProgram(GLuint program);
+
+    /**
+     * Wraps glActiveTexture, texture bindings are shadowed per texture unit.
+     */
+    static void activeTexture(GLenum unit);
+
+    /**
+     * Wraps glBindTexture for the active texture unit.
+     */
+    static void bindTexture(GLenum target, GLuint texture);
+
+    /**
+     * Wraps glBindBuffer for GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER.
+     */
+    static void bindBuffer(GLenum target, GLuint buffer);
+
+    /**
+     * Wraps glBindVertexArray.
+     *
+     * The element array buffer and the enabled vertex attribute arrays belong to the vertex array,
+     * so they are no longer known once a different vertex array is bound.
+     */
+    static void bindVertexArray(GLuint vertexArray);
+
+    /**
+     * Wraps glEnableVertexAttribArray and glDisableVertexAttribArray.
+     */
+    static void setVertexAttribArrayEnabled(GLuint index, bool enabled);
+
+    /**
+     * Wraps glEnable and glDisable for GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST and GL_STENCIL_TEST.
+     */
+    static void setEnabled(GLenum capability, bool enabled);
+
+    /**
+     * Wraps glBlendFunc.
+     */
+    static void blendFunc(GLenum src, GLenum dst);
+
+    /**
+     * Makes blendFunc use the given factors for the alpha channel until clearBlendAlphaOverride is called.
+     *
+     * Used when rendering into a transparent render target that is composited later with premultiplied
+     * alpha, the usual alpha blending would otherwise square the alpha written to the target.
+     */
+    static void setBlendAlphaOverride(GLenum srcAlpha, GLenum dstAlpha);
+
+    /**
+     * Stops overriding the alpha blend factors.
+     */
+    static void clearBlendAlphaOverride();
+
+    /**
+     * Wraps glCullFace.
+     */
+    static void cullFace(GLenum mode);
+
+    /**
+     * Wraps glFrontFace.
+     */
+    static void frontFace(GLenum mode);
+
+    /**
+     * Wraps glDepthMask.
+     */
+    static void depthMask(bool enabled);
+
+    /**
+     * Wraps glDepthFunc.
+     */
+    static void depthFunc(GLenum func);
+
+    /**
+     * Wraps glStencilMask.
+     */
+    static void stencilMask(GLuint mask);
+
+    /**
+     * Wraps glStencilFunc.
+     */
+    static void stencilFunc(GLenum func, GLint ref, GLuint mask);
+
+    /**
+     * Wraps glStencilOp.
+     */
+    static void stencilOp(GLenum sfail, GLenum dpfail, GLenum dppass);
+
+    /**
+     * Deletes a texture and forgets any texture unit it is bound to.
+     */
+    static void deleteTexture(GLuint texture);
+
+    /**
+     * Deletes a buffer and forgets any target it is bound to.
+     */
+    static void deleteBuffer(GLuint buffer);
+
+    /**
+     * Deletes a program, which must not be in use.
+     */
+    static void deleteProgram(GLuint program);
+
+    /**
+     * Deletes a vertex array and forgets it if it is bound.
+     */
+    static void deleteVertexArray(GLuint vertexArray);
+
+    /**
+     * Forgets all shadowed state so that the next change of each state is issued.
+     */
+    static void invalidate();
+
+    /**
+     * Starts counting the state changes of a new frame.
+     */
+    static void nextFrame();
+
+    /**
+     * Returns the state changes counted during the previous frame.
+     */
+    static const FrameStats& getFrameStats();
+
+private:
+
+    GLStateCache();
+};
+
+}
+
+#endif
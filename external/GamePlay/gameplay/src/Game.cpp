@@ -8,6 +8,7 @@
 #include "ControlFactory.h"
 #include "Theme.h"
 #include "Form.h"
+#include "GLStateCache.h"
 
 /** @script{ignore} */
 GLenum __gl_error_code = GL_NO_ERROR;
@@ -18,6 +19,10 @@ namespace gameplay
 {
 
 static Game* __gameInstance = NULL;
+// The physics controller made current on the calling thread, the one owned by the game is used when NULL
+static thread_local PhysicsController* __currentPhysicsController = NULL;
+// The thread that called Game::run()
+static std::thread::id __mainThreadId;
 double Game::_pausedTimeLast = 0.0;
 double Game::_pausedTimeTotal = 0.0;
 
@@ -66,7 +71,7 @@ Game::Game()
       _animationController(NULL), _audioController(NULL),
       _physicsController(NULL), _aiController(NULL), _audioListener(NULL),
       _timeEvents(NULL), _scriptController(NULL), _scriptTarget(NULL),
-      _profilerController(NULL), _timeScale(1.0f)
+      _profilerController(NULL), _jobController(NULL), _timeScale(1.0f), _renderPipelined(false)
 {
     GP_ASSERT(__gameInstance == NULL);
 
@@ -126,6 +131,11 @@ void Game::render(float elapsedTime)
     // stub
 }
 
+bool Game::isMainThread()
+{
+    return __mainThreadId == std::thread::id() || std::this_thread::get_id() == __mainThreadId;
+}
+
 double Game::getAbsoluteTime()
 {
     return Platform::getAbsoluteTime();
@@ -151,6 +161,8 @@ int Game::run()
     if (_state != UNINITIALIZED)
         return -1;
 
+    __mainThreadId = std::this_thread::get_id();
+
     loadConfig();
 
     _width = Platform::getDisplayWidth();
@@ -177,6 +189,9 @@ bool Game::startup()
 
     _profilerController = new ProfilerController();
 
+    _jobController = new JobController();
+    _jobController->initialize();
+
     _animationController = new AnimationController();
     _animationController->initialize();
 
@@ -282,6 +297,9 @@ void Game::shutdown()
         SAFE_DELETE(_physicsController);
         _aiController->finalize();
         SAFE_DELETE(_aiController);
+
+        _jobController->finalize();
+        SAFE_DELETE(_jobController);
         
         ControlFactory::finalize();
 
@@ -385,6 +403,8 @@ void Game::frame()
         Platform::resizeEventInternal(_width, _height);
     }
 
+    GLStateCache::nextFrame();
+
     static double lastFrameTime = Game::getGameTime();
     double frameTime = getGameTime();
 
@@ -410,8 +430,22 @@ void Game::frame()
         // Update the scheduled and running animations.
         _animationController->update(elapsedTime);
 
-        // Update the physics.
-        _physicsController->update(elapsedTime);
+        if (_renderPipelined)
+        {
+            // Render what the previous post simulation update captured while physics steps on its own thread
+            _physicsController->startUpdate(elapsedTime);
+            render(elapsedTime);
+
+            if (_scriptTarget)
+                _scriptTarget->fireScriptEvent<void>(GP_GET_SCRIPT_EVENT(GameScriptTarget, render), elapsedTime);
+
+            _physicsController->finishUpdate();
+        }
+        else
+        {
+            // Update the physics.
+            _physicsController->update(elapsedTime);
+        }
 
         // Update AI.
         _aiController->update(elapsedTime);
@@ -429,12 +463,18 @@ void Game::frame()
         // Audio Rendering.
         _audioController->update(elapsedTime);
 
-        // Graphics Rendering.
-        render(elapsedTime);
+        if (!_renderPipelined)
+        {
+            // Graphics Rendering.
+            render(elapsedTime);
 
-        // Run script render.
-        if (_scriptTarget)
-            _scriptTarget->fireScriptEvent<void>(GP_GET_SCRIPT_EVENT(GameScriptTarget, render), elapsedTime);
+            // Run script render.
+            if (_scriptTarget)
+                _scriptTarget->fireScriptEvent<void>(GP_GET_SCRIPT_EVENT(GameScriptTarget, render), elapsedTime);
+        }
+
+        // Complete the jobs added to this frame.
+        _jobController->finishFrame();
 
         // Update FPS.
         ++_frameCount;
@@ -466,6 +506,9 @@ void Game::frame()
         // Script render.
         if (_scriptTarget)
             _scriptTarget->fireScriptEvent<void>(GP_GET_SCRIPT_EVENT(GameScriptTarget, render), 0);
+
+        // Complete the jobs added to this frame.
+        _jobController->finishFrame();
     }
 }
 
@@ -497,6 +540,44 @@ void Game::updateOnce()
         _scriptTarget->fireScriptEvent<void>(GP_GET_SCRIPT_EVENT(GameScriptTarget, postSimulationUpdate), elapsedTime);
 }
 
+PhysicsController* Game::getPhysicsController() const
+{
+    return __currentPhysicsController ? __currentPhysicsController : _physicsController;
+}
+
+PhysicsController* Game::createPhysicsController()
+{
+    PhysicsController* physicsController = new PhysicsController();
+    physicsController->initialize();
+    return physicsController;
+}
+
+void Game::destroyPhysicsController(PhysicsController* physicsController)
+{
+    GP_ASSERT(physicsController && physicsController != _physicsController);
+    GP_ASSERT(physicsController != __currentPhysicsController);
+
+    physicsController->finalize();
+    SAFE_DELETE(physicsController);
+}
+
+void Game::updatePhysicsController(PhysicsController* physicsController, float elapsedTime)
+{
+    GP_ASSERT(physicsController && physicsController != _physicsController);
+
+    physicsController->update(elapsedTime);
+}
+
+void Game::setCurrentPhysicsController(PhysicsController* physicsController)
+{
+    __currentPhysicsController = physicsController;
+}
+
+PhysicsController* Game::getCurrentPhysicsController()
+{
+    return __currentPhysicsController;
+}
+
 void Game::setViewport(const Rectangle& viewport)
 {
     _viewport = viewport;
@@ -513,6 +594,16 @@ float Game::getTimeScale() const
     return _timeScale;
 }
 
+bool Game::isRenderPipelined() const
+{
+    return _renderPipelined;
+}
+
+void Game::setRenderPipelined(bool pipelined)
+{
+    _renderPipelined = pipelined;
+}
+
 void Game::clear(ClearFlags flags, const Vector4& clearColor, float clearDepth, int clearStencil)
 {
     PROFILE();
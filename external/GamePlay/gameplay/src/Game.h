@@ -11,6 +11,7 @@
 #include "PhysicsController.h"
 #include "AIController.h"
 #include "ProfilerController.h"
+#include "JobController.h"
 #include "AudioListener.h"
 #include "Rectangle.h"
 #include "Vector4.h"
@@ -92,6 +93,16 @@ public:
      */
     static void setVsync(bool enable);
 
+    /**
+     * Gets whether the calling thread is the one that called Game::run(), which owns the GL context.
+     *
+     * Job workers and the thread physics steps on while rendering is pipelined are not the main thread.
+     *
+     * @return true if called from the main thread, or before Game::run(); false if not.
+     * @script{ignore}
+     */
+    static bool isMainThread();
+
     /**
      * Gets the total absolute running time (in milliseconds) since Game::run().
      * 
@@ -211,6 +222,20 @@ public:
 
     void setTimeScale(float timeScale);
 
+    /**
+     * Gets whether rendering is pipelined with the physics step.
+     */
+    bool isRenderPipelined() const;
+
+    /**
+     * Sets whether rendering is pipelined with the physics step.
+     *
+     * When pipelined the world is stepped on the physics thread, running the simulation updates, while the
+     * frame is rendered. Rendering must then only use state captured by the previous post simulation update,
+     * anything else that is changed by a simulation update or by physics can be changed while it is read.
+     */
+    void setRenderPipelined(bool pipelined);
+
     /**
      * Clears the specified resource buffers to the specified clear values. 
      *
@@ -253,10 +278,59 @@ public:
     /**
      * Gets the physics controller for managing control of physics
      * associated with the game.
+     *
+     * Returns the physics controller made current on the calling thread if there is one,
+     * see setCurrentPhysicsController.
      * 
      * @return The physics controller for this game.
      */
-    inline PhysicsController* getPhysicsController() const;
+    PhysicsController* getPhysicsController() const;
+
+    /**
+     * Creates a physics controller with its own physics world, separate from the one owned by the game.
+     *
+     * Physics objects are added to the physics controller that is current when they are created, so
+     * a separate world is filled and stepped while it is current on the calling thread.
+     *
+     * @return The new physics controller.
+     * @script{ignore}
+     */
+    PhysicsController* createPhysicsController();
+
+    /**
+     * Destroys a physics controller created by createPhysicsController.
+     *
+     * @param physicsController The physics controller to destroy, it must not be current on any thread.
+     * @script{ignore}
+     */
+    void destroyPhysicsController(PhysicsController* physicsController);
+
+    /**
+     * Steps a physics controller created by createPhysicsController, the game steps its own physics controller each frame.
+     *
+     * The simulation updates of the step are sent to simulationUpdate on the calling thread.
+     *
+     * @param physicsController The physics controller to step, it should be current on the calling thread.
+     * @param elapsedTime The elapsed game time.
+     * @script{ignore}
+     */
+    void updatePhysicsController(PhysicsController* physicsController, float elapsedTime);
+
+    /**
+     * Sets the physics controller returned by getPhysicsController on the calling thread.
+     *
+     * @param physicsController The physics controller to make current, or NULL for the one owned by the game.
+     * @script{ignore}
+     */
+    static void setCurrentPhysicsController(PhysicsController* physicsController);
+
+    /**
+     * Gets the physics controller made current on the calling thread.
+     *
+     * @return The current physics controller, or NULL if the calling thread uses the one owned by the game.
+     * @script{ignore}
+     */
+    static PhysicsController* getCurrentPhysicsController();
 
     /** 
      * Gets the AI controller for managing control of artificial
@@ -276,6 +350,16 @@ public:
 
     inline ProfilerController* getProfilerController() const;
 
+    /**
+     * Gets the job controller for running work on more than one core.
+     *
+     * Jobs added to the current frame are complete by the end of the frame.
+     *
+     * @return The job controller for this game.
+     * @script{ignore}
+     */
+    inline JobController* getJobController() const;
+
     /**
      * Gets the audio listener for 3D audio.
      * 
@@ -764,11 +848,13 @@ private:
     PhysicsController* _physicsController;      // Controls the simulation of a physics scene and entities.
     AIController* _aiController;                // Controls AI simulation.
     ProfilerController* _profilerController;
+    JobController* _jobController;              // Runs jobs on the worker threads.
     AudioListener* _audioListener;              // The audio listener in 3D space.
     std::priority_queue<TimeEvent, std::vector<TimeEvent>, std::less<TimeEvent> >* _timeEvents;     // Contains the scheduled time events.
     ScriptController* _scriptController;            // Controls the scripting engine.
     ScriptTarget* _scriptTarget;                // Script target for the game
     float _timeScale;
+    bool _renderPipelined;
 
     // Note: Do not add STL object member variables on the stack; this will cause false memory leaks to be reported.
 
@@ -778,6 +864,11 @@ private:
 
 }
 
+/**
+ * Asserts that the calling code is running on the main thread, used by code that must stay on the thread that owns it.
+ */
+#define GP_ASSERT_MAIN_THREAD() GP_ASSERT(gameplay::Game::isMainThread())
+
 #include "Game.inl"
 
 #endif
@@ -49,11 +49,6 @@ inline AudioController* Game::getAudioController() const
     return _audioController;
 }
 
-inline PhysicsController* Game::getPhysicsController() const
-{
-    return _physicsController;
-}
-
 inline ScriptController* Game::getScriptController() const
 {
     return _scriptController;
@@ -66,6 +61,10 @@ inline ProfilerController* Game::getProfilerController() const
 {
     return _profilerController;
 }
+inline JobController* Game::getJobController() const
+{
+    return _jobController;
+}
 
 template <class T>
 void Game::renderOnce(T* instance, void (T::*method)(void*), void* cookie)
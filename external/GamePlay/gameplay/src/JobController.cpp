@@ -0,0 +1,343 @@
+#include "Base.h"
+#include "JobController.h"
+#include "Game.h"
+
+namespace gameplay
+{
+
+// The index of the queue owned by the calling thread, threads that are not workers use the shared queue
+static thread_local int __workerIndex = -1;
+
+// The initial number of tasks each queue can hold
+#define QUEUE_INITIAL_CAPACITY 64
+
+JobController::Group::Group()
+    : _pending(0)
+{
+}
+
+JobController::Group::~Group()
+{
+    GP_ASSERT(isComplete());
+}
+
+JobController::Group::Group(const Group& copy)
+{
+    // Hidden
+}
+
+bool JobController::Group::isComplete() const
+{
+    return _pending.load(std::memory_order_acquire) == 0;
+}
+
+JobController::Queue::Queue()
+    : tasks(QUEUE_INITIAL_CAPACITY), head(0), count(0)
+{
+}
+
+void JobController::Queue::pushBack(const Task& task)
+{
+    if (count == tasks.size())
+    {
+        std::vector<Task> grown(tasks.size() * 2);
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            grown[i] = tasks[(head + i) % tasks.size()];
+        }
+        tasks.swap(grown);
+        head = 0;
+    }
+
+    tasks[(head + count) % tasks.size()] = task;
+    ++count;
+}
+
+void JobController::Queue::popBack(Task* task)
+{
+    GP_ASSERT(count > 0);
+    Task& back = tasks[(head + count - 1) % tasks.size()];
+    *task = back;
+    back.job = nullptr;
+    --count;
+}
+
+void JobController::Queue::popFront(Task* task)
+{
+    GP_ASSERT(count > 0);
+    Task& front = tasks[head];
+    *task = front;
+    front.job = nullptr;
+    head = (head + 1) % tasks.size();
+    --count;
+}
+
+JobController::JobController()
+    : _queues(NULL), _counters(NULL), _queued(0), _exit(false)
+{
+}
+
+JobController::JobController(const JobController& copy)
+{
+    // Hidden
+}
+
+JobController::~JobController()
+{
+}
+
+void JobController::initialize()
+{
+    unsigned int workerCount = std::max(std::thread::hardware_concurrency(), 2U) - 1;
+
+    Properties* config = Game::getInstance()->getConfig()->getNamespace("jobs", true);
+    if (config && config->exists("workers"))
+    {
+        workerCount = config->getInt("workers");
+    }
+
+    _queues = new Queue[workerCount + 1];
+    _counters = new LaneCounters[workerCount + 1];
+    _lanes.resize(workerCount + 1);
+
+    for (unsigned int i = 0; i <= workerCount; ++i)
+    {
+        _counters[i].jobs = 0;
+        _counters[i].steals = 0;
+        _counters[i].busyMicroseconds = 0;
+        memset(&_lanes[i], 0, sizeof(Lane));
+    }
+
+    _exit = false;
+
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        _workers.push_back(new std::thread(&JobController::workerThreadProc, this, i));
+    }
+}
+
+void JobController::finalize()
+{
+    wait(&_frameGroup);
+
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _exit = true;
+    }
+    _wake.notify_all();
+
+    for (size_t i = 0; i < _workers.size(); ++i)
+    {
+        _workers[i]->join();
+        SAFE_DELETE(_workers[i]);
+    }
+
+    _workers.clear();
+    _lanes.clear();
+    SAFE_DELETE_ARRAY(_queues);
+    SAFE_DELETE_ARRAY(_counters);
+}
+
+void JobController::finishFrame()
+{
+    wait(&_frameGroup);
+
+    for (size_t i = 0; i < _lanes.size(); ++i)
+    {
+        _lanes[i].jobs = _counters[i].jobs.exchange(0, std::memory_order_relaxed);
+        _lanes[i].steals = _counters[i].steals.exchange(0, std::memory_order_relaxed);
+        _lanes[i].busyTime = _counters[i].busyMicroseconds.exchange(0, std::memory_order_relaxed) * 0.001;
+    }
+}
+
+void JobController::add(const Job& job, Group* group, Group* dependency)
+{
+    GP_ASSERT(_queues);
+
+    Task task;
+    task.job = job;
+    task.group = group ? group : &_frameGroup;
+    task.group->_pending.fetch_add(1, std::memory_order_relaxed);
+
+    if (dependency)
+    {
+        // Completing the dependency takes the same lock, so the job is either queued now or by the completion
+        std::lock_guard<std::mutex> lock(dependency->_mutex);
+        if (!dependency->isComplete())
+        {
+            dependency->_dependents.push_back(std::make_pair(task.job, task.group));
+            return;
+        }
+    }
+
+    push(task);
+}
+
+void JobController::wait(Group* group)
+{
+    GP_ASSERT(_queues);
+
+    if (!group)
+        group = &_frameGroup;
+
+    const unsigned int queueIndex = __workerIndex >= 0 ? __workerIndex : _workers.size();
+    Task task;
+
+    while (!group->isComplete())
+    {
+        if (pop(queueIndex, &task))
+        {
+            run(queueIndex, task);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // The last job may still hold the lock after it completed the group, which could be destroyed once this returns
+    std::lock_guard<std::mutex> lock(group->_mutex);
+}
+
+void JobController::parallelFor(unsigned int count, unsigned int grainSize, const RangeJob& job)
+{
+    if (count == 0)
+        return;
+
+    grainSize = std::max(grainSize, 1U);
+
+    if (count <= grainSize || _workers.empty())
+    {
+        job(0, count);
+        return;
+    }
+
+    Group group;
+    for (unsigned int begin = 0; begin < count; begin += grainSize)
+    {
+        const unsigned int end = std::min(begin + grainSize, count);
+        add([&job, begin, end]() { job(begin, end); }, &group);
+    }
+    wait(&group);
+}
+
+unsigned int JobController::getWorkerCount() const
+{
+    return _workers.size();
+}
+
+const JobController::Lane& JobController::getLane(unsigned int index) const
+{
+    GP_ASSERT(index < _lanes.size());
+    return _lanes[index];
+}
+
+bool JobController::isWorkerThread()
+{
+    return __workerIndex >= 0;
+}
+
+void JobController::push(const Task& task)
+{
+    const unsigned int queueIndex = __workerIndex >= 0 ? __workerIndex : _workers.size();
+    {
+        std::lock_guard<std::mutex> lock(_queues[queueIndex].mutex);
+        _queues[queueIndex].pushBack(task);
+    }
+
+    // Taking the lock orders the count against a worker that is about to sleep
+    _queued.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+    }
+    _wake.notify_one();
+}
+
+bool JobController::pop(unsigned int queueIndex, Task* task)
+{
+    GP_ASSERT(task);
+
+    const unsigned int queueCount = _workers.size() + 1;
+
+    // Newest first from the own queue, it is the most likely to still be in the cache
+    {
+        Queue& queue = _queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.count > 0)
+        {
+            queue.popBack(task);
+            _queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Oldest first from the others, it is the most likely to split into more work
+    for (unsigned int i = 1; i < queueCount; ++i)
+    {
+        Queue& queue = _queues[(queueIndex + i) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.count > 0)
+        {
+            queue.popFront(task);
+            _queued.fetch_sub(1, std::memory_order_relaxed);
+            _counters[queueIndex].steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void JobController::run(unsigned int queueIndex, const Task& task)
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    task.job();
+    const long long duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    _counters[queueIndex].jobs.fetch_add(1, std::memory_order_relaxed);
+    _counters[queueIndex].busyMicroseconds.fetch_add(duration, std::memory_order_relaxed);
+    complete(task.group);
+}
+
+void JobController::complete(Group* group)
+{
+    std::vector<std::pair<Job, Group*> > dependents;
+    {
+        std::lock_guard<std::mutex> lock(group->_mutex);
+        if (group->_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            dependents.swap(group->_dependents);
+        }
+    }
+
+    for (size_t i = 0; i < dependents.size(); ++i)
+    {
+        Task task;
+        task.job = dependents[i].first;
+        task.group = dependents[i].second;
+        push(task);
+    }
+}
+
+void JobController::workerThreadProc(unsigned int workerIndex)
+{
+    __workerIndex = workerIndex;
+    Task task;
+
+    while (true)
+    {
+        if (pop(workerIndex, &task))
+        {
+            run(workerIndex, task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_wakeMutex);
+        _wake.wait(lock, [this]() { return _queued.load(std::memory_order_acquire) > 0 || _exit; });
+
+        if (_exit && _queued.load(std::memory_order_acquire) == 0)
+            break;
+    }
+}
+
+}
@@ -0,0 +1,202 @@
+#ifndef JOBCONTROLLER_H_
+#define JOBCONTROLLER_H_
+
+namespace gameplay
+{
+
+/**
+ * Runs jobs on a pool of worker threads so that work can be spread over more than one core.
+ *
+ * Each worker has its own queue which it takes the newest job from, a worker with an empty queue steals
+ * the oldest job from another queue. Threads that are not workers add their jobs to a shared queue and
+ * help run jobs while they wait on a group.
+ *
+ * Jobs must not touch GL or mutate the physics world, code that must stay on the main thread asserts
+ * with GP_ASSERT_MAIN_THREAD().
+ *
+ * @script{ignore}
+ */
+class JobController
+{
+    friend class Game;
+
+public:
+
+    /**
+     * A job, it is called on any thread.
+     */
+    typedef std::function<void()> Job;
+
+    /**
+     * A job that processes the range [begin, end) of a parallel for.
+     */
+    typedef std::function<void(unsigned int begin, unsigned int end)> RangeJob;
+
+    /**
+     * A set of jobs that can be waited on and that other jobs can depend on, together they form a task graph.
+     *
+     * A group is complete when all of the jobs added to it have run, it can be reused once it is complete.
+     */
+    class Group
+    {
+        friend class JobController;
+
+    public:
+
+        /**
+         * Constructor.
+         */
+        Group();
+
+        /**
+         * Destructor, the group must be complete.
+         */
+        ~Group();
+
+        /**
+         * Determines if all of the jobs added to this group have run.
+         *
+         * @return True if the group is complete.
+         */
+        bool isComplete() const;
+
+    private:
+
+        Group(const Group& copy);
+
+        std::atomic<unsigned int> _pending;
+        std::mutex _mutex;
+        std::vector<std::pair<Job, Group*> > _dependents;
+    };
+
+    /**
+     * The jobs run by a worker during the previous frame.
+     *
+     * The last lane is shared by the threads that are not workers, such as the main thread.
+     */
+    struct Lane
+    {
+        /** The number of jobs run. */
+        unsigned int jobs;
+        /** The number of jobs stolen from another queue. */
+        unsigned int steals;
+        /** The time spent running jobs in milliseconds. */
+        double busyTime;
+    };
+
+    /**
+     * Adds a job to a group.
+     *
+     * @param job The job to run.
+     * @param group The group the job belongs to, or NULL to add it to the current frame which is completed at the end of the frame.
+     * @param dependency A group which must be complete before the job runs, or NULL.
+     */
+    void add(const Job& job, Group* group = NULL, Group* dependency = NULL);
+
+    /**
+     * Waits for all of the jobs in a group to run, the calling thread runs jobs while it waits.
+     *
+     * @param group The group to wait on, or NULL for the current frame.
+     */
+    void wait(Group* group = NULL);
+
+    /**
+     * Splits [0, count) into ranges of up to grainSize and runs them as jobs, returns when all of them have run.
+     *
+     * The calling thread runs ranges too, so this can be used from within a job.
+     *
+     * @param count The number of items.
+     * @param grainSize The maximum number of items in a range.
+     * @param job The job to run for each range.
+     */
+    void parallelFor(unsigned int count, unsigned int grainSize, const RangeJob& job);
+
+    /**
+     * Gets the number of worker threads, not counting threads that help while they wait.
+     *
+     * @return The number of worker threads.
+     */
+    unsigned int getWorkerCount() const;
+
+    /**
+     * Gets what a thread did in the previous frame.
+     *
+     * @param index The index of the lane, from 0 to getWorkerCount() inclusive.
+     * @return The lane.
+     */
+    const Lane& getLane(unsigned int index) const;
+
+    /**
+     * Determines if the calling thread is one of the worker threads.
+     *
+     * @return True if called from a worker thread.
+     */
+    static bool isWorkerThread();
+
+private:
+
+    struct Task
+    {
+        Job job;
+        Group* group;
+    };
+
+    /**
+     * A ring of tasks which only grows, so that adding jobs doesn't allocate once it is large enough.
+     */
+    struct Queue
+    {
+        Queue();
+        void pushBack(const Task& task);
+        void popBack(Task* task);
+        void popFront(Task* task);
+
+        std::mutex mutex;
+        std::vector<Task> tasks;
+        unsigned int head;
+        unsigned int count;
+    };
+
+    struct LaneCounters
+    {
+        std::atomic<unsigned int> jobs;
+        std::atomic<unsigned int> steals;
+        std::atomic<unsigned long long> busyMicroseconds;
+    };
+
+    JobController();
+
+    JobController(const JobController& copy);
+
+    ~JobController();
+
+    void initialize();
+
+    void finalize();
+
+    void finishFrame();
+
+    void push(const Task& task);
+
+    bool pop(unsigned int queueIndex, Task* task);
+
+    void run(unsigned int queueIndex, const Task& task);
+
+    void complete(Group* group);
+
+    void workerThreadProc(unsigned int workerIndex);
+
+    std::vector<std::thread*> _workers;
+    Queue* _queues;
+    LaneCounters* _counters;
+    std::vector<Lane> _lanes;
+    std::mutex _wakeMutex;
+    std::condition_variable _wake;
+    std::atomic<unsigned int> _queued;
+    std::atomic<bool> _exit;
+    Group _frameGroup;
+};
+
+}
+
+#endif
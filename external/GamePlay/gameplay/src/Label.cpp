@@ -68,6 +68,8 @@ void Label::setText(const char* text)
         _text = text ? text : "";
         if (_autoSize != AUTO_SIZE_NONE)
             setDirty(DIRTY_BOUNDS);
+        else
+            markForRedraw();
     }
 }
 
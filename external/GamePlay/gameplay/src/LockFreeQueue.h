@@ -0,0 +1,76 @@
+#ifndef LOCKFREEQUEUE_H_
+#define LOCKFREEQUEUE_H_
+
+namespace gameplay
+{
+
+/**
+ * Defines a fixed capacity queue that one thread can push to while another thread pops from it without locking.
+ *
+ * Only a single producer thread and a single consumer thread may use the queue at a time.
+ *
+ * @script{ignore}
+ */
+template <typename T>
+class LockFreeQueue
+{
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param capacity The maximum number of items that can be queued at once.
+     */
+    explicit LockFreeQueue(unsigned int capacity);
+
+    /**
+     * Destructor.
+     */
+    ~LockFreeQueue();
+
+    /**
+     * Adds an item to the back of the queue, must only be called by the producer thread.
+     *
+     * @param item The item to add.
+     * @return False if the queue is full.
+     */
+    bool push(const T& item);
+
+    /**
+     * Removes the item at the front of the queue, must only be called by the consumer thread.
+     *
+     * @param item Set to the removed item.
+     * @return False if the queue is empty.
+     */
+    bool pop(T* item);
+
+    /**
+     * Determines whether the queue is empty, the result is only reliable on the consumer thread.
+     *
+     * @return true if there are no queued items.
+     */
+    bool empty() const;
+
+private:
+
+    /**
+     * Hidden copy constructor.
+     */
+    LockFreeQueue(const LockFreeQueue& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    LockFreeQueue& operator=(const LockFreeQueue&);
+
+    T* _items;
+    unsigned int _capacity;
+    std::atomic<unsigned int> _head;
+    std::atomic<unsigned int> _tail;
+};
+
+}
+
+#include "LockFreeQueue.inl"
+
+#endif
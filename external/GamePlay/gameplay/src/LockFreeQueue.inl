@@ -0,0 +1,52 @@
+#include "LockFreeQueue.h"
+
+namespace gameplay
+{
+
+template <typename T>
+LockFreeQueue<T>::LockFreeQueue(unsigned int capacity)
+    : _items(NULL), _capacity(capacity + 1), _head(0), _tail(0)
+{
+    // One slot is always left empty so that a full queue can be told apart from an empty one
+    _items = new T[_capacity];
+}
+
+template <typename T>
+LockFreeQueue<T>::~LockFreeQueue()
+{
+    SAFE_DELETE_ARRAY(_items);
+}
+
+template <typename T>
+bool LockFreeQueue<T>::push(const T& item)
+{
+    unsigned int tail = _tail.load(std::memory_order_relaxed);
+    unsigned int next = (tail + 1) % _capacity;
+    if (next == _head.load(std::memory_order_acquire))
+        return false;
+
+    _items[tail] = item;
+    _tail.store(next, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool LockFreeQueue<T>::pop(T* item)
+{
+    GP_ASSERT(item);
+    unsigned int head = _head.load(std::memory_order_relaxed);
+    if (head == _tail.load(std::memory_order_acquire))
+        return false;
+
+    *item = _items[head];
+    _head.store((head + 1) % _capacity, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool LockFreeQueue<T>::empty() const
+{
+    return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+}
+
+}
@@ -4,6 +4,7 @@
 #include "Effect.h"
 #include "Model.h"
 #include "Material.h"
+#include "GLStateCache.h"
 
 namespace gameplay
 {
@@ -27,7 +28,7 @@ Mesh::~Mesh()
 
     if (_vertexBuffer)
     {
-        glDeleteBuffers(1, &_vertexBuffer);
+        GLStateCache::deleteBuffer(_vertexBuffer);
         _vertexBuffer = 0;
     }
 }
@@ -36,7 +37,7 @@ Mesh* Mesh::createMesh(const VertexFormat& vertexFormat, unsigned int vertexCoun
 {
     GLuint vbo;
     GL_ASSERT( glGenBuffers(1, &vbo) );
-    GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, vbo) );
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, vbo);
     GL_ASSERT( glBufferData(GL_ARRAY_BUFFER, vertexFormat.getVertexSize() * vertexCount, NULL, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW) );
 
     Mesh* mesh = new Mesh(vertexFormat);
@@ -263,7 +264,7 @@ void Mesh::setPrimitiveType(PrimitiveType type)
 
 void* Mesh::mapVertexBuffer()
 {
-    GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer) );
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
 
     return (void*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
 }
@@ -275,7 +276,7 @@ bool Mesh::unmapVertexBuffer()
 
 void Mesh::setVertexData(const void* vertexData, unsigned int vertexStart, unsigned int vertexCount)
 {
-    GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer) );
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
 
     if (vertexStart == 0 && vertexCount == 0)
     {
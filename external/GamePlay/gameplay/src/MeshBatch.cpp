@@ -2,6 +2,7 @@
 #include "MeshBatch.h"
 #include "Material.h"
 #include "ProfilerController.h"
+#include "GLStateCache.h"
 
 namespace gameplay
 {
@@ -250,7 +251,7 @@ void MeshBatch::draw()
 
     // Not using VBOs, so unbind the element array buffer.
     // ARRAY_BUFFER will be unbound automatically during pass->bind().
-    GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0 ) );
+    GLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
     GP_ASSERT(_material);
     if (_indexed)
@@ -1,5 +1,6 @@
 #include "Base.h"
 #include "MeshPart.h"
+#include "GLStateCache.h"
 
 namespace gameplay
 {
@@ -13,7 +14,7 @@ MeshPart::~MeshPart()
 {
     if (_indexBuffer)
     {
-        glDeleteBuffers(1, &_indexBuffer);
+        GLStateCache::deleteBuffer(_indexBuffer);
     }
 }
 
@@ -23,7 +24,7 @@ MeshPart* MeshPart::create(Mesh* mesh, unsigned int meshIndex, Mesh::PrimitiveTy
     // Create a VBO for our index buffer.
     GLuint vbo;
     GL_ASSERT( glGenBuffers(1, &vbo) );
-    GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vbo) );
+    GLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, vbo);
 
     unsigned int indexSize = 0;
     switch (indexFormat)
@@ -39,7 +40,7 @@ MeshPart* MeshPart::create(Mesh* mesh, unsigned int meshIndex, Mesh::PrimitiveTy
         break;
     default:
         GP_ERROR("Unsupported index format (%d).", indexFormat);
-        glDeleteBuffers(1, &vbo);
+        GLStateCache::deleteBuffer(vbo);
         return NULL;
     }
 
@@ -84,7 +85,7 @@ IndexBufferHandle MeshPart::getIndexBuffer() const
 
 void* MeshPart::mapIndexBuffer()
 {
-    GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer) );
+    GLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
 
     return (void*)glMapBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_WRITE_ONLY);
 }
@@ -96,7 +97,7 @@ bool MeshPart::unmapIndexBuffer()
 
 void MeshPart::setIndexData(const void* indexData, unsigned int indexStart, unsigned int indexCount)
 {
-    GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer) );
+    GLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
 
     unsigned int indexSize = 0;
     switch (_indexFormat)
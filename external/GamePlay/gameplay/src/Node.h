@@ -1,6 +1,7 @@
 #ifndef NODE_H_
 #define NODE_H_
 
+#include "Arena.h"
 #include "Transform.h"
 #include "ScriptTarget.h"
 #include "Model.h"
@@ -32,9 +33,11 @@ class Drawable;
  * This object allow you to attach components to a scene such as:
  * Drawable's(Model, Camera, Light, PhysicsCollisionObject, AudioSource, etc.
  *
+ * Nodes created while an Arena is current are allocated from it.
+ *
  * @see http://gameplay3d.github.io/GamePlay/docs/file-formats.html#wiki-Node
  */
-class Node : public Transform, public Ref
+class Node : public Transform, public Ref, public ArenaObject
 {
     friend class Scene;
     friend class SceneLoader;
@@ -10,6 +10,7 @@
 #define PARTICLE_EMISSION_RATE                   10
 #define PARTICLE_EMISSION_RATE_TIME_INTERVAL     1000.0f / (float)PARTICLE_EMISSION_RATE
 #define PARTICLE_UPDATE_RATE_MAX                 8
+#define PARTICLE_UPDATE_GRAIN_SIZE               256
 
 namespace gameplay
 {
@@ -25,7 +26,7 @@ ParticleEmitter::ParticleEmitter(unsigned int particleCountMax) : Drawable(),
     _acceleration(Vector3::zero()), _accelerationVar(Vector3::zero()),
     _rotationPerParticleSpeedMin(0.0f), _rotationPerParticleSpeedMax(0.0f),
     _rotationSpeedMin(0.0f), _rotationSpeedMax(0.0f),
-    _rotationAxis(Vector3::zero()), _rotation(Matrix::identity()),
+    _rotationAxis(Vector3::zero()),
     _spriteBatch(NULL), _spriteBlendMode(BLEND_ALPHA),  _spriteTextureWidth(0), _spriteTextureHeight(0), _spriteTextureWidthRatio(0), _spriteTextureHeightRatio(0), _spriteTextureCoords(NULL),
     _spriteAnimated(false),  _spriteLooped(false), _spriteFrameCount(1), _spriteFrameRandomOffset(0),_spriteFrameDuration(0L), _spriteFrameDurationSecs(0.0f), _spritePercentPerFrame(0.0f),
     _orbitPosition(false), _orbitVelocity(false), _orbitAcceleration(false),
@@ -893,9 +894,35 @@ void ParticleEmitter::update(float elapsedTime)
         }
     }
 
-    // Now update all currently living particles.
+    // Now update all currently living particles, each job only touches its own range of particles.
     GP_ASSERT(_particles);
-    for (unsigned int particlesIndex = 0; particlesIndex < _particleCount; ++particlesIndex)
+    Game::getInstance()->getJobController()->parallelFor(_particleCount, PARTICLE_UPDATE_GRAIN_SIZE, [this, elapsedMs, elapsedSecs](unsigned int begin, unsigned int end)
+    {
+        updateParticles(begin, end, elapsedMs, elapsedSecs);
+    });
+
+    for (unsigned int particlesIndex = 0; particlesIndex < _particleCount;)
+    {
+        if (_particles[particlesIndex]._energy > 0L)
+        {
+            ++particlesIndex;
+        }
+        else
+        {
+            // Particle is dead.  Move the particle furthest from the start of the array
+            // down to take its place, and re-use the slot at the end of the list of living particles.
+            if (particlesIndex != _particleCount - 1)
+            {
+                _particles[particlesIndex] = _particles[_particleCount - 1];
+            }
+            --_particleCount;
+        }
+    }
+}
+
+void ParticleEmitter::updateParticles(unsigned int begin, unsigned int end, float elapsedMs, float elapsedSecs)
+{
+    for (unsigned int particlesIndex = begin; particlesIndex < end; ++particlesIndex)
     {
         Particle* p = &_particles[particlesIndex];
         p->_energy -= elapsedMs;
@@ -904,10 +931,11 @@ void ParticleEmitter::update(float elapsedTime)
         {
             if (p->_rotationSpeed != 0.0f && !p->_rotationAxis.isZero())
             {
-                Matrix::createRotation(p->_rotationAxis, p->_rotationSpeed * elapsedSecs, &_rotation);
+                Matrix rotation;
+                Matrix::createRotation(p->_rotationAxis, p->_rotationSpeed * elapsedSecs, &rotation);
 
-                _rotation.transformPoint(p->_velocity, &p->_velocity);
-                _rotation.transformPoint(p->_acceleration, &p->_acceleration);
+                rotation.transformPoint(p->_velocity, &p->_velocity);
+                rotation.transformPoint(p->_acceleration, &p->_acceleration);
             }
 
             // Particle is still alive.
@@ -966,16 +994,6 @@ void ParticleEmitter::update(float elapsedTime)
                 }
             }
         }
-        else
-        {
-            // Particle is dead.  Move the particle furthest from the start of the array
-            // down to take its place, and re-use the slot at the end of the list of living particles.
-            if (particlesIndex != _particleCount - 1)
-            {
-                _particles[particlesIndex] = _particles[_particleCount - 1];
-            }
-            --_particleCount;
-        }
     }
 }
 
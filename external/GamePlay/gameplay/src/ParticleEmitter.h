@@ -731,6 +731,11 @@ private:
      */
     Drawable* clone(NodeCloneContext& context);
 
+    /**
+     * Updates the living particles in the range [begin, end), called from jobs.
+     */
+    void updateParticles(unsigned int begin, unsigned int end, float elapsedMs, float elapsedSecs);
+
     /**
      * Creates an uninitialized ParticleEmitter.
      *
@@ -819,7 +824,6 @@ private:
     float _rotationSpeedMax;
     Vector3 _rotationAxis;
     Vector3 _rotationAxisVar;
-    Matrix _rotation;
     SpriteBatch* _spriteBatch;
     BlendMode _spriteBlendMode;
     float _spriteTextureWidth;
@@ -37,7 +37,8 @@ struct CollidesWithCallback : public btCollisionWorld::ContactResultCallback
 };
 
 PhysicsCollisionObject::PhysicsCollisionObject(Node* node, int group, int mask)
-    : _node(node), _collisionShape(NULL), _enabled(true), _scriptListeners(NULL), _motionState(NULL), _group(group), _mask(mask)
+    : _node(node), _collisionShape(NULL), _enabled(true), _suspended(false), _suspendedActivationState(ACTIVE_TAG),
+      _suspendedDeactivationTime(0.0f), _scriptListeners(NULL), _motionState(NULL), _group(group), _mask(mask)
 {
 }
 
@@ -132,6 +133,34 @@ void PhysicsCollisionObject::setEnabled(bool enable)
     }
 }
 
+bool PhysicsCollisionObject::isSuspended() const
+{
+    return _suspended;
+}
+
+void PhysicsCollisionObject::setSuspended(bool suspend)
+{
+    if (suspend == _suspended)
+        return;
+
+    btCollisionObject* object = getCollisionObject();
+    GP_ASSERT(object);
+
+    if (suspend)
+    {
+        _suspendedActivationState = object->getActivationState();
+        _suspendedDeactivationTime = object->getDeactivationTime();
+        object->forceActivationState(DISABLE_SIMULATION);
+    }
+    else
+    {
+        object->forceActivationState(_suspendedActivationState);
+        object->setDeactivationTime(_suspendedDeactivationTime);
+    }
+
+    _suspended = suspend;
+}
+
 void PhysicsCollisionObject::addCollisionListener(CollisionListener* listener, PhysicsCollisionObject* object)
 {
     GP_ASSERT(Game::getInstance()->getPhysicsController());
@@ -218,6 +218,26 @@ public:
      */
     void setEnabled(bool enable);
 
+    /**
+     * Check if the simulation of the collision object is suspended.
+     *
+     * @return true if the simulation of the collision object is suspended.
+     * @script{ignore}
+     */
+    bool isSuspended() const;
+
+    /**
+     * Suspends or resumes the simulation of the collision object.
+     *
+     * A suspended object stays in the world and can be collided with but doesn't move or take part in the
+     * simulation islands, which is cheaper than simulating it. Resuming restores the activation state it
+     * had when it was suspended so the simulation continues from where it left off.
+     *
+     * @param suspend true suspends the simulation of the collision object, false resumes it.
+     * @script{ignore}
+     */
+    void setSuspended(bool suspend);
+
     /**
      * Adds a collision listener for this collision object.
      * 
@@ -332,6 +352,13 @@ protected:
      */
     bool _enabled;
 
+    /**
+     * If the simulation of the collision object is suspended, and the activation state to restore when it is resumed.
+     */
+    bool _suspended;
+    int _suspendedActivationState;
+    float _suspendedDeactivationTime;
+
     /**
      * The list of script listeners.
      */
@@ -23,7 +23,12 @@
 // The initial capacity of the Bullet debug drawer's vertex batch.
 #define INITIAL_CAPACITY 280
 #define FIXED_TIMESTEP (btScalar(1.) / btScalar(120.))
-#define MAX_SUBSTEPS 4
+// The defaults of the step governor, they can be set in the 'physics' namespace of the game config
+#define MAX_SUBSTEPS 8
+#define MAX_CATCH_UP_TIME 100.0f
+#define STEP_BUDGET 4.0f
+// The weight of the latest measurement in the average cost of a fixed time step
+#define SUBSTEP_COST_SMOOTHING 0.1f
 
 namespace gameplay
 {
@@ -37,7 +42,9 @@ PhysicsController::PhysicsController()
   : _isUpdating(false), _enabled(true), _collisionConfiguration(NULL), _dispatcher(NULL),
     _overlappingPairCache(NULL), _solver(NULL), _world(NULL), _ghostPairCallback(NULL),
     _debugDrawer(NULL), _status(PhysicsController::Listener::DEACTIVATED), _listeners(NULL),
-    _gravity(btScalar(0.0), btScalar(-9.8), btScalar(0.0)), _collisionCallback(NULL)
+    _gravity(btScalar(0.0), btScalar(-9.8), btScalar(0.0)), _collisionCallback(NULL),
+    _stepElapsedTime(0.0f), _stepPending(false), _stepThreadExit(false), _stepThreadTime(0.0),
+    _maxCatchUpTime(MAX_CATCH_UP_TIME), _stepBudget(STEP_BUDGET), _maxSubsteps(MAX_SUBSTEPS)
 {
     GP_REGISTER_SCRIPT_EVENTS();
 
@@ -480,10 +487,36 @@ void PhysicsController::initialize()
 
     _actionInterface = new ActionInterface();
     _world->addAction(_actionInterface);
+
+    Properties* config = Game::getInstance()->getConfig()->getNamespace("physics", true);
+    if (config)
+    {
+        if (config->exists("max_catch_up_ms"))
+            _maxCatchUpTime = config->getFloat("max_catch_up_ms");
+        if (config->exists("step_budget_ms"))
+            _stepBudget = config->getFloat("step_budget_ms");
+        if (config->exists("max_substeps"))
+            _maxSubsteps = std::max(config->getInt("max_substeps"), 1);
+    }
+
+    memset(&_stepStats, 0, sizeof(StepStats));
+    _stepStats.substepLimit = _maxSubsteps;
+    _finishedStepStats = _stepStats;
 }
 
 void PhysicsController::finalize()
 {
+    if (_stepThread.get())
+    {
+        {
+            std::lock_guard<std::mutex> lock(_stepMutex);
+            _stepThreadExit = true;
+        }
+        _stepStarted.notify_one();
+        _stepThread->join();
+        _stepThread.reset(NULL);
+    }
+
     if(_world)
     {
         _world->removeAction(_actionInterface);
@@ -519,16 +552,134 @@ void PhysicsController::update(float elapsedTime)
     GP_ASSERT(_world);
     _isUpdating = true;
 
-    // Update the physics simulation, with a maximum
-    // of 10 simulation steps being performed in a given frame.
-    //
+    {
+        PROFILE_(step);
+        step(elapsedTime);
+    }
+
+    _finishedStepStats = _stepStats;
+    updateCollisionStatus();
+}
+
+void PhysicsController::startUpdate(float elapsedTime)
+{
+    if(!_enabled)
+    {
+        return;
+    }
+
+    GP_ASSERT(_world);
+    _isUpdating = true;
+
+    if (!_stepThread.get())
+    {
+        _stepThreadExit = false;
+        _stepThread.reset(new std::thread(&PhysicsController::stepThreadProc, this));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_stepMutex);
+        _stepElapsedTime = elapsedTime;
+        _stepPending = true;
+    }
+    _stepStarted.notify_one();
+}
+
+void PhysicsController::finishUpdate()
+{
+    if (!_isUpdating)
+    {
+        return;
+    }
+
+    PROFILE();
+    waitForStep();
+    _finishedStepStats = _stepStats;
+    updateCollisionStatus();
+}
+
+void PhysicsController::waitForStep()
+{
+    std::unique_lock<std::mutex> lock(_stepMutex);
+    _stepFinished.wait(lock, [this] { return !_stepPending; });
+}
+
+double PhysicsController::getStepThreadTime() const
+{
+    return _stepThreadTime;
+}
+
+const PhysicsController::StepStats& PhysicsController::getStepStats() const
+{
+    return _finishedStepStats;
+}
+
+void PhysicsController::stepThreadProc()
+{
+    std::unique_lock<std::mutex> lock(_stepMutex);
+
+    while (true)
+    {
+        _stepStarted.wait(lock, [this] { return _stepPending || _stepThreadExit; });
+
+        if (_stepThreadExit)
+        {
+            break;
+        }
+
+        const float elapsedTime = _stepElapsedTime;
+        lock.unlock();
+        const double startTime = Game::getAbsoluteTime();
+        step(elapsedTime);
+        _stepThreadTime = Game::getAbsoluteTime() - startTime;
+        lock.lock();
+        _stepPending = false;
+        _stepFinished.notify_all();
+    }
+}
+
+void PhysicsController::step(float elapsedTime)
+{
+    // Time beyond the catch up limit is dropped, so that a stall such as a level load or a
+    // debugger pause doesn't make the frames that follow it simulate a burst of steps.
+    float time = elapsedTime + _stepStats.timeDebt;
+    if (time > _maxCatchUpTime)
+    {
+        _stepStats.droppedTime += time - _maxCatchUpTime;
+        ++_stepStats.droppedSteps;
+        time = _maxCatchUpTime;
+    }
+
+    // Bullet drops the time of the fixed steps beyond the limit, instead it is held back as
+    // debt which is simulated by later steps that have time to spare.
+    const float fixedTimeStep = FIXED_TIMESTEP * 1000.0f;
+    const float localTime = static_cast<PhysicsWorld*>(_world)->getLocalTime() * 1000.0f;
+    const unsigned int fixedSteps = static_cast<unsigned int>((localTime + time) / fixedTimeStep);
+    const unsigned int substeps = std::min(fixedSteps, _stepStats.substepLimit);
+    const float timeDebt = (fixedSteps - substeps) * fixedTimeStep;
+
     // Note that stepSimulation takes elapsed time in seconds
     // so we divide by 1000 to convert from milliseconds.
+    const double startTime = Game::getAbsoluteTime();
+    _world->stepSimulation((time - timeDebt) * 0.001f, std::max(substeps, 1U), FIXED_TIMESTEP);
+    const double duration = Game::getAbsoluteTime() - startTime;
+
+    // The limit follows the measured cost so that a frame that steps slowly doesn't make
+    // the next frame longer, which would need more steps again.
+    if (substeps > 0)
     {
-        PROFILE_(step);
-        _world->stepSimulation(elapsedTime * 0.001f, MAX_SUBSTEPS, FIXED_TIMESTEP);
+        const float cost = duration / substeps;
+        _stepStats.substepCost = _stepStats.substepCost > 0.0f ? _stepStats.substepCost + (cost - _stepStats.substepCost) * SUBSTEP_COST_SMOOTHING : cost;
+        const unsigned int affordable = _stepStats.substepCost > 0.0f ? static_cast<unsigned int>(_stepBudget / _stepStats.substepCost) : _maxSubsteps;
+        _stepStats.substepLimit = std::max(std::min(affordable, _maxSubsteps), 1U);
     }
 
+    _stepStats.substeps = substeps;
+    _stepStats.timeDebt = timeDebt;
+}
+
+void PhysicsController::updateCollisionStatus()
+{
     // If we have status listeners, then check if our status has changed.
     if (_listeners || hasScriptListener(GP_GET_SCRIPT_EVENT(PhysicsController, statusEvent)))
     {
@@ -682,6 +833,8 @@ void PhysicsController::addCollisionObject(PhysicsCollisionObject* object)
 {
     GP_ASSERT(object && object->getCollisionObject());
     GP_ASSERT(_world);
+    // A job can only change a physics world it made current, such as one it is stepping
+    GP_ASSERT(!JobController::isWorkerThread() || Game::getCurrentPhysicsController() == this);
 
     // Assign user pointer for the bullet collision object to allow efficient
     // lookups of bullet objects -> gameplay objects.
@@ -715,6 +868,7 @@ void PhysicsController::removeCollisionObject(PhysicsCollisionObject* object, bo
     GP_ASSERT(object);
     GP_ASSERT(_world);
     GP_ASSERT(!_isUpdating);
+    GP_ASSERT(!JobController::isWorkerThread() || Game::getCurrentPhysicsController() == this);
 
     // Remove the collision object from the world.
     if (object->getCollisionObject())
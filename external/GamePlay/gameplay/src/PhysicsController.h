@@ -288,6 +288,53 @@ public:
     PhysicsSpringConstraint* createSpringConstraint(PhysicsRigidBody* a, const Quaternion& rotationOffsetA, const Vector3& translationOffsetA,          
                                                     PhysicsRigidBody* b, const Quaternion& rotationOffsetB, const Vector3& translationOffsetB);
 
+    /**
+     * Waits for a step running on the physics thread to finish.
+     *
+     * When rendering is pipelined the world is stepped while the previous frame is rendered,
+     * rendering that reads the world directly has to call this first.
+     */
+    void waitForStep();
+
+    /**
+     * Gets the time in milliseconds taken by the last step on the physics thread.
+     */
+    double getStepThreadTime() const;
+
+    /**
+     * How the simulation time of the last step was spent.
+     *
+     * Each step simulates the elapsed time plus the time debt carried over from earlier steps, up to 'max_catch_up_ms'
+     * from the 'physics' namespace of the game config, the rest is dropped. The fixed time steps it covers are limited
+     * to as many as fit in 'step_budget_ms' at the measured cost of a fixed time step, and to 'max_substeps'. The time
+     * of the steps beyond the limit becomes time debt.
+     *
+     * @script{ignore}
+     */
+    struct StepStats
+    {
+        /** The number of fixed time steps simulated. */
+        unsigned int substeps;
+        /** The most fixed time steps the next step may simulate. */
+        unsigned int substepLimit;
+        /** The time in milliseconds that is carried into the next step. */
+        float timeDebt;
+        /** The average time in milliseconds taken to simulate a fixed time step. */
+        float substepCost;
+        /** The total simulation time in milliseconds that has been dropped. */
+        double droppedTime;
+        /** The number of steps that dropped simulation time. */
+        unsigned int droppedSteps;
+    };
+
+    /**
+     * Gets how the simulation time of the last step was spent, it is updated once the step is finished.
+     *
+     * @return The stats of the last step.
+     * @script{ignore}
+     */
+    const StepStats& getStepStats() const;
+
     /**
      * Gets the gravity vector for the simulated physics world.
      * 
@@ -420,6 +467,34 @@ private:
      */
     void update(float elapsedTime);
 
+    /**
+     * Starts stepping the simulation on the physics thread, used instead of update when rendering is pipelined.
+     *
+     * The world, the nodes of collision objects and anything changed by simulation updates must not be
+     * used until finishUpdate is called.
+     */
+    void startUpdate(float elapsedTime);
+
+    /**
+     * Waits for the step started by startUpdate and processes collisions on the calling thread.
+     */
+    void finishUpdate();
+
+    /**
+     * Steps the world, running the simulation updates of each fixed time step.
+     */
+    void step(float elapsedTime);
+
+    /**
+     * Notifies the status and collision listeners of the changes made by the last step.
+     */
+    void updateCollisionStatus();
+
+    /**
+     * Entry point of the physics thread.
+     */
+    void stepThreadProc();
+
     // Adds the given collision listener for the two given collision objects.
     void addCollisionListener(PhysicsCollisionObject::CollisionListener* listener, PhysicsCollisionObject* objectA, PhysicsCollisionObject* objectB);
 
@@ -534,6 +609,19 @@ private:
     std::map<PhysicsCollisionObject::CollisionPair, CollisionInfo> _collisionStatus;
     CollisionCallback* _collisionCallback;
     ActionInterface * _actionInterface;
+    std::unique_ptr<std::thread> _stepThread;
+    std::mutex _stepMutex;
+    std::condition_variable _stepStarted;
+    std::condition_variable _stepFinished;
+    float _stepElapsedTime;
+    bool _stepPending;
+    bool _stepThreadExit;
+    std::atomic<double> _stepThreadTime;
+    float _maxCatchUpTime;
+    float _stepBudget;
+    unsigned int _maxSubsteps;
+    StepStats _stepStats;
+    StepStats _finishedStepStats;
 };
 
 }
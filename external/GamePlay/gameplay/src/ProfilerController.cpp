@@ -11,18 +11,28 @@ namespace gameplay
         _enabled(true),
         _previousFrameStart(0),
         _currentCaptureStart(0),
-        _previousCaptureStart(0)
+        _previousCaptureStart(0),
+        _previousFrameAllocations(0),
+        _previousFrameAllocatedBytes(0),
+        _threadId(std::this_thread::get_id())
     {
         _durations.resize(_size, 0);
+        _allocations.resize(_size, 0);
+        _allocatedBytes.resize(_size, 0);
     }
 
     void ProfilerController::update()
     {
 #ifdef GP_USE_PROFILER
         const double currentFrameStart = Game::getAbsoluteTime();
+        unsigned int currentFrameAllocations;
+        unsigned long long currentFrameAllocatedBytes;
+        getThreadMemoryAllocations(&currentFrameAllocations, &currentFrameAllocatedBytes);
         if(_enabled)
         {
             _durations[_index] = currentFrameStart - _previousFrameStart;
+            _allocations[_index] = currentFrameAllocations - _previousFrameAllocations;
+            _allocatedBytes[_index] = currentFrameAllocatedBytes - _previousFrameAllocatedBytes;
             ++_index;
             _depth = -1;
             _hits = 0;
@@ -46,6 +56,8 @@ namespace gameplay
             }
         }
         _previousFrameStart = currentFrameStart;
+        _previousFrameAllocations = currentFrameAllocations;
+        _previousFrameAllocatedBytes = currentFrameAllocatedBytes;
 #endif
     }
 
@@ -74,6 +86,16 @@ namespace gameplay
         return _durations[frameIndex];
     }
 
+    unsigned int ProfilerController::getAllocations(unsigned int frameIndex) const
+    {
+        return _allocations[frameIndex];
+    }
+
+    unsigned long long ProfilerController::getAllocatedBytes(unsigned int frameIndex) const
+    {
+        return _allocatedBytes[frameIndex];
+    }
+
     void ProfilerController::getFrameEvents(unsigned int frameIndex, EventReader * reader)
     {
         GP_ASSERT(frameIndex >= 0 && frameIndex < _size);
@@ -94,6 +116,8 @@ namespace gameplay
                 event._maxTime = frame._maxTime;
                 event._hits = frame._hits;
                 event._depth = frame._depth;
+                event._allocations = frame._allocations;
+                event._allocatedBytes = frame._allocatedBytes;
                 reader->read(event);
             }
         }
@@ -101,8 +125,9 @@ namespace gameplay
 
     void ProfilerController::EventRecorderInternal::start(double start)
     {
+        // Only the thread that runs the frames is recorded, events on other threads would overlap its events
         ProfilerController * profiler = Game::getInstance()->getProfilerController();
-        if(profiler && profiler->_enabled)
+        if(profiler && profiler->_enabled && std::this_thread::get_id() == profiler->_threadId)
         {
             EventInternal & frame = _frames[_index];
             if (frame._firstCaptureStart == 0.0)
@@ -114,16 +139,18 @@ namespace gameplay
         }
     }
 
-    void ProfilerController::EventRecorderInternal::finish(double duration)
+    void ProfilerController::EventRecorderInternal::finish(double duration, unsigned int allocations, unsigned long long allocatedBytes)
     {
         ProfilerController * profiler = Game::getInstance()->getProfilerController();
-        if(profiler && profiler->_enabled)
+        if(profiler && profiler->_enabled && std::this_thread::get_id() == profiler->_threadId)
         {
             EventInternal & frame = _frames[_index];
             ++frame._hits;
             frame._totalTime += duration;
             frame._minTime = min(frame._minTime, duration);
             frame._maxTime = max(frame._maxTime, duration);
+            frame._allocations += allocations;
+            frame._allocatedBytes += allocatedBytes;
             frame._captureStart = profiler->_currentCaptureStart;
             frame._depth = profiler->_depth;
             --profiler->_depth;
@@ -147,10 +174,13 @@ namespace gameplay
         }
         _name += ':' + toString(line);
         ProfilerController * profiler = Game::getInstance()->getProfilerController();
-        _frames.resize(profiler->_size, EventInternal());
-        profiler->_counters.push_back(this);
-        profiler->_maxNameSize = std::max(profiler->_maxNameSize, static_cast<unsigned int>(_name.size()));
         _index = profiler->_index;
+        _frames.resize(profiler->_size, EventInternal());
+        if(std::this_thread::get_id() == profiler->_threadId)
+        {
+            profiler->_counters.push_back(this);
+            profiler->_maxNameSize = std::max(profiler->_maxNameSize, static_cast<unsigned int>(_name.size()));
+        }
     }
 
     void ProfilerController::EventRecorderInternal::next()
@@ -177,6 +207,8 @@ namespace gameplay
         _minTime = std::numeric_limits<double>::max();
         _totalTime = 0;
         _firstCaptureStart = 0;
+        _allocations = 0;
+        _allocatedBytes = 0;
     }
 
     ProfilerController::EventScopeInternal::EventScopeInternal(ProfilerController::EventRecorderInternal * counter) :
@@ -184,10 +216,15 @@ namespace gameplay
     {
         _startTime = Game::getAbsoluteTime();
         _counter->start(_startTime);
+        getThreadMemoryAllocations(&_startAllocations, &_startAllocatedBytes);
     }
 
     ProfilerController::EventScopeInternal::~EventScopeInternal()
     {
-        _counter->finish(Game::getAbsoluteTime() - _startTime);
+        // Includes the allocations of nested events, the same as the time
+        unsigned int allocations;
+        unsigned long long allocatedBytes;
+        getThreadMemoryAllocations(&allocations, &allocatedBytes);
+        _counter->finish(Game::getAbsoluteTime() - _startTime, allocations - _startAllocations, allocatedBytes - _startAllocatedBytes);
     }
 }
@@ -2,6 +2,7 @@
 #define PROFILERCONTROLLER_H_
 
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace gameplay
@@ -24,6 +25,8 @@ namespace gameplay
                 double _maxTime;
                 unsigned int _hits;
                 unsigned int _depth;
+                unsigned int _allocations;
+                unsigned long long _allocatedBytes;
             };
             virtual void read(const Event& event) = 0;
         };
@@ -38,6 +41,8 @@ namespace gameplay
             double _firstCaptureStart;
             unsigned int _hits;
             unsigned int _depth;
+            unsigned int _allocations;
+            unsigned long long _allocatedBytes;
             void reset();
         };
         struct EventRecorderInternal
@@ -46,7 +51,7 @@ namespace gameplay
             void reset();
             void next();
             void start(double start);
-            void finish(double duration);
+            void finish(double duration, unsigned int allocations, unsigned long long allocatedBytes);
             std::string _name;
             unsigned int _index;
             std::vector<EventInternal> _frames;
@@ -57,6 +62,8 @@ namespace gameplay
             ~EventScopeInternal();
             EventRecorderInternal * _counter;
             double _startTime;
+            unsigned int _startAllocations;
+            unsigned long long _startAllocatedBytes;
         };
 
         unsigned int getFrameIndex() const;
@@ -64,6 +71,8 @@ namespace gameplay
         bool isRecording() const;
         void setRecording(bool enabled);
         double getDuration(unsigned int frameIndex) const;
+        unsigned int getAllocations(unsigned int frameIndex) const;
+        unsigned long long getAllocatedBytes(unsigned int frameIndex) const;
         void getFrameEvents(unsigned int frameIndex, EventReader * reader);
     private:
         ProfilerController();
@@ -77,8 +86,13 @@ namespace gameplay
         double _previousFrameStart;
         double _previousCaptureStart;
         double _currentCaptureStart;
+        unsigned int _previousFrameAllocations;
+        unsigned long long _previousFrameAllocatedBytes;
         std::vector<EventRecorderInternal*> _counters;
         std::vector<double> _durations;
+        std::vector<unsigned int> _allocations;
+        std::vector<unsigned long long> _allocatedBytes;
+        std::thread::id _threadId;
     };
 }
 
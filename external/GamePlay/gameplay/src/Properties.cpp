@@ -25,6 +25,9 @@ void calculateNamespacePath(const std::string& urlString, std::string& fileStrin
 /** @script{ignore} */
 Properties* getPropertiesFromNamespacePath(Properties* properties, const std::vector<std::string>& namespacePath);
 
+/** @script{ignore} */
+static std::string __compiledPath;
+
 Properties::Properties()
     : _variables(NULL), _dirPath(NULL), _visited(false), _parent(NULL)
 {
@@ -80,16 +83,25 @@ Properties* Properties::create(const char* url)
     std::vector<std::string> namespacePath;
     calculateNamespacePath(urlString, fileString, namespacePath);
 
-    std::unique_ptr<Stream> stream(FileSystem::open(fileString.c_str()));
-    if (stream.get() == NULL)
+    // Prefer a compiled version of the file, falling back to parsing the text.
+    Properties* properties = NULL;
+    if (!__compiledPath.empty())
     {
-        GP_WARN("Failed to open file '%s'.", fileString.c_str());
-        return NULL;
+        std::string compiledString = __compiledPath + FileSystem::resolvePath(fileString.c_str());
+        if (FileSystem::fileExists(compiledString.c_str()))
+        {
+            properties = createFromCompiled(compiledString.c_str(), fileString.c_str());
+        }
     }
 
-    Properties* properties = new Properties(stream.get());
-    properties->resolveInheritance();
-    stream->close();
+    if (!properties)
+    {
+        properties = createFromText(fileString.c_str());
+        if (!properties)
+        {
+            return NULL;
+        }
+    }
 
     // Get the specified properties object.
     Properties* p = getPropertiesFromNamespacePath(properties, namespacePath);
@@ -112,6 +124,26 @@ Properties* Properties::create(const char* url)
     return p;
 }
 
+Properties* Properties::createFromText(const char* path)
+{
+    std::unique_ptr<Stream> stream(FileSystem::open(path));
+    if (stream.get() == NULL)
+    {
+        GP_WARN("Failed to open file '%s'.", path);
+        return NULL;
+    }
+
+    Properties* properties = new Properties(stream.get());
+    properties->resolveInheritance();
+    stream->close();
+    return properties;
+}
+
+void Properties::setCompiledPath(const char* path)
+{
+    __compiledPath = path == NULL ? "" : path;
+}
+
 static bool isVariable(const char* str, char* outName, size_t outSize)
 {
     size_t len = strlen(str);
@@ -682,12 +714,25 @@ static const bool isStringNumeric(const char* str)
 
 Properties::Type Properties::getType(const char* name) const
 {
-    const char* value = getString(name);
+    const Property* prop;
+    const char* value = findValue(name, &prop);
+    if (prop && prop->type != NONE)
+    {
+        return prop->type;
+    }
+
     if (!value)
     {
         return Properties::NONE;
     }
 
+    return getValueType(value);
+}
+
+Properties::Type Properties::getValueType(const char* value)
+{
+    GP_ASSERT(value);
+
     // Parse the value to determine the format
     unsigned int commaCount = 0;
     char* valuePtr = const_cast<char*>(value);
@@ -714,47 +759,53 @@ Properties::Type Properties::getType(const char* name) const
     }
 }
 
-const char* Properties::getString(const char* name, const char* defaultValue) const
+const char* Properties::findValue(const char* name, const Property** propOut) const
 {
+    GP_ASSERT(propOut);
+    *propOut = NULL;
     char variable[256];
-    const char* value = NULL;
 
     if (name)
     {
         // If 'name' is a variable, return the variable value
         if (isVariable(name, variable, 256))
         {
-            return getVariable(variable, defaultValue);
+            return getVariable(variable, NULL);
         }
 
         for (std::list<Property>::const_iterator itr = _properties.begin(); itr != _properties.end(); ++itr)
         {
             if (itr->name == name)
             {
-                value = itr->value.c_str();
+                *propOut = &(*itr);
                 break;
             }
         }
     }
-    else
+    else if (_propertiesItr != _properties.end())
     {
         // No name provided - get the value at the current iterator position
-        if (_propertiesItr != _properties.end())
-        {
-            value = _propertiesItr->value.c_str();
-        }
+        *propOut = &(*_propertiesItr);
     }
 
-    if (value)
+    if (!*propOut)
     {
-        // If the value references a variable, return the variable value
-        if (isVariable(value, variable, 256))
-            return getVariable(variable, defaultValue);
-
-        return value;
+        return NULL;
     }
 
-    return defaultValue;
+    // If the value references a variable, return the variable value
+    const char* value = (*propOut)->value.c_str();
+    if (isVariable(value, variable, 256))
+        return getVariable(variable, NULL);
+
+    return value;
+}
+
+const char* Properties::getString(const char* name, const char* defaultValue) const
+{
+    const Property* prop;
+    const char* value = findValue(name, &prop);
+    return value ? value : defaultValue;
 }
 
 bool Properties::setString(const char* name, const char* value)
@@ -767,6 +818,7 @@ bool Properties::setString(const char* name, const char* value)
             {
                 // Update the first property that matches this name
                 itr->value = value ? value : "";
+                itr->type = NONE;
                 return true;
             }
         }
@@ -781,6 +833,7 @@ bool Properties::setString(const char* name, const char* value)
             return false;
 
         _propertiesItr->value = value ? value : "";
+        _propertiesItr->type = NONE;
     }
 
     return true;
@@ -799,7 +852,14 @@ bool Properties::getBool(const char* name, bool defaultValue) const
 
 int Properties::getInt(const char* name) const
 {
-    const char* valueString = getString(name);
+    // Floats represent every integer exactly up to 2^24
+    const Property* prop;
+    const char* valueString = findValue(name, &prop);
+    if (prop && prop->type == NUMBER && fabs(prop->numbers[0]) < 16777216.0f)
+    {
+        return (int)prop->numbers[0];
+    }
+
     if (valueString)
     {
         int value;
@@ -818,7 +878,13 @@ int Properties::getInt(const char* name) const
 
 float Properties::getFloat(const char* name) const
 {
-    const char* valueString = getString(name);
+    const Property* prop;
+    const char* valueString = findValue(name, &prop);
+    if (prop && prop->type == NUMBER)
+    {
+        return prop->numbers[0];
+    }
+
     if (valueString)
     {
         float value;
@@ -884,17 +950,44 @@ bool Properties::getMatrix(const char* name, Matrix* out) const
 
 bool Properties::getVector2(const char* name, Vector2* out) const
 {
-    return parseVector2(getString(name), out);
+    const Property* prop;
+    const char* valueString = findValue(name, &prop);
+    if (prop && prop->type == VECTOR2)
+    {
+        if (out)
+            out->set(prop->numbers[0], prop->numbers[1]);
+        return true;
+    }
+
+    return parseVector2(valueString, out);
 }
 
 bool Properties::getVector3(const char* name, Vector3* out) const
 {
-    return parseVector3(getString(name), out);
+    const Property* prop;
+    const char* valueString = findValue(name, &prop);
+    if (prop && prop->type == VECTOR3)
+    {
+        if (out)
+            out->set(prop->numbers[0], prop->numbers[1], prop->numbers[2]);
+        return true;
+    }
+
+    return parseVector3(valueString, out);
 }
 
 bool Properties::getVector4(const char* name, Vector4* out) const
 {
-    return parseVector4(getString(name), out);
+    const Property* prop;
+    const char* valueString = findValue(name, &prop);
+    if (prop && prop->type == VECTOR4)
+    {
+        if (out)
+            out->set(prop->numbers[0], prop->numbers[1], prop->numbers[2], prop->numbers[3]);
+        return true;
+    }
+
+    return parseVector4(valueString, out);
 }
 
 bool Properties::getQuaternionFromAxisAngle(const char* name, Quaternion* out) const
@@ -1118,6 +1211,310 @@ Properties* getPropertiesFromNamespacePath(Properties* properties, const std::ve
         return properties;
 }
 
+// Compiled properties files are laid out as a header followed by the string offset table,
+// the namespace table (depth first, so a parent always precedes its children), the property
+// table, the variable table and finally the null terminated string data.
+#define PROPERTIES_COMPILED_SIGNATURE   "GPPC"
+#define PROPERTIES_COMPILED_VERSION     2
+
+/** @script{ignore} */
+struct CompiledHeader
+{
+    char signature[4];
+    unsigned int version;
+    unsigned long long sourceModifiedTime;
+    unsigned int stringCount;
+    unsigned int stringDataSize;
+    unsigned int namespaceCount;
+    unsigned int propertyCount;
+    unsigned int variableCount;
+};
+
+/** @script{ignore} */
+struct CompiledNamespace
+{
+    unsigned int name;
+    unsigned int id;
+    unsigned int parentID;
+    int parent;
+    unsigned int firstProperty;
+    unsigned int propertyCount;
+    unsigned int firstVariable;
+    unsigned int variableCount;
+};
+
+/** @script{ignore} */
+struct CompiledProperty
+{
+    unsigned int name;
+    unsigned int value;
+    unsigned int type;
+    float numbers[4];
+};
+
+/** @script{ignore} */
+struct Properties::Compiler
+{
+    std::map<std::string, unsigned int> stringIndices;
+    std::vector<const std::string*> strings;
+    std::vector<unsigned int> stringOffsets;
+    unsigned int stringDataSize;
+    std::vector<CompiledNamespace> namespaces;
+    std::vector<CompiledProperty> properties;
+    std::vector<CompiledProperty> variables;
+
+    Compiler() : stringDataSize(0) { }
+
+    unsigned int addString(const std::string& str)
+    {
+        std::pair<std::map<std::string, unsigned int>::iterator, bool> result =
+            stringIndices.insert(std::make_pair(str, (unsigned int)strings.size()));
+        if (result.second)
+        {
+            strings.push_back(&result.first->first);
+            stringOffsets.push_back(stringDataSize);
+            stringDataSize += str.size() + 1;
+        }
+        return result.first->second;
+    }
+
+    CompiledProperty addProperty(const Property& prop, bool parseValue)
+    {
+        CompiledProperty compiled;
+        compiled.name = addString(prop.name);
+        compiled.value = addString(prop.value);
+        compiled.type = NONE;
+        memset(compiled.numbers, 0, sizeof(compiled.numbers));
+
+        // Values that reference variables can only be resolved at runtime.
+        char variable[256];
+        const char* value = prop.value.c_str();
+        if (parseValue && !isVariable(value, variable, 256))
+        {
+            Type type = getValueType(value);
+            float* n = compiled.numbers;
+            switch (type)
+            {
+            case NUMBER:
+                compiled.type = sscanf(value, "%f", &n[0]) == 1 ? type : NONE;
+                break;
+            case VECTOR2:
+                compiled.type = sscanf(value, "%f,%f", &n[0], &n[1]) == 2 ? type : NONE;
+                break;
+            case VECTOR3:
+                compiled.type = sscanf(value, "%f,%f,%f", &n[0], &n[1], &n[2]) == 3 ? type : NONE;
+                break;
+            case VECTOR4:
+                compiled.type = sscanf(value, "%f,%f,%f,%f", &n[0], &n[1], &n[2], &n[3]) == 4 ? type : NONE;
+                break;
+            default:
+                compiled.type = type;
+                break;
+            }
+        }
+        return compiled;
+    }
+
+    void addNamespace(const Properties* ns, int parent)
+    {
+        CompiledNamespace compiled;
+        compiled.name = addString(ns->_namespace);
+        compiled.id = addString(ns->_id);
+        compiled.parentID = addString(ns->_parentID);
+        compiled.parent = parent;
+        compiled.firstProperty = properties.size();
+        compiled.propertyCount = ns->_properties.size();
+        compiled.firstVariable = variables.size();
+        compiled.variableCount = ns->_variables ? ns->_variables->size() : 0;
+
+        for (std::list<Property>::const_iterator itr = ns->_properties.begin(); itr != ns->_properties.end(); ++itr)
+        {
+            properties.push_back(addProperty(*itr, true));
+        }
+
+        for (unsigned int i = 0; i < compiled.variableCount; ++i)
+        {
+            variables.push_back(addProperty((*ns->_variables)[i], false));
+        }
+
+        int const index = namespaces.size();
+        namespaces.push_back(compiled);
+
+        for (size_t i = 0, count = ns->_namespaces.size(); i < count; ++i)
+        {
+            addNamespace(ns->_namespaces[i], index);
+        }
+    }
+
+    bool write(Stream* stream, unsigned long long sourceModifiedTime) const
+    {
+        CompiledHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.signature, PROPERTIES_COMPILED_SIGNATURE, sizeof(header.signature));
+        header.version = PROPERTIES_COMPILED_VERSION;
+        header.sourceModifiedTime = sourceModifiedTime;
+        header.stringCount = strings.size();
+        header.stringDataSize = stringDataSize;
+        header.namespaceCount = namespaces.size();
+        header.propertyCount = properties.size();
+        header.variableCount = variables.size();
+
+        if (stream->write(&header, sizeof(header), 1) != 1 ||
+            stream->write(stringOffsets.data(), sizeof(unsigned int), stringOffsets.size()) != stringOffsets.size() ||
+            stream->write(namespaces.data(), sizeof(CompiledNamespace), namespaces.size()) != namespaces.size() ||
+            stream->write(properties.data(), sizeof(CompiledProperty), properties.size()) != properties.size() ||
+            stream->write(variables.data(), sizeof(CompiledProperty), variables.size()) != variables.size())
+        {
+            return false;
+        }
+
+        for (size_t i = 0, count = strings.size(); i < count; ++i)
+        {
+            if (stream->write(strings[i]->c_str(), 1, strings[i]->size() + 1) != strings[i]->size() + 1)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+bool Properties::compile(const char* path, const char* outputPath)
+{
+    GP_ASSERT(path);
+    GP_ASSERT(outputPath);
+
+    Properties* properties = createFromText(path);
+    if (!properties)
+    {
+        return false;
+    }
+
+    Compiler compiler;
+    compiler.addNamespace(properties, -1);
+    SAFE_DELETE(properties);
+
+    std::unique_ptr<Stream> stream(FileSystem::open(outputPath, FileSystem::WRITE));
+    if (stream.get() == NULL)
+    {
+        GP_WARN("Failed to open file '%s' for writing.", outputPath);
+        return false;
+    }
+
+    if (!compiler.write(stream.get(), FileSystem::getModifiedTime(path)))
+    {
+        GP_WARN("Failed to write compiled properties file '%s'.", outputPath);
+        return false;
+    }
+
+    stream->close();
+    return true;
+}
+
+Properties* Properties::createFromCompiled(const char* path, const char* sourcePath)
+{
+    int size = 0;
+    std::unique_ptr<char[]> data(FileSystem::readAll(path, &size));
+    if (data.get() == NULL || size < (int)sizeof(CompiledHeader))
+    {
+        GP_WARN("Failed to read compiled properties file '%s'.", path);
+        return NULL;
+    }
+
+    const CompiledHeader* header = reinterpret_cast<const CompiledHeader*>(data.get());
+    if (memcmp(header->signature, PROPERTIES_COMPILED_SIGNATURE, sizeof(header->signature)) != 0 ||
+        header->version != PROPERTIES_COMPILED_VERSION)
+    {
+        GP_WARN("Invalid header for compiled properties file '%s'.", path);
+        return NULL;
+    }
+
+    // A source that has been edited since it was compiled is loaded instead, sources without a modification time
+    // (in a pack or the Android assets) are shipped with their compiled files so those are trusted
+    const unsigned long long sourceModifiedTime = FileSystem::getModifiedTime(sourcePath);
+    if (sourceModifiedTime != 0 && sourceModifiedTime != header->sourceModifiedTime)
+    {
+        GP_WARN("Compiled properties file '%s' is out of date, loading '%s' instead.", path, sourcePath);
+        return NULL;
+    }
+
+    const unsigned int* stringOffsets = reinterpret_cast<const unsigned int*>(header + 1);
+    const CompiledNamespace* namespaces = reinterpret_cast<const CompiledNamespace*>(stringOffsets + header->stringCount);
+    const CompiledProperty* properties = reinterpret_cast<const CompiledProperty*>(namespaces + header->namespaceCount);
+    const CompiledProperty* variables = properties + header->propertyCount;
+    const char* stringData = reinterpret_cast<const char*>(variables + header->variableCount);
+
+    if (header->namespaceCount == 0 || stringData + header->stringDataSize > data.get() + size)
+    {
+        GP_WARN("Truncated compiled properties file '%s'.", path);
+        return NULL;
+    }
+
+    struct StringTable
+    {
+        const unsigned int* offsets;
+        const char* data;
+        unsigned int count;
+        unsigned int dataSize;
+
+        const char* get(unsigned int index) const
+        {
+            return index < count && offsets[index] < dataSize ? data + offsets[index] : "";
+        }
+    } const strings = { stringOffsets, stringData, header->stringCount, header->stringDataSize };
+
+    std::vector<Properties*> created(header->namespaceCount, NULL);
+    for (unsigned int i = 0; i < header->namespaceCount; ++i)
+    {
+        const CompiledNamespace& compiled = namespaces[i];
+        if ((i == 0) != (compiled.parent < 0) || compiled.parent >= (int)i ||
+            compiled.firstProperty + compiled.propertyCount > header->propertyCount ||
+            compiled.firstVariable + compiled.variableCount > header->variableCount)
+        {
+            GP_WARN("Corrupt namespace table in compiled properties file '%s'.", path);
+            SAFE_DELETE(created[0]);
+            return NULL;
+        }
+
+        Properties* ns = new Properties();
+        ns->_namespace = strings.get(compiled.name);
+        ns->_id = strings.get(compiled.id);
+        ns->_parentID = strings.get(compiled.parentID);
+
+        for (unsigned int j = compiled.firstProperty; j < compiled.firstProperty + compiled.propertyCount; ++j)
+        {
+            ns->_properties.push_back(Property(strings.get(properties[j].name), strings.get(properties[j].value)));
+            Property& prop = ns->_properties.back();
+            prop.type = properties[j].type <= MATRIX ? static_cast<Type>(properties[j].type) : NONE;
+            memcpy(prop.numbers, properties[j].numbers, sizeof(prop.numbers));
+        }
+
+        if (compiled.variableCount > 0)
+        {
+            ns->_variables = new std::vector<Property>();
+            for (unsigned int j = compiled.firstVariable; j < compiled.firstVariable + compiled.variableCount; ++j)
+            {
+                ns->_variables->push_back(Property(strings.get(variables[j].name), strings.get(variables[j].value)));
+            }
+        }
+
+        if (compiled.parent >= 0)
+        {
+            ns->_parent = created[compiled.parent];
+            ns->_parent->_namespaces.push_back(ns);
+        }
+        created[i] = ns;
+    }
+
+    for (size_t i = 0, count = created.size(); i < count; ++i)
+    {
+        created[i]->rewind();
+    }
+
+    return created[0];
+}
+
 bool Properties::parseVector2(const char* str, Vector2* out)
 {
     if (str)
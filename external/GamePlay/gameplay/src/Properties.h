@@ -155,6 +155,29 @@ public:
      */
     static Properties* create(const char* url);
 
+    /**
+     * Parses the properties file at the specified path and writes it out in the compiled binary
+     * format, with inheritance resolved and numeric and vector values pre-parsed.
+     *
+     * Compiled files are picked up by create() when a compiled path has been set, see setCompiledPath().
+     *
+     * @param path The path of the text properties file to compile.
+     * @param outputPath The path to write the compiled properties file to.
+     *
+     * @return True if the file was compiled and written successfully, false otherwise.
+     */
+    static bool compile(const char* path, const char* outputPath);
+
+    /**
+     * Sets the directory that create() will search for compiled properties files in before
+     * falling back to parsing the text file, e.g. a path of "res/compiled/" will cause
+     * "res/gameobjects/player.go" to be loaded from "res/compiled/res/gameobjects/player.go".
+     * A compiled file is skipped if its text file has been modified since it was compiled.
+     *
+     * @param path The compiled properties directory, or NULL/empty to only load text files.
+     */
+    static void setCompiledPath(const char* path);
+
     /**
      * Destructor.
      */
@@ -515,7 +538,10 @@ private:
     {
         std::string name;
         std::string value;
-        Property(const char* name, const char* value) : name(name), value(value) { }
+        // Pre-parsed value when loaded from a compiled file, NONE when only the string is known.
+        Type type;
+        float numbers[4];
+        Property(const char* name, const char* value) : name(name), value(value), type(NONE) { }
     };
 
     /**
@@ -540,6 +566,16 @@ private:
 
     void readProperties(Stream* stream);
 
+    static Properties* createFromText(const char* path);
+
+    static Properties* createFromCompiled(const char* path, const char* sourcePath);
+
+    const char* findValue(const char* name, const Property** propOut) const;
+
+    static Type getValueType(const char* value);
+
+    struct Compiler;
+
     void setDirectoryPath(const std::string* path);
 
     void setDirectoryPath(const std::string& path);
@@ -106,6 +106,7 @@ void Slider::setValue(float value)
     if (value != _value)
     {
         _value = value;
+        markForRedraw();
         notifyListeners(Control::Listener::VALUE_CHANGED);
     }
 
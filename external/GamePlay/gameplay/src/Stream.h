@@ -155,6 +155,16 @@ public:
      */
     virtual bool rewind() = 0;
 
+    /**
+     * Returns a pointer to the contents of the stream if they are resident in memory.
+     *
+     * Memory backed streams, such as the ones opened with FileSystem::MAPPED, expose their
+     * bytes directly so that callers can consume them without copying.
+     *
+     * @return The contents of the stream, or NULL if the stream is not memory backed.
+     */
+    virtual const void* getData() { return NULL; }
+
 protected:
     Stream() {};
 private:
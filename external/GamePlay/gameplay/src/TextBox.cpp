@@ -68,6 +68,7 @@ void TextBox::setCaretLocation(unsigned int index)
     _caretLocation = index;
     if (_caretLocation > _text.length())
         _caretLocation = (unsigned int)_text.length();
+    markForRedraw();
 }
 
 bool TextBox::touchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
@@ -139,6 +140,9 @@ static unsigned int findNextWord(const std::string& text, unsigned int from, boo
 
 bool TextBox::keyEvent(Keyboard::KeyEvent evt, int key)
 {
+    // Any key may move the caret or edit the text
+    markForRedraw();
+
     switch (evt)
     {
         case Keyboard::KEY_PRESS:
@@ -407,6 +411,8 @@ void TextBox::setText(char const *text)
 
 void TextBox::setCaretLocation(int x, int y)
 {
+    markForRedraw();
+
     Control::State state = getState();
 
     Vector2 point(x + _absoluteBounds.x, y + _absoluteBounds.y);
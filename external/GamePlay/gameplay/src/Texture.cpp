@@ -1,6 +1,7 @@
 #include "Base.h"
 #include "Image.h"
 #include "Texture.h"
+#include "GLStateCache.h"
 #include "FileSystem.h"
 
 // PVRTC (GL_IMG_texture_compression_pvrtc) : Imagination based gpus
@@ -48,8 +49,81 @@ namespace gameplay
 {
 
 static std::vector<Texture*> __textureCache;
-static TextureHandle __currentTextureId = 0;
-static Texture::Type __currentTextureType = Texture::TEXTURE_2D;
+static std::string __compiledPath;
+
+// KTX 1.1 file structures (https://www.khronos.org/opengles/sdk/tools/KTX/file_format_spec/).
+static const unsigned char KTX_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+static const unsigned int KTX_ENDIANNESS = 0x04030201;
+static const char KTX_SAMPLER_KEY[] = "gameplay.sampler";
+static const char KTX_SOURCE_MODIFIED_TIME_KEY[] = "gameplay.sourceModifiedTime";
+
+struct ktx_header
+{
+    unsigned char identifier[12];
+    unsigned int endianness;
+    unsigned int glType;
+    unsigned int glTypeSize;
+    unsigned int glFormat;
+    unsigned int glInternalFormat;
+    unsigned int glBaseInternalFormat;
+    unsigned int pixelWidth;
+    unsigned int pixelHeight;
+    unsigned int pixelDepth;
+    unsigned int numberOfArrayElements;
+    unsigned int numberOfFaces;
+    unsigned int numberOfMipmapLevels;
+    unsigned int bytesOfKeyValueData;
+};
+
+// Value of the KTX_SAMPLER_KEY key/value pair.
+struct ktx_sampler
+{
+    unsigned int minFilter;
+    unsigned int magFilter;
+    unsigned int wrapS;
+    unsigned int wrapT;
+};
+
+// Reads the modification time of the source image that a compiled texture was created from, 0 if it wasn't recorded.
+static unsigned long long readKTXSourceModifiedTime(const char* path)
+{
+    std::unique_ptr<Stream> stream(FileSystem::open(path));
+    ktx_header header;
+    if (stream.get() == NULL || stream->read(&header, sizeof(ktx_header), 1) != 1 ||
+        memcmp(header.identifier, KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER)) != 0 || header.bytesOfKeyValueData > 4096)
+    {
+        return 0;
+    }
+
+    std::vector<unsigned char> keyValueData(header.bytesOfKeyValueData);
+    if (keyValueData.empty() || stream->read(&keyValueData[0], 1, keyValueData.size()) != keyValueData.size())
+    {
+        return 0;
+    }
+
+    size_t offset = 0;
+    while (offset + sizeof(unsigned int) <= keyValueData.size())
+    {
+        unsigned int keyAndValueByteSize;
+        memcpy(&keyAndValueByteSize, &keyValueData[offset], sizeof(unsigned int));
+        offset += sizeof(unsigned int);
+
+        if (keyAndValueByteSize > keyValueData.size() - offset)
+            break;
+
+        const char* key = (const char*)&keyValueData[offset];
+        if (keyAndValueByteSize == sizeof(KTX_SOURCE_MODIFIED_TIME_KEY) + sizeof(unsigned long long) && strcmp(key, KTX_SOURCE_MODIFIED_TIME_KEY) == 0)
+        {
+            unsigned long long sourceModifiedTime;
+            memcpy(&sourceModifiedTime, key + sizeof(KTX_SOURCE_MODIFIED_TIME_KEY), sizeof(unsigned long long));
+            return sourceModifiedTime;
+        }
+
+        offset += (keyAndValueByteSize + 3) & ~3;
+    }
+
+    return 0;
+}
 
 Texture::Texture() : _handle(0), _format(UNKNOWN), _type((Texture::Type)0), _width(0), _height(0), _mipmapped(false), _cached(false), _compressed(false),
     _wrapS(Texture::REPEAT), _wrapT(Texture::REPEAT), _wrapR(Texture::REPEAT), _minFilter(Texture::NEAREST_MIPMAP_LINEAR), _magFilter(Texture::LINEAR)
@@ -60,7 +134,7 @@ Texture::~Texture()
 {
     if (_handle)
     {
-        GL_ASSERT( glDeleteTextures(1, &_handle) );
+        GLStateCache::deleteTexture(_handle);
         _handle = 0;
     }
 
@@ -75,11 +149,8 @@ Texture::~Texture()
     }
 }
 
-Texture* Texture::create(const char* path, bool generateMipmaps)
+Texture* Texture::findCached(const char* path, bool generateMipmaps)
 {
-    GP_ASSERT( path );
-
-    // Search texture cache first.
     for (size_t i = 0, count = __textureCache.size(); i < count; ++i)
     {
         Texture* t = __textureCache[i];
@@ -100,16 +171,52 @@ Texture* Texture::create(const char* path, bool generateMipmaps)
         }
     }
 
+    return NULL;
+}
+
+void Texture::addToCache(Texture* texture, const char* path)
+{
+    texture->_path = path;
+    texture->_cached = true;
+    __textureCache.push_back(texture);
+}
+
+Texture* Texture::create(const char* path, bool generateMipmaps)
+{
+    GP_ASSERT( path );
+
+    // Search texture cache first.
+    if (Texture* cached = findCached(path, generateMipmaps))
+    {
+        return cached;
+    }
+
     Texture* texture = NULL;
 
+    // Compiled textures are uploaded as they are, without decoding the source image.
+    std::string compiledPath = getCompiledFilePath(path);
+    if (!compiledPath.empty())
+    {
+        texture = createKTX(compiledPath.c_str());
+        if (texture && generateMipmaps && !texture->_compressed)
+            texture->generateMipmaps();
+    }
+
     // Filter loading based on file extension.
     const char* ext = strrchr(FileSystem::resolvePath(path), '.');
-    if (ext)
+    if (ext && !texture)
     {
         switch (strlen(ext))
         {
         case 4:
-            if (tolower(ext[1]) == 'p' && tolower(ext[2]) == 'n' && tolower(ext[3]) == 'g')
+            if (tolower(ext[1]) == 'k' && tolower(ext[2]) == 't' && tolower(ext[3]) == 'x')
+            {
+                // KTX texture container, uncompressed or compressed.
+                texture = createKTX(path);
+                if (texture && generateMipmaps && !texture->_compressed)
+                    texture->generateMipmaps();
+            }
+            else if (tolower(ext[1]) == 'p' && tolower(ext[2]) == 'n' && tolower(ext[3]) == 'g')
             {
                 Image* image = Image::create(path);
                 if (image)
@@ -132,12 +239,8 @@ Texture* Texture::create(const char* path, bool generateMipmaps)
 
     if (texture)
     {
-        texture->_path = path;
-        texture->_cached = true;
-
         // Add to texture cache.
-        __textureCache.push_back(texture);
-
+        addToCache(texture, path);
         return texture;
     }
 
@@ -145,6 +248,24 @@ Texture* Texture::create(const char* path, bool generateMipmaps)
     return NULL;
 }
 
+Texture* Texture::create(const char* path, Image* image, bool generateMipmaps)
+{
+    GP_ASSERT( path );
+    GP_ASSERT( image );
+
+    if (Texture* cached = findCached(path, generateMipmaps))
+    {
+        return cached;
+    }
+
+    Texture* texture = create(image, generateMipmaps);
+    if (texture)
+    {
+        addToCache(texture, path);
+    }
+    return texture;
+}
+
 Texture* Texture::create(Image* image, bool generateMipmaps)
 {
     GP_ASSERT( image );
@@ -244,7 +365,7 @@ Texture* Texture::create(Format format, unsigned int width, unsigned int height,
     // Create the texture.
     GLuint textureId;
     GL_ASSERT( glGenTextures(1, &textureId) );
-    GL_ASSERT( glBindTexture(target, textureId) );
+    GLStateCache::bindTexture(target, textureId);
     GL_ASSERT( glPixelStorei(GL_UNPACK_ALIGNMENT, 1) );
 #ifndef OPENGL_ES
     // glGenerateMipmap is new in OpenGL 3.0. For OpenGL 2.0 we must fallback to use glTexParameteri
@@ -266,7 +387,7 @@ Texture* Texture::create(Format format, unsigned int width, unsigned int height,
         unsigned int textureSize = width * height;
         if (bpp == 0)
         {
-            glDeleteTextures(1, &textureId);
+            GLStateCache::deleteTexture(textureId);
             GP_ERROR("Failed to determine texture size because format is UNKNOWN.");
             return NULL;
         }
@@ -311,10 +432,6 @@ Texture* Texture::create(Format format, unsigned int width, unsigned int height,
     if (generateMipmaps)
         texture->generateMipmaps();
 
-
-    // Restore the texture id
-    GL_ASSERT( glBindTexture((GLenum)__currentTextureType, __currentTextureId) );
-
     return texture;
 }
 
@@ -327,6 +444,7 @@ Texture* Texture::create(TextureHandle handle, int width, int height, Format for
     {
         // There is no real way to query for texture type, but an error will be returned if a cube texture is bound to a 2D texture... so check for that
         glBindTexture(GL_TEXTURE_CUBE_MAP, handle);
+        GLStateCache::invalidate();
         if (glGetError() == GL_NO_ERROR)
         {
             texture->_type = TEXTURE_CUBE;
@@ -336,9 +454,6 @@ Texture* Texture::create(TextureHandle handle, int width, int height, Format for
             // For now, it's either or. But if 3D textures and others are added, it might be useful to simply test a bunch of bindings and seeing which one doesn't error out
             texture->_type = TEXTURE_2D;
         }
-
-        // Restore the texture id
-        GL_ASSERT( glBindTexture((GLenum)__currentTextureType, __currentTextureId) );
     }
     texture->_handle = handle;
     texture->_format = format;
@@ -358,7 +473,7 @@ void Texture::setData(const unsigned char* data)
     GP_ASSERT( (!_compressed) );
     GP_ASSERT( (!_cached) );
 
-    GL_ASSERT( glBindTexture((GLenum)_type, _handle) );
+    GLStateCache::bindTexture((GLenum)_type, _handle);
 
     if (_type == Texture::TEXTURE_2D)
     {
@@ -380,9 +495,6 @@ void Texture::setData(const unsigned char* data)
     {
         generateMipmaps();
     }
-
-    // Restore the texture id
-    GL_ASSERT( glBindTexture((GLenum)__currentTextureType, __currentTextureId) );
 }
 
 // Computes the size of a PVRTC data chunk for a mipmap level of the given size.
@@ -465,7 +577,7 @@ Texture* Texture::createCompressedPVRTC(const char* path)
     GLenum target = faceCount > 1 ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D;
     GLuint textureId;
     GL_ASSERT( glGenTextures(1, &textureId) );
-    GL_ASSERT( glBindTexture(target, textureId) );
+    GLStateCache::bindTexture(target, textureId);
 
     Filter minFilter = mipMapCount > 1 ? NEAREST_MIPMAP_LINEAR : LINEAR;
     GL_ASSERT( glTexParameteri(target, GL_TEXTURE_MIN_FILTER, minFilter) );
@@ -499,9 +611,6 @@ Texture* Texture::createCompressedPVRTC(const char* path)
     // Free data.
     SAFE_DELETE_ARRAY(data);
 
-    // Restore the texture id
-    GL_ASSERT( glBindTexture((GLenum)__currentTextureType, __currentTextureId) );
-
     return texture;
 }
 
@@ -1107,7 +1216,7 @@ Texture* Texture::createCompressedDDS(const char* path)
     // Generate GL texture.
     GLuint textureId;
     GL_ASSERT( glGenTextures(1, &textureId) );
-    GL_ASSERT( glBindTexture(target, textureId) );
+    GLStateCache::bindTexture(target, textureId);
 
     Filter minFilter = header.dwMipMapCount > 1 ? NEAREST_MIPMAP_LINEAR : LINEAR;
     GL_ASSERT( glTexParameteri(target, GL_TEXTURE_MIN_FILTER, minFilter ) );
@@ -1146,12 +1255,360 @@ Texture* Texture::createCompressedDDS(const char* path)
     // Clean up mip levels structure.
     SAFE_DELETE_ARRAY(mipLevels);
 
-    // Restore the texture id
-    GL_ASSERT( glBindTexture((GLenum)__currentTextureType, __currentTextureId) );
+    return texture;
+}
+
+Texture* Texture::createKTX(const char* path)
+{
+    GP_ASSERT( path );
+
+    // Map the file so levels are uploaded straight from the file contents.
+    std::unique_ptr<Stream> stream(FileSystem::open(path, FileSystem::READ | FileSystem::MAPPED));
+    if (stream.get() == NULL || !stream->canRead())
+    {
+        GP_ERROR("Failed to open file '%s'.", path);
+        return NULL;
+    }
+
+    size_t length = stream->length();
+    const unsigned char* data = (const unsigned char*)stream->getData();
+    std::vector<unsigned char> buffer;
+    if (data == NULL)
+    {
+        // The file could not be mapped, read it into memory instead.
+        buffer.resize(length);
+        if (length == 0 || stream->read(&buffer[0], 1, length) != length)
+        {
+            GP_ERROR("Failed to read KTX file '%s'.", path);
+            return NULL;
+        }
+        data = &buffer[0];
+    }
+
+    // Read and validate the KTX header.
+    ktx_header header;
+    if (length < sizeof(ktx_header))
+    {
+        GP_ERROR("Failed to read header for KTX file '%s'.", path);
+        return NULL;
+    }
+    memcpy(&header, data, sizeof(ktx_header));
+
+    if (memcmp(header.identifier, KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER)) != 0)
+    {
+        GP_ERROR("Failed to read KTX file '%s': invalid KTX identifier.", path);
+        return NULL;
+    }
+
+    if (header.endianness != KTX_ENDIANNESS)
+    {
+        GP_ERROR("Failed to read KTX file '%s': big endian files are unsupported.", path);
+        return NULL;
+    }
+
+    if (header.pixelWidth == 0 || header.pixelHeight == 0 || header.pixelDepth > 1 || header.numberOfArrayElements > 0 ||
+        (header.numberOfFaces != 1 && header.numberOfFaces != 6))
+    {
+        GP_ERROR("Failed to create texture from KTX file '%s': only 2D and cube textures are supported.", path);
+        return NULL;
+    }
+
+    size_t offset = sizeof(ktx_header);
+    if (header.bytesOfKeyValueData > length - offset)
+    {
+        GP_ERROR("Failed to read key/value data for KTX file '%s'.", path);
+        return NULL;
+    }
+
+    const bool compressed = header.glType == 0;
+    const unsigned int mipMapCount = std::max(1u, header.numberOfMipmapLevels);
+
+    // Sampler state defaults to the one a texture created from an image would have.
+    ktx_sampler sampler;
+    sampler.minFilter = mipMapCount > 1 ? NEAREST_MIPMAP_LINEAR : LINEAR;
+    sampler.magFilter = LINEAR;
+    sampler.wrapS = REPEAT;
+    sampler.wrapT = REPEAT;
+
+    const size_t keyValueEnd = offset + header.bytesOfKeyValueData;
+    while (offset + sizeof(unsigned int) <= keyValueEnd)
+    {
+        unsigned int keyAndValueByteSize;
+        memcpy(&keyAndValueByteSize, data + offset, sizeof(unsigned int));
+        offset += sizeof(unsigned int);
+
+        if (keyAndValueByteSize > keyValueEnd - offset)
+            break;
+
+        const char* key = (const char*)data + offset;
+        if (keyAndValueByteSize == sizeof(KTX_SAMPLER_KEY) + sizeof(ktx_sampler) && strcmp(key, KTX_SAMPLER_KEY) == 0)
+        {
+            memcpy(&sampler, key + sizeof(KTX_SAMPLER_KEY), sizeof(ktx_sampler));
+        }
+
+        offset += (keyAndValueByteSize + 3) & ~3;
+    }
+    offset = keyValueEnd;
+
+    // Generate GL texture.
+    GLenum target = header.numberOfFaces == 6 ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D;
+    GLuint textureId;
+    GL_ASSERT( glGenTextures(1, &textureId) );
+    GLStateCache::bindTexture(target, textureId);
+
+    // Rows of uncompressed levels are 4 byte aligned.
+    GL_ASSERT( glPixelStorei(GL_UNPACK_ALIGNMENT, 4) );
+
+    GLsizei width = header.pixelWidth;
+    GLsizei height = header.pixelHeight;
+    bool valid = true;
+    for (unsigned int i = 0; i < mipMapCount && valid; ++i)
+    {
+        unsigned int imageSize = 0;
+        valid = offset + sizeof(unsigned int) <= length;
+        if (valid)
+        {
+            memcpy(&imageSize, data + offset, sizeof(unsigned int));
+            offset += sizeof(unsigned int);
+        }
+
+        for (unsigned int face = 0; face < header.numberOfFaces && valid; ++face)
+        {
+            valid = imageSize <= length - offset;
+            if (!valid)
+                break;
+
+            GLenum texImageTarget = header.numberOfFaces == 6 ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + face : GL_TEXTURE_2D;
+            if (compressed)
+            {
+                GL_ASSERT( glCompressedTexImage2D(texImageTarget, i, header.glInternalFormat, width, height, 0, imageSize, data + offset) );
+            }
+            else
+            {
+                // The unsized base format is used since sized internal formats are not available in OpenGL ES 2.
+                GL_ASSERT( glTexImage2D(texImageTarget, i, header.glBaseInternalFormat, width, height, 0, header.glFormat, header.glType, data + offset) );
+            }
+
+            offset += (imageSize + 3) & ~3;
+        }
+
+        width = std::max(1, width >> 1);
+        height = std::max(1, height >> 1);
+    }
+
+    GL_ASSERT( glPixelStorei(GL_UNPACK_ALIGNMENT, 1) );
+
+    if (!valid)
+    {
+        GP_ERROR("Failed to read texture data for KTX file '%s'.", path);
+        GLStateCache::deleteTexture(textureId);
+        return NULL;
+    }
+
+    GL_ASSERT( glTexParameteri(target, GL_TEXTURE_MIN_FILTER, sampler.minFilter) );
+    GL_ASSERT( glTexParameteri(target, GL_TEXTURE_MAG_FILTER, sampler.magFilter) );
+    GL_ASSERT( glTexParameteri(target, GL_TEXTURE_WRAP_S, sampler.wrapS) );
+    GL_ASSERT( glTexParameteri(target, GL_TEXTURE_WRAP_T, sampler.wrapT) );
+
+    Format format = UNKNOWN;
+    if (!compressed && header.glType == GL_UNSIGNED_BYTE)
+    {
+        if (header.glFormat == GL_RGBA)
+            format = RGBA;
+        else if (header.glFormat == GL_RGB)
+            format = RGB;
+        else if (header.glFormat == GL_ALPHA)
+            format = ALPHA;
+    }
+
+    // Create gameplay texture.
+    Texture* texture = new Texture();
+    texture->_handle = textureId;
+    texture->_format = format;
+    texture->_type = (Type)target;
+    texture->_width = header.pixelWidth;
+    texture->_height = header.pixelHeight;
+    texture->_compressed = compressed;
+    texture->_mipmapped = mipMapCount > 1;
+    texture->_minFilter = (Filter)sampler.minFilter;
+    texture->_magFilter = (Filter)sampler.magFilter;
+    texture->_wrapS = (Wrap)sampler.wrapS;
+    texture->_wrapT = (Wrap)sampler.wrapT;
+    texture->_internalFormat = header.glBaseInternalFormat;
+    texture->_texelType = header.glType;
+    texture->_bpp = format == UNKNOWN ? 0 : getFormatBPP(format);
 
     return texture;
 }
 
+bool Texture::compile(const char* path, const char* outputPath, bool generateMipmaps)
+{
+    GP_ASSERT( path );
+    GP_ASSERT( outputPath );
+
+    Image* image = Image::create(path);
+    if (!image)
+    {
+        return false;
+    }
+
+    const unsigned int components = image->getFormat() == Image::RGBA ? 4 : 3;
+    unsigned int width = image->getWidth();
+    unsigned int height = image->getHeight();
+
+    // Level 0 is the source image, the rest of the chain is box filtered from the previous level.
+    std::vector<std::vector<unsigned char> > levels(1);
+    levels[0].assign(image->getData(), image->getData() + width * height * components);
+    SAFE_RELEASE(image);
+
+    unsigned int levelWidth = width;
+    unsigned int levelHeight = height;
+    while (generateMipmaps && (levelWidth > 1 || levelHeight > 1))
+    {
+        const unsigned int sourceWidth = levelWidth;
+        const unsigned int sourceHeight = levelHeight;
+        levelWidth = std::max(1u, levelWidth >> 1);
+        levelHeight = std::max(1u, levelHeight >> 1);
+
+        const std::vector<unsigned char>& source = levels.back();
+        std::vector<unsigned char> level(levelWidth * levelHeight * components);
+        for (unsigned int y = 0; y < levelHeight; ++y)
+        {
+            const unsigned int y0 = std::min(y * 2, sourceHeight - 1) * sourceWidth;
+            const unsigned int y1 = std::min(y * 2 + 1, sourceHeight - 1) * sourceWidth;
+            for (unsigned int x = 0; x < levelWidth; ++x)
+            {
+                const unsigned int x0 = std::min(x * 2, sourceWidth - 1);
+                const unsigned int x1 = std::min(x * 2 + 1, sourceWidth - 1);
+                for (unsigned int c = 0; c < components; ++c)
+                {
+                    unsigned int sum = source[(y0 + x0) * components + c] + source[(y0 + x1) * components + c] +
+                        source[(y1 + x0) * components + c] + source[(y1 + x1) * components + c];
+                    level[(y * levelWidth + x) * components + c] = (unsigned char)((sum + 2) / 4);
+                }
+            }
+        }
+        levels.push_back(level);
+    }
+
+    ktx_header header;
+    memcpy(header.identifier, KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER));
+    header.endianness = KTX_ENDIANNESS;
+    header.glType = GL_UNSIGNED_BYTE;
+    header.glTypeSize = 1;
+    header.glFormat = components == 4 ? GL_RGBA : GL_RGB;
+    header.glInternalFormat = header.glFormat;
+    header.glBaseInternalFormat = header.glFormat;
+    header.pixelWidth = width;
+    header.pixelHeight = height;
+    header.pixelDepth = 0;
+    header.numberOfArrayElements = 0;
+    header.numberOfFaces = 1;
+    header.numberOfMipmapLevels = (unsigned int)levels.size();
+
+    // Store the sampler state create() would have given the texture.
+    ktx_sampler sampler;
+    sampler.minFilter = levels.size() > 1 ? NEAREST_MIPMAP_LINEAR : LINEAR;
+    sampler.magFilter = LINEAR;
+    sampler.wrapS = REPEAT;
+    sampler.wrapT = REPEAT;
+    const unsigned int keyAndValueByteSize = sizeof(KTX_SAMPLER_KEY) + sizeof(ktx_sampler);
+
+    // Store the modification time of the source image so an edited image is loaded instead, see getCompiledFilePath().
+    const unsigned long long sourceModifiedTime = FileSystem::getModifiedTime(path);
+    const unsigned int sourceKeyAndValueByteSize = sizeof(KTX_SOURCE_MODIFIED_TIME_KEY) + sizeof(unsigned long long);
+    header.bytesOfKeyValueData = sizeof(unsigned int) + ((keyAndValueByteSize + 3) & ~3) +
+        sizeof(unsigned int) + ((sourceKeyAndValueByteSize + 3) & ~3);
+
+    std::vector<unsigned char> buffer((const unsigned char*)&header, (const unsigned char*)&header + sizeof(ktx_header));
+    buffer.insert(buffer.end(), (const unsigned char*)&keyAndValueByteSize, (const unsigned char*)&keyAndValueByteSize + sizeof(unsigned int));
+    buffer.insert(buffer.end(), KTX_SAMPLER_KEY, KTX_SAMPLER_KEY + sizeof(KTX_SAMPLER_KEY));
+    buffer.insert(buffer.end(), (const unsigned char*)&sampler, (const unsigned char*)&sampler + sizeof(ktx_sampler));
+    buffer.resize(sizeof(ktx_header) + sizeof(unsigned int) + ((keyAndValueByteSize + 3) & ~3), 0);
+    buffer.insert(buffer.end(), (const unsigned char*)&sourceKeyAndValueByteSize, (const unsigned char*)&sourceKeyAndValueByteSize + sizeof(unsigned int));
+    buffer.insert(buffer.end(), KTX_SOURCE_MODIFIED_TIME_KEY, KTX_SOURCE_MODIFIED_TIME_KEY + sizeof(KTX_SOURCE_MODIFIED_TIME_KEY));
+    buffer.insert(buffer.end(), (const unsigned char*)&sourceModifiedTime, (const unsigned char*)&sourceModifiedTime + sizeof(unsigned long long));
+    buffer.resize(sizeof(ktx_header) + header.bytesOfKeyValueData, 0);
+
+    levelWidth = width;
+    levelHeight = height;
+    for (size_t i = 0; i < levels.size(); ++i)
+    {
+        // Rows are padded to 4 bytes, which also keeps the image size 4 byte aligned.
+        const unsigned int rowSize = levelWidth * components;
+        const unsigned int paddedRowSize = (rowSize + 3) & ~3;
+        const unsigned int imageSize = paddedRowSize * levelHeight;
+        buffer.insert(buffer.end(), (const unsigned char*)&imageSize, (const unsigned char*)&imageSize + sizeof(unsigned int));
+        for (unsigned int y = 0; y < levelHeight; ++y)
+        {
+            buffer.insert(buffer.end(), levels[i].begin() + y * rowSize, levels[i].begin() + (y + 1) * rowSize);
+            buffer.resize(buffer.size() + paddedRowSize - rowSize, 0);
+        }
+
+        levelWidth = std::max(1u, levelWidth >> 1);
+        levelHeight = std::max(1u, levelHeight >> 1);
+    }
+
+    std::unique_ptr<Stream> stream(FileSystem::open(outputPath, FileSystem::WRITE));
+    if (stream.get() == NULL)
+    {
+        GP_WARN("Failed to open file '%s' for writing.", outputPath);
+        return false;
+    }
+
+    if (stream->write(&buffer[0], 1, buffer.size()) != buffer.size())
+    {
+        GP_WARN("Failed to write compiled texture file '%s'.", outputPath);
+        return false;
+    }
+
+    stream->close();
+    return true;
+}
+
+void Texture::setCompiledPath(const char* path)
+{
+    __compiledPath = path == NULL ? "" : path;
+}
+
+bool Texture::isCompiled(const char* path)
+{
+    GP_ASSERT( path );
+    return !getCompiledFilePath(path).empty();
+}
+
+std::string Texture::getCompiledFilePath(const char* path)
+{
+    if (__compiledPath.empty())
+    {
+        return "";
+    }
+
+    // Compiled textures keep the source path with a .ktx extension.
+    std::string compiledPath = FileSystem::resolvePath(path);
+    size_t extension = compiledPath.find_last_of("./");
+    if (extension != std::string::npos && compiledPath[extension] == '.')
+    {
+        compiledPath.erase(extension);
+    }
+    compiledPath = __compiledPath + compiledPath + ".ktx";
+
+    if (!FileSystem::fileExists(compiledPath.c_str()))
+    {
+        return "";
+    }
+
+    // A source image that has been edited since it was compiled is decoded instead, sources without a modification
+    // time (in a pack or the Android assets) are shipped with their compiled textures so those are trusted.
+    const unsigned long long sourceModifiedTime = FileSystem::getModifiedTime(path);
+    if (sourceModifiedTime != 0 && sourceModifiedTime != readKTXSourceModifiedTime(compiledPath.c_str()))
+    {
+        return "";
+    }
+
+    return compiledPath;
+}
+
 Texture::Format Texture::getFormat() const
 {
     return _format;
@@ -1187,15 +1644,12 @@ void Texture::generateMipmaps()
     if (!_mipmapped)
     {
         GLenum target = (GLenum)_type;
-        GL_ASSERT( glBindTexture(target, _handle) );
+        GLStateCache::bindTexture(target, _handle);
         GL_ASSERT( glHint(GL_GENERATE_MIPMAP_HINT, GL_NICEST) );
         if( std::addressof(glGenerateMipmap) )
             GL_ASSERT( glGenerateMipmap(target) );
 
         _mipmapped = true;
-
-        // Restore the texture id
-        GL_ASSERT( glBindTexture((GLenum)__currentTextureType, __currentTextureId) );
     }
 }
 
@@ -1259,12 +1713,7 @@ void Texture::Sampler::bind()
     GP_ASSERT( _texture );
 
     GLenum target = (GLenum)_texture->_type;
-    if (__currentTextureId != _texture->_handle)
-    {
-        GL_ASSERT( glBindTexture(target, _texture->_handle) );
-        __currentTextureId = _texture->_handle;
-        __currentTextureType = _texture->_type;
-    }
+    GLStateCache::bindTexture(target, _texture->_handle);
 
     if (_texture->_minFilter != _minFilter)
     {
@@ -174,6 +174,9 @@ public:
      * Note that for textures that include mipmap data in the source data (such as most compressed textures),
      * the generateMipmaps flags should NOT be set to true.
      *
+     * If a compiled texture exists for the path (see setCompiledPath()) it is uploaded directly from
+     * the compiled file instead of decoding the image.
+     *
      * @param path The image resource path.
      * @param generateMipmaps true to auto-generate a full mipmap chain, false otherwise.
      * 
@@ -193,6 +196,21 @@ public:
      */
     static Texture* create(Image* image, bool generateMipmaps = false);
 
+    /**
+     * Creates a texture from an image that has already been loaded from the given path and
+     * adds it to the texture cache, so subsequent calls to create(path) return the same texture.
+     *
+     * This allows image files to be decoded away from the thread owning the GL context.
+     *
+     * @param path The image resource path the image was loaded from.
+     * @param image The image containing the texture data.
+     * @param generateMipmaps True to generate a full mipmap chain, false otherwise.
+     *
+     * @return The new (or already cached) texture, or NULL if the image is not of a supported texture format.
+     * @script{ignore}
+     */
+    static Texture* create(const char* path, Image* image, bool generateMipmaps = false);
+
     /**
      * Creates a texture from the given texture data.
      *
@@ -232,6 +250,39 @@ public:
      */
     static Texture* create(TextureHandle handle, int width, int height, Format format = UNKNOWN);
 
+    /**
+     * Decodes the image at the specified path and writes it out as a KTX texture container,
+     * holding the pixel data ready for upload, its mipmap chain and its sampler state.
+     *
+     * Compiled textures are picked up by create(path) when a compiled path has been set, see setCompiledPath().
+     *
+     * @param path The path of the image to compile.
+     * @param outputPath The path to write the KTX file to.
+     * @param generateMipmaps True to generate and store a full mipmap chain, false otherwise.
+     *
+     * @return True if the texture was compiled and written successfully, false otherwise.
+     */
+    static bool compile(const char* path, const char* outputPath, bool generateMipmaps = false);
+
+    /**
+     * Sets the directory that create(path) will search for compiled textures in before falling back
+     * to decoding the image, e.g. a path of "res/compiled/" will cause "res/textures/player.png" to be
+     * loaded from "res/compiled/res/textures/player.ktx". A compiled texture is skipped if its source
+     * image has been modified since it was compiled.
+     *
+     * @param path The compiled textures directory, or NULL/empty to only load source images.
+     */
+    static void setCompiledPath(const char* path);
+
+    /**
+     * Determines whether create(path) will load the texture at the given path from a compiled texture.
+     *
+     * @param path The image resource path.
+     *
+     * @return True if a compiled texture exists for the path, false otherwise.
+     */
+    static bool isCompiled(const char* path);
+
     /**
      * Set texture data to replace current texture image.
      * 
@@ -307,6 +358,10 @@ private:
      */
     Texture();
 
+    static Texture* findCached(const char* path, bool generateMipmaps);
+
+    static void addToCache(Texture* texture, const char* path);
+
     /**
      * Copy constructor.
      */
@@ -326,6 +381,10 @@ private:
 
     static Texture* createCompressedDDS(const char* path);
 
+    static Texture* createKTX(const char* path);
+
+    static std::string getCompiledFilePath(const char* path);
+
     static GLubyte* readCompressedPVRTC(const char* path, Stream* stream, GLsizei* width, GLsizei* height, GLenum* format, unsigned int* mipMapCount, unsigned int* faceCount, GLenum faces[6]);
 
     static GLubyte* readCompressedPVRTCLegacy(const char* path, Stream* stream, GLsizei* width, GLsizei* height, GLenum* format, unsigned int* mipMapCount, unsigned int* faceCount, GLenum faces[6]);
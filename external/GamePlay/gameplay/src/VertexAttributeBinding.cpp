@@ -2,6 +2,7 @@
 #include "VertexAttributeBinding.h"
 #include "Mesh.h"
 #include "Effect.h"
+#include "GLStateCache.h"
 
 namespace gameplay
 {
@@ -29,7 +30,7 @@ VertexAttributeBinding::~VertexAttributeBinding()
 
     if (_handle)
     {
-        GL_ASSERT( glDeleteVertexArrays(1, &_handle) );
+        GLStateCache::deleteVertexArray(_handle);
         _handle = 0;
     }
 }
@@ -92,8 +93,8 @@ VertexAttributeBinding* VertexAttributeBinding::create(Mesh* mesh, const VertexF
 #ifdef GP_USE_VAO
     if (mesh && glGenVertexArrays)
     {
-        GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, 0) );
-        GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
+        GLStateCache::bindBuffer(GL_ARRAY_BUFFER, 0);
+        GLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
         // Use hardware VAOs.
         GL_ASSERT( glGenVertexArrays(1, &b->_handle) );
@@ -106,10 +107,10 @@ VertexAttributeBinding* VertexAttributeBinding::create(Mesh* mesh, const VertexF
         }
 
         // Bind the new VAO.
-        GL_ASSERT( glBindVertexArray(b->_handle) );
+        GLStateCache::bindVertexArray(b->_handle);
 
         // Bind the Mesh VBO so our glVertexAttribPointer calls use it.
-        GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, mesh->getVertexBuffer()) );
+        GLStateCache::bindBuffer(GL_ARRAY_BUFFER, mesh->getVertexBuffer());
     }
     else
 #endif
@@ -206,7 +207,7 @@ VertexAttributeBinding* VertexAttributeBinding::create(Mesh* mesh, const VertexF
 
     if (b->_handle)
     {
-        GL_ASSERT( glBindVertexArray(0) );
+        GLStateCache::bindVertexArray(0);
     }
 
     return b;
@@ -220,7 +221,7 @@ void VertexAttributeBinding::setVertexAttribPointer(GLuint indx, GLint size, GLe
     {
         // Hardware mode.
         GL_ASSERT( glVertexAttribPointer(indx, size, type, normalize, stride, pointer) );
-        GL_ASSERT( glEnableVertexAttribArray(indx) );
+        GLStateCache::setVertexAttribArrayEnabled(indx, true);
     }
     else
     {
@@ -240,18 +241,18 @@ void VertexAttributeBinding::bind()
     if (_handle)
     {
         // Hardware mode
-        GL_ASSERT( glBindVertexArray(_handle) );
+        GLStateCache::bindVertexArray(_handle);
     }
     else
     {
         // Software mode
         if (_mesh)
         {
-            GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, _mesh->getVertexBuffer()) );
+            GLStateCache::bindBuffer(GL_ARRAY_BUFFER, _mesh->getVertexBuffer());
         }
         else
         {
-            GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, 0) );
+            GLStateCache::bindBuffer(GL_ARRAY_BUFFER, 0);
         }
 
         GP_ASSERT(_attributes);
@@ -261,7 +262,7 @@ void VertexAttributeBinding::bind()
             if (a.enabled)
             {
                 GL_ASSERT( glVertexAttribPointer(i, a.size, a.type, a.normalized, a.stride, a.pointer) );
-                GL_ASSERT( glEnableVertexAttribArray(i) );
+                GLStateCache::setVertexAttribArrayEnabled(i, true);
             }
         }
     }
@@ -272,14 +273,14 @@ void VertexAttributeBinding::unbind()
     if (_handle)
     {
         // Hardware mode
-        GL_ASSERT( glBindVertexArray(0) );
+        GLStateCache::bindVertexArray(0);
     }
     else
     {
         // Software mode
         if (_mesh)
         {
-            GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, 0) );
+            GLStateCache::bindBuffer(GL_ARRAY_BUFFER, 0);
         }
 
         GP_ASSERT(_attributes);
@@ -287,7 +288,7 @@ void VertexAttributeBinding::unbind()
         {
             if (_attributes[i].enabled)
             {
-                GL_ASSERT( glDisableVertexAttribArray(i) );
+                GLStateCache::setVertexAttribArrayEnabled(i, false);
             }
         }
     }
@@ -0,0 +1,12 @@
+// Autogenerated by gameplay-luagen
+#ifndef LUA_AUDIOSOURCE_H_
+#define LUA_AUDIOSOURCE_H_
+
+namespace gameplay
+{
+
+void luaRegister_AudioSource();
+
+}
+
+#endif
@@ -90,6 +90,53 @@ static int lua_FileSystem_static_createFileFromAsset(lua_State* state)
     return 0;
 }
 
+static int lua_FileSystem_static_createPack(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            do
+            {
+                if ((lua_type(state, 1) == LUA_TSTRING || lua_type(state, 1) == LUA_TNIL) &&
+                    (lua_type(state, 2) == LUA_TUSERDATA || lua_type(state, 2) == LUA_TTABLE || lua_type(state, 2) == LUA_TNIL))
+                {
+                    // Get parameter 1 off the stack.
+                    const char* param1 = gameplay::ScriptUtil::getString(1, false);
+
+                    // Get parameter 2 off the stack.
+                    bool param2Valid;
+                    gameplay::ScriptUtil::LuaArray<Properties> param2 = gameplay::ScriptUtil::getObjectPointer<Properties>(2, "Properties", false, &param2Valid);
+                    if (!param2Valid)
+                        break;
+
+                    bool result = FileSystem::createPack(param1, param2);
+
+                    // Push the return value onto the stack.
+                    lua_pushboolean(state, result);
+
+                    return 1;
+                }
+            } while (0);
+
+            lua_pushstring(state, "lua_FileSystem_static_createPack - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 static int lua_FileSystem_static_fileExists(lua_State* state)
 {
     // Get the number of parameters.
@@ -521,6 +568,7 @@ void luaRegister_FileSystem()
     const luaL_Reg lua_statics[] = 
     {
         {"createFileFromAsset", lua_FileSystem_static_createFileFromAsset},
+        {"createPack", lua_FileSystem_static_createPack},
         {"fileExists", lua_FileSystem_static_fileExists},
         {"getAssetPath", lua_FileSystem_static_getAssetPath},
         {"getDirectoryName", lua_FileSystem_static_getDirectoryName},
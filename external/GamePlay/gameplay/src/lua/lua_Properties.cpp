@@ -1241,6 +1241,47 @@ static int lua_Properties_setVariable(lua_State* state)
     return 0;
 }
 
+static int lua_Properties_static_compile(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TSTRING || lua_type(state, 1) == LUA_TNIL) &&
+                (lua_type(state, 2) == LUA_TSTRING || lua_type(state, 2) == LUA_TNIL))
+            {
+                // Get parameter 1 off the stack.
+                const char* param1 = gameplay::ScriptUtil::getString(1, false);
+
+                // Get parameter 2 off the stack.
+                const char* param2 = gameplay::ScriptUtil::getString(2, false);
+
+                bool result = Properties::compile(param1, param2);
+
+                // Push the return value onto the stack.
+                lua_pushboolean(state, result);
+
+                return 1;
+            }
+
+            lua_pushstring(state, "lua_Properties_static_compile - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 static int lua_Properties_static_create(lua_State* state)
 {
     // Get the number of parameters.
@@ -1574,6 +1615,7 @@ void luaRegister_Properties()
     };
     const luaL_Reg lua_statics[] = 
     {
+        {"compile", lua_Properties_static_compile},
         {"create", lua_Properties_static_create},
         {"parseAxisAngle", lua_Properties_static_parseAxisAngle},
         {"parseColor", lua_Properties_static_parseColor},
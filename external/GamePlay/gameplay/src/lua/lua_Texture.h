@@ -0,0 +1,12 @@
+// Autogenerated by gameplay-luagen
+#ifndef LUA_TEXTURE_H_
+#define LUA_TEXTURE_H_
+
+namespace gameplay
+{
+
+void luaRegister_Texture();
+
+}
+
+#endif
@@ -232,8 +232,11 @@ int writeFont(const char* inFilePath, const char* outFilePath, std::vector<unsig
         // Include padding in the rowSize.
         rowSize += GLYPH_PADDING;
 
+        // Distance field glyphs keep a margin on either side within the padding.
+        int margin = (fontFormat == Font::DISTANCE_FIELD) ? DISTANCE_FIELD_MARGIN : 0;
+
         // Initialize with padding.
-        int penX = 0;
+        int penX = margin;
         int penY = 0;
         int row = 0;
 
@@ -249,7 +252,7 @@ int writeFont(const char* inFilePath, const char* outFilePath, std::vector<unsig
         {
             imageWidth =  (unsigned int)pow(2.0, powerOf2);
             imageHeight = (unsigned int)pow(2.0, powerOf2);
-            penX = 0;
+            penX = margin;
             penY = 0;
             row = 0;
 
@@ -272,7 +275,7 @@ int writeFont(const char* inFilePath, const char* outFilePath, std::vector<unsig
                 // If we reach the end of the image wrap aroud to the next row.
                 if ((penX + advance) > (int)imageWidth)
                 {
-                    penX = 0;
+                    penX = margin;
                     row += 1;
                     penY = row * rowSize;
                     if (penY + rowSize > (int)imageHeight)
@@ -316,7 +319,7 @@ int writeFont(const char* inFilePath, const char* outFilePath, std::vector<unsig
         // Allocate temporary image buffer to draw the glyphs into.
         unsigned char* imageBuffer = (unsigned char*)malloc(imageWidth * imageHeight);
         memset(imageBuffer, 0, imageWidth * imageHeight);
-        penX = 1;
+        penX = 1 + margin;
         penY = 0;
         row = 0;
         i = 0;
@@ -339,7 +342,7 @@ int writeFont(const char* inFilePath, const char* outFilePath, std::vector<unsig
             // If we reach the end of the image wrap aroud to the next row.
             if ((penX + advance) > (int)imageWidth)
             {
-                penX = 1;
+                penX = 1 + margin;
                 row += 1;
                 penY = row * rowSize;
                 if (penY + rowSize > (int)imageHeight)
@@ -360,14 +363,14 @@ int writeFont(const char* inFilePath, const char* outFilePath, std::vector<unsig
             penY = row * rowSize;
 
             glyphArray[i].index = ascii;
-            glyphArray[i].width = advance - GLYPH_PADDING;
-            glyphArray[i].bearingX = slot->metrics.horiBearingX >> 6;
+            glyphArray[i].width = advance - GLYPH_PADDING + margin * 2;
+            glyphArray[i].bearingX = (slot->metrics.horiBearingX >> 6) - margin;
             glyphArray[i].advance = slot->metrics.horiAdvance >> 6;
 
             // Generate UV coords.
-            glyphArray[i].uvCoords[0] = (float)penX / (float)imageWidth;
+            glyphArray[i].uvCoords[0] = (float)(penX - margin) / (float)imageWidth;
             glyphArray[i].uvCoords[1] = (float)penY / (float)imageHeight;
-            glyphArray[i].uvCoords[2] = (float)(penX + advance - GLYPH_PADDING) / (float)imageWidth;
+            glyphArray[i].uvCoords[2] = (float)(penX + advance - GLYPH_PADDING + margin) / (float)imageWidth;
             glyphArray[i].uvCoords[3] = (float)(penY + rowSize - GLYPH_PADDING) / (float)imageHeight;
 
             // Set the pen position for the next glyph
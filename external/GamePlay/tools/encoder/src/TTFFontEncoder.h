@@ -6,6 +6,9 @@
 #define END_INDEX       127
 #define GLYPH_PADDING   4
 
+// Distance field glyphs are drawn this far beyond their bitmap so the edge falloff isn't cut off when scaled up
+#define DISTANCE_FIELD_MARGIN   (GLYPH_PADDING / 2)
+
 namespace tools
 {
 
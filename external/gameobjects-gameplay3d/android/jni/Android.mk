@@ -7,6 +7,7 @@ LOCAL_SRC_FILES := \
     Component.cpp \
     GameObject.cpp \
     GameObjectController.cpp \
+    GameObjectMessage.cpp \
     GameObjectMessageFactory.cpp
 
 LOCAL_CFLAGS := -D__ANDROID__ -DGP_SCENE_VISIT_EXTENSIONS -I "../../../external/GamePlay/gameplay/src" -I"../../GamePlay/external-deps/include"
@@ -17,9 +17,11 @@ namespace gameobjects
      * components at various level of the GameObject hierarchy. Ideally, any inter-dependency between components should be
      * kept to a minimum and should avoid being bi-directional.
      *
+     * Components are allocated from the current gameplay::Arena, so those of a level can share its lifetime.
+     *
      * @script{ignore}
     */
-    class Component : public gameplay::Ref
+    class Component : public gameplay::Ref, public gameplay::ArenaObject
     {
         friend class GameObject;
         friend class GameObjectController;
@@ -51,6 +53,14 @@ namespace gameobjects
          */
         virtual void readProperties(gameplay::Properties & properties) {}
 
+        /**
+         * Copy what readProperties read from a prototype, a component of the same type which was read from the same
+         * declaration. Return false if this isn't supported, readProperties will then be invoked for every instance.
+         *
+         * This will be invoked instead of readProperties and before initialize
+         */
+        virtual bool copyProperties(Component const & prototype) { return false; }
+
         /**
          * Run any initialization here that depends on serialized properties but not on
          * other sibling components.
@@ -33,6 +33,8 @@ namespace gameobjects
             }
         }
 
+        detachComponents();
+
         for (auto & componentPair : _components)
         {
             for (Component * component : componentPair.second)
@@ -113,6 +115,76 @@ namespace gameobjects
         return _node;
     }
 
+    void GameObject::attachComponent(Component * component)
+    {
+        _components[component->_typeId].push_back(component);
+
+        if (GameObject * parent = getParent())
+        {
+            addToIndex(parent->_childComponents, component);
+
+            // Stops at the first node that isn't a game object, like searching down the children does
+            for (; parent; parent = parent->getParent())
+            {
+                addToIndex(parent->_componentsInChildren, component);
+            }
+        }
+    }
+
+    void GameObject::detachComponents()
+    {
+        if (GameObject * parent = getParent())
+        {
+            for (auto & componentPair : _components)
+            {
+                for (Component * component : componentPair.second)
+                {
+                    removeFromIndex(parent->_childComponents, component);
+
+                    for (GameObject * ancestor = parent; ancestor; ancestor = ancestor->getParent())
+                    {
+                        removeFromIndex(ancestor->_componentsInChildren, component);
+                    }
+                }
+            }
+        }
+    }
+
+    void GameObject::addToIndex(ComponentIndex & index, Component * component)
+    {
+        index[component->_typeId].push_back(component);
+    }
+
+    void GameObject::removeFromIndex(ComponentIndex & index, Component * component)
+    {
+        auto componentsItr = index.find(component->_typeId);
+        GAMEOBJECT_ASSERT(componentsItr != index.end(), "Component '%s' isn't indexed", component->_id.c_str());
+
+        if (componentsItr != index.end())
+        {
+            // Game objects tend to be destroyed in the order they were created so the search is usually short
+            std::vector<Component*> & components = componentsItr->second;
+            auto componentItr = std::find(components.begin(), components.end(), component);
+            GAMEOBJECT_ASSERT(componentItr != components.end(), "Component '%s' isn't indexed", component->_id.c_str());
+
+            if (componentItr != components.end())
+            {
+                components.erase(componentItr);
+
+                if (components.empty())
+                {
+                    index.erase(componentsItr);
+                }
+            }
+        }
+    }
+
+    std::vector<Component*> const * GameObject::findInIndex(ComponentIndex const & index, std::type_index const & typeId)
+    {
+        auto componentsItr = index.find(typeId);
+        return componentsItr != index.end() ? &componentsItr->second : nullptr;
+    }
+
     std::type_index const & GameObject::getComponentTypeId(Component * component)
     {
         return component->_typeId;
@@ -31,6 +31,9 @@ namespace gameobjects
      * child = example_gameobjectA
      * child = example_gameobjectB
      * child = example_gameobjectC
+     *
+     * Each game object indexes the components of the game objects below it by type, so searching its children for a type
+     * doesn't visit the game objects below it. Game objects can't be moved to another parent once they have been created.
      */
     class GameObject : public INodeUserData
     {
@@ -88,10 +91,20 @@ namespace gameobjects
         void finalize();
         void forEachComponent(std::function <bool(Component *)> func);
         void forEachComponent(std::function <bool(Component *)> func) const;
+        typedef std::unordered_map<std::type_index, std::vector<Component*>> ComponentIndex;
+
+        void attachComponent(Component * component);
+        void detachComponents();
+        static void addToIndex(ComponentIndex & index, Component * component);
+        static void removeFromIndex(ComponentIndex & index, Component * component);
+        static std::vector<Component*> const * findInIndex(ComponentIndex const & index, std::type_index const & typeId);
         static std::type_index const & getComponentTypeId(Component * component);
         static std::string const & getComponentId(Component * component);
 
         std::map<std::type_index, std::vector<Component*>> _components;
+        // The components of the child game objects, and of all of the game objects below this one, in the order they were attached
+        ComponentIndex _childComponents;
+        ComponentIndex _componentsInChildren;
         gameplay::Node * _node;
     };
 }
@@ -38,16 +38,11 @@ namespace gameobjects
 
         if (!component)
         {
-            gameplay::Node * childNode = _node->getFirstChild();
-
-            while (component == nullptr && childNode != nullptr)
+            // Game objects below this one are in the order they were attached, which is depth first for those created
+            // from files but puts game objects added to an existing child later after the children that follow it
+            if (std::vector<Component*> const * components = findInIndex(_componentsInChildren, typeid(ComponentType)))
             {
-                if (GameObject * childGameObject = getGameObject(childNode))
-                {
-                    component = childGameObject->getComponentInChildren<ComponentType>();
-                }
-
-                childNode = childNode->getNextSibling();
+                component = static_cast<ComponentType*>(components->front());
             }
         }
 
@@ -59,16 +54,12 @@ namespace gameobjects
     {
         getComponents<ComponentType>(componentsOut);
 
-        gameplay::Node * childNode = _node->getFirstChild();
-
-        while (childNode != nullptr)
+        if (std::vector<Component*> const * components = findInIndex(_childComponents, typeid(ComponentType)))
         {
-            if (GameObject * childGameObject = getGameObject(childNode))
+            for (Component * component : *components)
             {
-                childGameObject->getComponents<ComponentType>(componentsOut);
+                componentsOut.push_back(static_cast<ComponentType*>(component));
             }
-
-            childNode = childNode->getNextSibling();
         }
     }
 
@@ -76,17 +67,19 @@ namespace gameobjects
     ComponentType * GameObject::findComponent(std::string const & id)
     {
         ComponentType * componentToFind = nullptr;
+        auto componentItr = _components.find(typeid(ComponentType));
 
-        forEachComponent([&id, &componentToFind](Component * component) -> bool
+        if (componentItr != _components.end())
         {
-            if (getComponentId(component) == id)
+            for (Component * component : componentItr->second)
             {
-                componentToFind = static_cast<ComponentType*>(component);
-                return true;
+                if (getComponentId(component) == id)
+                {
+                    componentToFind = static_cast<ComponentType*>(component);
+                    break;
+                }
             }
-
-            return false;
-        });
+        }
 
         return componentToFind;
     }
@@ -98,7 +91,7 @@ namespace gameobjects
         component->_id = id;
         component->_typeId = typeid(ComponentType);
         component->_parent = this;
-        _components[component->_typeId].push_back(component);
+        attachComponent(component);
         component->initialize();
         component->onStart();
         return component;
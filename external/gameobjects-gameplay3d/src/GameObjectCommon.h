@@ -20,9 +20,11 @@ namespace gameobjects
     /**
      * You must use this interface to define a unique type id you intend to attach gameplay::Ref user objects to nodes
      *
+     * Like the nodes they're attached to, they're allocated from the current gameplay::Arena.
+     *
      * @script{ignore}
     */
-    class INodeUserData : public gameplay::Ref
+    class INodeUserData : public gameplay::Ref, public gameplay::ArenaObject
     {
     public:
         virtual int getNodeUserDataId() const = 0;
@@ -15,6 +15,8 @@ namespace gameobjects
 {
     #define GAMEOBJECT_CALLBACK_SCOPE ScopedGameObjectCallback scopedGameObjectCallback;
 
+    static thread_local GameObjectController * currentController = nullptr;
+
     GameObjectController::GameObjectController()
         : _gameObjectTypeDir("res/gameobjects")
         , _scene(nullptr)
@@ -29,10 +31,32 @@ namespace gameobjects
 
     GameObjectController & GameObjectController::getInstance()
     {
+        if (currentController)
+        {
+            return *currentController;
+        }
+
         static GameObjectController instance;
         return instance;
     }
 
+    GameObjectController * GameObjectController::create()
+    {
+        return new GameObjectController();
+    }
+
+    void GameObjectController::destroy(GameObjectController ** controller)
+    {
+        GAMEOBJECT_ASSERT(*controller != currentController, "A GameObjectController can't be destroyed while it is current");
+        (*controller)->finalize();
+        SAFE_DELETE(*controller);
+    }
+
+    void GameObjectController::setCurrent(GameObjectController * controller)
+    {
+        currentController = controller;
+    }
+
     void GameObjectController::initialize()
     {
         PROFILE();
@@ -68,6 +92,9 @@ namespace gameobjects
 
             gameObjectDef->rewind();
 
+            // Anonymous components are named after the number of component types before them in the game object
+            std::set<std::type_index> componentTypesFound;
+
             while (gameplay::Properties * componentDef = gameObjectDef->getNextNamespace())
             {
                 bool componentTypeFound = false;
@@ -76,13 +103,25 @@ namespace gameobjects
                 {
                     if (componentTypePair.second._name == componentDef->getNamespace())
                     {
-                        gameObjectTypeInfo._components.push_back(std::make_pair(componentTypePair.first, componentDef));
+                        std::string id = componentDef->getId();
+
+                        if (id.empty())
+                        {
+                            char buffer[UCHAR_MAX];
+                            sprintf(buffer, "annon_%d", static_cast<int>(componentTypesFound.size()));
+                            id = buffer;
+                        }
+
+                        ComponentDefinition componentDefinition = { componentTypePair.first, &componentTypePair.second, componentDef, id, nullptr, false };
+                        gameObjectTypeInfo._components.push_back(componentDefinition);
+                        componentTypesFound.insert(componentTypePair.first);
                         componentTypeFound = true;
                         break;
                     }
                 }
 
-                GAMEOBJECT_ASSERT(componentTypeFound, "Unknown component type '%s'", componentDef->getNamespace());
+                GAMEOBJECT_ASSERT(componentTypeFound || _ignoredComponentTypes.find(componentDef->getNamespace()) != _ignoredComponentTypes.end(),
+                    "Unknown component type '%s'", componentDef->getNamespace());
             }
 
             gameObjectTypeInfo._definition = gameObjectDef;
@@ -105,6 +144,12 @@ namespace gameobjects
             for (auto & gameObjectTypePair : _gameObjectTypes)
             {
                 GameObjectTypeInfo & gameObjectTypeInfo = gameObjectTypePair.second;
+
+                for (ComponentDefinition & componentDef : gameObjectTypeInfo._components)
+                {
+                    SAFE_RELEASE(componentDef._prototype);
+                }
+
                 if(!_callbackHandler)
                 {
                     SAFE_DELETE(gameObjectTypeInfo._definition);
@@ -114,6 +159,7 @@ namespace gameobjects
             SAFE_RELEASE(_callbackHandler);
             _gameObjectTypes.clear();
             _componentTypes.clear();
+            _ignoredComponentTypes.clear();
         }
     }
 
@@ -177,27 +223,12 @@ namespace gameobjects
 
 		if (gameObjectDef)
 		{
-			for (auto & gameObjectDefPair : gameObjectDef->_components)
+			for (ComponentDefinition & componentDef : gameObjectDef->_components)
 			{
-				auto componentTypeItr = _componentTypes.find(gameObjectDefPair.first);
-				ComponentTypeInfo const & componentTypeInfo = componentTypeItr->second;
-				Component * component = componentTypeInfo._generator();
-				gameplay::Properties & properties = *gameObjectDefPair.second;
-				std::string id = properties.getId();
-
-				if (id.empty())
-				{
-					char buffer[UCHAR_MAX];
-					sprintf(buffer, "annon_%d", static_cast<int>(gameObject->_components.size()));
-					id = buffer;
-				}
-
-				component->_id = id;
-				component->readProperties(*gameObjectDefPair.second);
-				component->_typeId = gameObjectDefPair.first;
+				Component * component = createComponent(componentDef);
 				component->_parent = gameObject;
 				component->initialize();
-				gameObject->_components[component->_typeId].push_back(component);
+				gameObject->attachComponent(component);
 			}
 
 			for (std::string & gameObjectTypeName : gameObjectDef->_gameObjects)
@@ -215,6 +246,40 @@ namespace gameobjects
         return  gameObject;
     }
 
+    Component * GameObjectController::createComponent(ComponentDefinition & componentDef)
+    {
+        Component * component = componentDef._typeInfo->_generator();
+        component->_id = componentDef._id;
+        component->_typeId = componentDef._typeId;
+
+        if (!componentDef._prototype || !component->copyProperties(*componentDef._prototype))
+        {
+            component->readProperties(*componentDef._properties);
+
+            if (!componentDef._prototypeCreated)
+            {
+                // The prototype outlives any level being loaded so it must not come from the level's arena
+                gameplay::Arena::Scope heapScope(nullptr);
+                Component * prototype = componentDef._typeInfo->_generator();
+                prototype->_id = componentDef._id;
+                prototype->_typeId = componentDef._typeId;
+
+                if (prototype->copyProperties(*component))
+                {
+                    componentDef._prototype = prototype;
+                }
+                else
+                {
+                    SAFE_RELEASE(prototype);
+                }
+
+                componentDef._prototypeCreated = true;
+            }
+        }
+
+        return component;
+    }
+
     void GameObjectController::destroyGameObject(GameObject * gameObject)
     {
         removeGameObject(gameObject);
@@ -311,6 +376,12 @@ namespace gameobjects
         GameObjectController::getInstance().postGameObjectCallbacks();
     }
 
+    void GameObjectController::ignoreComponent(std::string const & name)
+    {
+        GAMEOBJECT_ASSERT(!_scene, "Components must be ignored before the GameObjectController is initialized");
+        _ignoredComponentTypes.insert(name);
+    }
+
     void GameObjectController::registerCallbackHandler(GameObjectCallbackHandler * handler)
     {
         if(_callbackHandler)
@@ -21,10 +21,27 @@ namespace gameobjects
 
     public:
         /**
-         * @return GameObjectController
+         * @return The controller made current on the calling thread, or the default controller if there isn't one
          */
         static GameObjectController & getInstance();
 
+        /**
+         * Creates a controller with its own scene, separate from the default controller.
+         *
+         * @script{ignore}
+         */
+        static GameObjectController * create();
+
+        /** @script{ignore} */
+        static void destroy(GameObjectController ** controller);
+
+        /**
+         * Sets the controller returned by getInstance() on the calling thread, nullptr restores the default controller.
+         *
+         * @script{ignore}
+         */
+        static void setCurrent(GameObjectController * controller);
+
         /** @script{ignore} */
         void initialize();
 
@@ -68,6 +85,14 @@ namespace gameobjects
         /** @script{ignore} */
         void registerComponent(std::string const & name);
 
+        /**
+         * Components of this type are skipped when game objects are created rather than asserting that the type
+         * is unknown, must be called before initialize()
+         *
+         * @script{ignore}
+         */
+        void ignoreComponent(std::string const & name);
+
         /** @script{ignore} */
         gameplay::Scene * getScene() const;
 
@@ -97,17 +122,34 @@ namespace gameobjects
             std::function<Component*()> _generator;
         };
 
+        /**
+         * A component declaration of a game object type, resolved when the types are loaded. A copy of the first instance read
+         * from it becomes the prototype that later instances copy their properties from, if the component type supports it.
+         */
+        struct ComponentDefinition
+        {
+            std::type_index _typeId;
+            ComponentTypeInfo const * _typeInfo;
+            gameplay::Properties * _properties;
+            std::string _id;
+            Component * _prototype;
+            bool _prototypeCreated;
+        };
+
         struct GameObjectTypeInfo
         {
-            std::vector<std::pair<std::type_index, gameplay::Properties *>> _components;
+            std::vector<ComponentDefinition> _components;
             std::vector<std::string> _gameObjects;
             gameplay::Properties * _definition;
         };
 
+        Component * createComponent(ComponentDefinition & componentDef);
+
         gameplay::Scene * _scene;
         std::string _gameObjectTypeDir;
         std::map<std::type_index, ComponentTypeInfo> _componentTypes;
         std::map<std::string, GameObjectTypeInfo> _gameObjectTypes;
+        std::set<std::string> _ignoredComponentTypes;
         std::set<GameObject *> _gameObjectsToRemove;
         bool _processingGameObjectCallbacks;
         GameObjectCallbackHandler * _callbackHandler;
@@ -0,0 +1,30 @@
+#include "GameObjectMessage.h"
+
+#include "Base.h"
+
+namespace gameobjects
+{
+    Message::Message(int id)
+        : _id(id)
+    {
+    }
+
+    Message::~Message()
+    {
+    }
+
+    Message::Message(Message const & copy)
+        : _id(copy._id)
+    {
+    }
+
+    void Message::destroy(Message ** message)
+    {
+        SAFE_DELETE(*message);
+    }
+
+    int Message::getId() const
+    {
+        return _id;
+    }
+}
@@ -3,11 +3,29 @@
 
 #include <string>
 
-#include "AIMessage.h"
-
 namespace gameobjects
 {
-    typedef gameplay::AIMessage Message;
+    /**
+     * The base of the messages broadcast to game objects. Each type of message, declared with the macros in
+     * GameObjectCommon.h, derives from this and stores its fields as plain members, so setting and reading them
+     * doesn't allocate or convert anything.
+     *
+     * @script{ignore}
+     */
+    class Message
+    {
+    public:
+        static void destroy(Message ** message);
+
+        int getId() const;
+    protected:
+        explicit Message(int id);
+        virtual ~Message();
+    private:
+        Message(Message const &);
+
+        int _id;
+    };
 }
 
 #endif
@@ -8,7 +8,7 @@ namespace gameplay
     class Node;
 }
 
-/** Internal macros and templated funcitons for creating message wrappers around gameplay::AIMessage, 
+/** Internal macros and templated funcitons for declaring the typed messages derived from gameobjects::Message,
     client code should only use macros defined in GameObjectCommon.h
     @script{ignore} 
 */
@@ -19,42 +19,6 @@ namespace gameobjects
     /** @script{ignore} */
     NodeUserDataType * getNodeUserData(gameplay::Node const * node, int id);
 
-    template<typename UnImplementedType>
-    UnImplementedType getMessageProperty(Message * message, int index);
-
-    template<>
-    inline int getMessageProperty(Message * message, int index);
-
-    template<>
-    inline unsigned int getMessageProperty(Message * message, int index);
-
-    template<>
-    inline bool getMessageProperty(Message * message, int index);
-
-    template<>
-    inline float getMessageProperty(Message * message, int index);
-
-    template<>
-    inline char const * getMessageProperty(Message * message, int index);
-
-    template<typename UnImplementedType>
-    void setMessageProperty(Message * message, int index, UnImplementedType value);
-
-    template<>
-    inline void setMessageProperty(Message * message, int index, int value);
-
-    template<>
-    inline void setMessageProperty(Message * message, int index, unsigned int value);
-
-    template<>
-    inline void setMessageProperty(Message * message, int index, bool value);
-
-    template<>
-    inline void setMessageProperty(Message * message, int index, float value);
-
-    template<>
-    inline void setMessageProperty(Message * message, int index, char const * value);
-
     void broadcastInternal(Message * message);
 }
 
@@ -73,9 +37,6 @@ struct Messages\
         };\
 };
 
-#define GAMEOBJECTS_GET_PROPERTY_TEMPLATED_INTERNAL(Type, Index)\
-        gameobjects::getMessageProperty<Type>(message, Index)
-
 #define GAMEOBJECTS_MESSAGE_CONSTRUCTOR_BEGIN_INTERNAL(Name)\
     Name##Message(gameobjects::Message * message)\
         {\
@@ -112,21 +73,21 @@ struct Messages\
         {\
         GP_ASSERT(message->getId() == Messages::Type::Name);
 
-#define GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(Type, Name, Index)\
-        gameobjects::setMessageProperty<Type>(message, Index, Name);
+#define GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(Type, Name)\
+        static_cast<Data *>(message)->_##Name = Name;
 
 #define GAMEOBJECTS_MESSAGE_SETTER_BODY_END_INTERNAL()\
         }
 
-#define GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(Type, Name, Index)\
-        _##Name = GAMEOBJECTS_GET_PROPERTY_TEMPLATED_INTERNAL(Type, Index);
+#define GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(Type, Name)\
+        _##Name = static_cast<Data const *>(message)->_##Name;
 
-#define GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name, PropertyCount)\
+#define GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name)\
 struct Name##Message\
 {\
     static gameobjects::Message * create()\
         {\
-        return gameplay::AIMessage::create(Messages::Type::Name, "", "", PropertyCount);\
+        return new Data();\
         }
 
 #define GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(Type, Name)\
@@ -135,8 +96,19 @@ struct Name##Message\
 #define GAMEOBJECTS_MESSAGE_END_INTERNAL() \
 };
 
+/** The fields are stored in the message itself, string fields point at the sender's string for the length of the broadcast */
+#define GAMEOBJECTS_MESSAGE_DATA_BEGIN_INTERNAL(Name)\
+    struct Data : public gameobjects::Message\
+        {\
+        Data() : gameobjects::Message(Messages::Type::Name) {}
+
+#define GAMEOBJECTS_MESSAGE_DATA_END_INTERNAL()\
+        };
+
 #define GAMEOBJECTS_MESSAGE_0_INTERNAL(Name)\
-GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name, 0)\
+GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name)\
+    GAMEOBJECTS_MESSAGE_DATA_BEGIN_INTERNAL(Name)\
+    GAMEOBJECTS_MESSAGE_DATA_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_CONSTRUCTOR_BEGIN_INTERNAL(Name)\
     GAMEOBJECTS_MESSAGE_CONSTRUCTOR_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_SETTER_SIG_BEGIN_INTERNAL()\
@@ -150,15 +122,18 @@ GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name, 0)\
 GAMEOBJECTS_MESSAGE_END_INTERNAL()
 
 #define GAMEOBJECTS_MESSAGE_1_INTERNAL(Name, T1, N1)\
-GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name, 1)\
+GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name)\
+    GAMEOBJECTS_MESSAGE_DATA_BEGIN_INTERNAL(Name)\
+        GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T1, N1)\
+    GAMEOBJECTS_MESSAGE_DATA_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_CONSTRUCTOR_BEGIN_INTERNAL(Name)\
-        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T1, N1, 0)\
+        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T1, N1)\
     GAMEOBJECTS_MESSAGE_CONSTRUCTOR_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_SETTER_SIG_BEGIN_INTERNAL()\
         GAMEOBJECTS_MESSAGE_SETTER_SIG_ARG_INTERNAL(T1, N1)\
     GAMEOBJECTS_MESSAGE_SETTER_SIG_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_SETTER_BODY_BEGIN_INTERNAL(Name)\
-        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T1, N1, 0)\
+        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T1, N1)\
     GAMEOBJECTS_MESSAGE_SETTER_BODY_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T1, N1)\
     GAMEOBJECTS_MESSAGE_SETTER_BROADCASTER_SIG_BEGIN_INTERNAL()\
@@ -170,18 +145,22 @@ GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name, 1)\
 GAMEOBJECTS_MESSAGE_END_INTERNAL()
 
 #define GAMEOBJECTS_MESSAGE_2_INTERNAL(Name, T1, N1, T2, N2)\
-GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name, 2)\
+GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name)\
+    GAMEOBJECTS_MESSAGE_DATA_BEGIN_INTERNAL(Name)\
+        GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T1, N1)\
+        GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T2, N2)\
+    GAMEOBJECTS_MESSAGE_DATA_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_CONSTRUCTOR_BEGIN_INTERNAL(Name)\
-        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T1, N1, 0)\
-        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T2, N2, 1)\
+        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T1, N1)\
+        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T2, N2)\
     GAMEOBJECTS_MESSAGE_CONSTRUCTOR_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_SETTER_SIG_BEGIN_INTERNAL()\
         GAMEOBJECTS_MESSAGE_SETTER_SIG_ARG_INTERNAL(T1, N1)\
         GAMEOBJECTS_MESSAGE_SETTER_SIG_ARG_INTERNAL(T2, N2)\
     GAMEOBJECTS_MESSAGE_SETTER_SIG_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_SETTER_BODY_BEGIN_INTERNAL(Name)\
-        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T1, N1, 0)\
-        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T2, N2, 1)\
+        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T1, N1)\
+        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T2, N2)\
     GAMEOBJECTS_MESSAGE_SETTER_BODY_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T1, N1)\
     GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T2, N2)\
@@ -196,11 +175,16 @@ GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name, 2)\
 GAMEOBJECTS_MESSAGE_END_INTERNAL()
 
 #define GAMEOBJECTS_MESSAGE_3_INTERNAL(Name, T1, N1, T2, N2, T3, N3)\
-GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name, 3)\
+GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name)\
+    GAMEOBJECTS_MESSAGE_DATA_BEGIN_INTERNAL(Name)\
+        GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T1, N1)\
+        GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T2, N2)\
+        GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T3, N3)\
+    GAMEOBJECTS_MESSAGE_DATA_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_CONSTRUCTOR_BEGIN_INTERNAL(Name)\
-        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T1, N1, 0)\
-        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T2, N2, 1)\
-        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T3, N3, 2)\
+        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T1, N1)\
+        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T2, N2)\
+        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T3, N3)\
     GAMEOBJECTS_MESSAGE_CONSTRUCTOR_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_SETTER_SIG_BEGIN_INTERNAL()\
         GAMEOBJECTS_MESSAGE_SETTER_SIG_ARG_INTERNAL(T1, N1)\
@@ -208,9 +192,9 @@ GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name, 3)\
         GAMEOBJECTS_MESSAGE_SETTER_SIG_ARG_INTERNAL(T3, N3)\
     GAMEOBJECTS_MESSAGE_SETTER_SIG_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_SETTER_BODY_BEGIN_INTERNAL(Name)\
-        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T1, N1, 0)\
-        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T2, N2, 1)\
-        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T3, N3, 2)\
+        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T1, N1)\
+        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T2, N2)\
+        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T3, N3)\
     GAMEOBJECTS_MESSAGE_SETTER_BODY_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T1, N1)\
     GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T2, N2)\
@@ -228,12 +212,18 @@ GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name, 3)\
 GAMEOBJECTS_MESSAGE_END_INTERNAL()
 
 #define GAMEOBJECTS_MESSAGE_4_INTERNAL(Name, T1, N1, T2, N2, T3, N3, T4, N4)\
-GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name, 4)\
+GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name)\
+    GAMEOBJECTS_MESSAGE_DATA_BEGIN_INTERNAL(Name)\
+        GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T1, N1)\
+        GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T2, N2)\
+        GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T3, N3)\
+        GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T4, N4)\
+    GAMEOBJECTS_MESSAGE_DATA_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_CONSTRUCTOR_BEGIN_INTERNAL(Name)\
-        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T1, N1, 0)\
-        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T2, N2, 1)\
-        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T3, N3, 2)\
-        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T4, N4, 3)\
+        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T1, N1)\
+        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T2, N2)\
+        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T3, N3)\
+        GAMEOBJECTS_MESSAGE_GET_PROPERTY_INTENRAL(T4, N4)\
     GAMEOBJECTS_MESSAGE_CONSTRUCTOR_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_SETTER_SIG_BEGIN_INTERNAL()\
         GAMEOBJECTS_MESSAGE_SETTER_SIG_ARG_INTERNAL(T1, N1)\
@@ -242,10 +232,10 @@ GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name, 4)\
         GAMEOBJECTS_MESSAGE_SETTER_SIG_ARG_INTERNAL(T4, N4)\
     GAMEOBJECTS_MESSAGE_SETTER_SIG_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_SETTER_BODY_BEGIN_INTERNAL(Name)\
-        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T1, N1, 0)\
-        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T2, N2, 1)\
-        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T3, N3, 2)\
-        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T4, N4, 3)\
+        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T1, N1)\
+        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T2, N2)\
+        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T3, N3)\
+        GAMEOBJECTS_MESSAGE_SETTER_BODY_ARG_INTERNAL(T4, N4)\
     GAMEOBJECTS_MESSAGE_SETTER_BODY_END_INTERNAL()\
     GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T1, N1)\
     GAMEOBJECTS_MESSAGE_PROPERTY_INTERNAL(T2, N2)\
@@ -265,6 +255,4 @@ GAMEOBJECTS_MESSAGE_BEGIN_INTERNAL(Name, 4)\
     GAMEOBJECTS_MESSAGE_SETTER_BROADCASTER_BODY_END_INTERNAL()\
 GAMEOBJECTS_MESSAGE_END_INTERNAL()
 
-#include "GameObjectMessageFactory.inl"
-
 #endif
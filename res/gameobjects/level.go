@@ -1,5 +1,15 @@
 level_loader
 {
+    // Tiles, static collision, collectables and enemies are created a chunk, a column of tiles, at a time as the player approaches.
+    // The tiles of chunks within the load distance of the view are decoded on a worker, up to chunk_loads_per_frame at once,
+    // chunks in view are waited for.
+    stream_chunks = true
+    chunk_width = 32
+    load_distance = 16
+    unload_distance = 32
+    chunk_loads_per_frame = 1
+    // Nodes and components of the level are allocated from blocks of this many bytes, 0 for the default
+    arena_block_size = 0
 }
 
 level_collision
@@ -10,3 +20,10 @@ level_renderer
 {
     parallax = res/parallax/countryside.parallax
 }
+
+level_activation
+{
+    // Columns of tiles which are simulated together, and how far past the edge of the screen they're simulated
+    region_width = 16
+    padding = 4
+}
@@ -39,6 +39,24 @@ function mkdir(dir)
     os.execute("mkdir " .. "\"" .. dir .. "\"")
 end
 
+function mkdirs(path)
+    local dir = _toolsRoot
+    for component in string.gmatch(path, "[^/]+") do
+        dir = dir .. "/" .. component
+        mkdir(dir)
+    end
+end
+
+function isFile(path)
+    local file = io.open(path, "rb")
+    if not file then
+        return false
+    end
+    local _, err = file:read(1)
+    file:close()
+    return err == nil
+end
+
 _hasRunTool = false
 
 function runTool(toolName)
@@ -53,6 +71,11 @@ end
 
 runTool("export_textures")
 runTool("convert_json")
+runTool("compile_properties")
+runTool("compile_textures")
+runTool("compile_fonts")
+runTool("build_sound_bank")
+runTool("build_pack")
 runTool("generate_android")
 runTool("clean_android")
 runTool("build_android")
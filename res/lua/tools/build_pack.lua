@@ -0,0 +1,7 @@
+local packNs = Game.getInstance():getConfig():getNamespace("pack", true)
+local packPath = packNs:getString("path")
+
+print("Building " .. packPath)
+if not FileSystem.createPack(packPath, packNs:getNamespace("directories", true)) then
+    print("Failed to build " .. packPath)
+end
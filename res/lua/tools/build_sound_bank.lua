@@ -0,0 +1,8 @@
+local soundBankNs = Game.getInstance():getConfig():getNamespace("sound_bank", true)
+local soundBankPath = soundBankNs:getString("path")
+
+mkdirs(string.match(soundBankPath, "(.*)/"))
+print("Building " .. soundBankPath)
+if not AudioSource.createSoundBank(soundBankPath, soundBankNs:getNamespace("directories", true)) then
+    print("Failed to build " .. soundBankPath)
+end
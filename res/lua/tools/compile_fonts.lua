@@ -0,0 +1,14 @@
+local encoderCommand = _toolsRoot .. "/build/external/GamePlay/tools/encoder/gameplay-encoder"
+local fonts = Game.getInstance():getConfig():getNamespace("fonts", true)
+local fontSize = fonts:getInt("size")
+
+-- Fonts are encoded as a single distance field which is scaled to whatever size text is drawn at
+local fontPaths = fonts:getNamespace("paths", true)
+local fontPath = fontPaths:getNextProperty()
+while fontPath do
+    local command = encoderCommand .. " -s " .. fontSize .. " -f:d \"" .. _toolsRoot .. "/" .. fontPaths:getString() .. "\" \"" .. _toolsRoot .. "/" .. fontPath .. "\""
+    print(command)
+    os.execute(command)
+    fontPath = fontPaths:getNextProperty()
+end
+fontPaths:rewind()
@@ -0,0 +1,23 @@
+local compiledRoot = Game.getInstance():getConfig():getString("compiled_properties_path")
+
+function compile(resourceDirName)
+    local outputDir = compiledRoot .. resourceDirName
+    mkdirs(outputDir)
+    for index, fileName in pairs(ls(_toolsRoot .. "/" .. resourceDirName)) do
+        local path = resourceDirName .. "/" .. fileName
+        if isFile(_toolsRoot .. "/" .. path) then
+            print("Compiling " .. path)
+            if not Properties.compile(path, outputDir .. "/" .. fileName) then
+                print("Failed to compile " .. path)
+            end
+        end
+    end
+end
+
+local propertyDirectories = Game.getInstance():getConfig():getNamespace("properties_directories", true)
+local propertyDirectory = propertyDirectories:getNextProperty()
+while propertyDirectory do
+    compile(propertyDirectory)
+    propertyDirectory = propertyDirectories:getNextProperty()
+end
+propertyDirectories:rewind()
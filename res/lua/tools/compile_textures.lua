@@ -0,0 +1,27 @@
+local config = Game.getInstance():getConfig()
+local compiledRoot = config:getString("compiled_textures_path")
+local texturesDir = "res/textures"
+
+local mipMappedTextures = {}
+local mipMaps = config:getNamespace("mip_maps", true)
+if mipMaps then
+    local texturePath = mipMaps:getNextProperty()
+    while texturePath do
+        mipMappedTextures[FileSystem.resolvePath(texturePath)] = true
+        texturePath = mipMaps:getNextProperty()
+    end
+    mipMaps:rewind()
+end
+
+local outputDir = compiledRoot .. texturesDir
+mkdirs(outputDir)
+for index, fileName in pairs(ls(_toolsRoot .. "/" .. texturesDir)) do
+    local path = texturesDir .. "/" .. fileName
+    if string.lower(FileSystem.getExtension(path)) == ".png" then
+        local outputPath = outputDir .. "/" .. string.gsub(fileName, "%.[^.]*$", "") .. ".ktx"
+        print("Compiling " .. path)
+        if not Texture.compile(path, outputPath, mipMappedTextures[path] == true) then
+            print("Failed to compile " .. path)
+        end
+    end
+end
@@ -1,6 +1,6 @@
 #include "AudioComponent.h"
 
-#include "AudioSource.h"
+#include "AudioVoicePool.h"
 #include "Common.h"
 #include "ProfilerController.h"
 #include "GameObjectController.h"
@@ -20,53 +20,19 @@ namespace game
 
     void AudioComponent::initialize()
     {
-        addAudioNode(_jumpAudioSourcePath);
-        addAudioNode(_enemyDeathAudioSourcePath);
-        addAudioNode(_playerDeathAudioSourcePath);
+        AudioVoicePool::getInstance().loadSound(_jumpAudioSourcePath);
+        AudioVoicePool::getInstance().loadSound(_enemyDeathAudioSourcePath);
+        AudioVoicePool::getInstance().loadSound(_playerDeathAudioSourcePath);
     }
 
     void AudioComponent::finalize()
     {
-        for(auto & pair : _audioNodes)
-        {
-            gameplay::Node * node = pair.second;
-
-            if(node->getParent())
-            {
-                node->getParent()->removeChild(node);
-            }
-
-            GAME_ASSERT_SINGLE_REF(node);
-            SAFE_RELEASE(node);
-        }
-
         SAFE_RELEASE(_player);
     }
 
-    void AudioComponent::addAudioNode(std::string const & audioSourcePath)
-    {
-        PROFILE();
-        gameplay::Node * node = gameplay::Node::create(audioSourcePath.c_str());
-        gameplay::AudioSource * audioSource = nullptr;
-        {
-            STALL_SCOPE();
-            audioSource = gameplay::AudioSource::create(audioSourcePath.c_str());
-        }
-        node->setAudioSource(audioSource);
-        // Play it silently so that it performs lazy initialisation
-        audioSource->setGain(0.0f);
-        audioSource->play();
-        SAFE_RELEASE(audioSource);
-        _audioNodes[audioSourcePath] = node;
-    }
-
     void AudioComponent::playSoundEffect(std::string const & audioSourcePath)
     {
-        gameplay::Node * audioNode = _audioNodes[audioSourcePath];
-        audioNode->setTranslation(_player->getNode()->getTranslation());
-        gameplay::AudioSource * source = audioNode->getAudioSource();
-        source->setGain(1.0f);
-        source->play();
+        AudioVoicePool::getInstance().play(audioSourcePath, _player->getNode()->getTranslationWorld());
     }
 
     bool AudioComponent::onMessageReceived(gameobjects::Message *, int messageType)
@@ -77,12 +43,6 @@ namespace game
             {
                 _player = getParent()->getComponentInChildren<PlayerComponent>();
                 _player->addRef();
-
-                for(auto & audioNodePair : _audioNodes)
-                {
-                    _player->getParent()->getNode()->addChild(audioNodePair.second);
-                }
-
                 return true;
             }
             case(Messages::Type::LevelUnloaded):
@@ -8,7 +8,7 @@ namespace game
     class PlayerComponent;
 
     /**
-     * Listens for audible player messages and triggers playback of audio sources
+     * Listens for audible player messages and plays their sound effects through the AudioVoicePool
      *
      * @script{ignore}
     */
@@ -25,12 +25,10 @@ namespace game
     private:
         AudioComponent(AudioComponent const &);
 
-        void addAudioNode(std::string const & audioSourcePath);
         void playSoundEffect(std::string const & audioSourcePath);
         std::string _jumpAudioSourcePath;
         std::string _enemyDeathAudioSourcePath;
         std::string _playerDeathAudioSourcePath;
-        std::map<std::string, gameplay::Node *> _audioNodes;
         PlayerComponent * _player;
     };
 }
@@ -0,0 +1,349 @@
+#include "AudioVoicePool.h"
+
+#include "AudioListener.h"
+#include "AudioSource.h"
+#include "Common.h"
+#include "Node.h"
+#include "ProfilerController.h"
+#include "PropertiesRef.h"
+#include "ResourceManager.h"
+
+namespace game
+{
+    static unsigned int const DEFAULT_MAX_VOICES = 16;
+
+    AudioVoicePool::AudioVoicePool()
+        : _maxVoices(DEFAULT_MAX_VOICES)
+        , _playCount(0)
+    {
+        memset(&_stats, 0, sizeof(_stats));
+    }
+
+    AudioVoicePool::~AudioVoicePool()
+    {
+    }
+
+    AudioVoicePool::AudioVoicePool(AudioVoicePool const &)
+    {
+    }
+
+    AudioVoicePool & AudioVoicePool::getInstance()
+    {
+        static AudioVoicePool instance;
+        return instance;
+    }
+
+    void AudioVoicePool::initialize()
+    {
+        if(gameplay::Properties * audioConfig = getConfig()->getNamespace("audio", true))
+        {
+            if(audioConfig->exists("voices"))
+            {
+                _maxVoices = audioConfig->getInt("voices");
+            }
+        }
+
+        _voices.reserve(_maxVoices);
+        _instances.reserve(_maxVoices);
+    }
+
+    void AudioVoicePool::finalize()
+    {
+        while(!_instances.empty())
+        {
+            removeInstance(_instances.size() - 1);
+        }
+
+        for(Voice & voice : _voices)
+        {
+            SAFE_RELEASE(voice._node);
+        }
+
+        for(auto & soundPair : _sounds)
+        {
+            SAFE_RELEASE(soundPair.second._source);
+        }
+
+        _voices.clear();
+        _sounds.clear();
+        memset(&_stats, 0, sizeof(_stats));
+    }
+
+    void AudioVoicePool::loadSound(std::string const & url)
+    {
+        if(_sounds.find(url) != _sounds.end())
+        {
+            return;
+        }
+
+        PROFILE();
+        gameplay::PropertiesRef * propertiesRef = ResourceManager::getInstance().getProperties(url);
+        gameplay::Properties * properties = propertiesRef->get();
+        gameplay::AudioSource * source = nullptr;
+        {
+            STALL_SCOPE();
+            source = gameplay::AudioSource::create(properties);
+        }
+        GAME_ASSERT(source, "Failed to load sound '%s'", url.c_str());
+
+        // The source is never played, it keeps the buffer loaded and holds the settings copied to the voices that play it
+        Sound & sound = _sounds[url];
+        sound._url = url;
+        sound._source = source;
+        sound._priority = properties->exists("priority") ? properties->getInt("priority") : 0;
+        sound._maxInstances = properties->exists("max_instances") ? properties->getInt("max_instances") : _maxVoices;
+        sound._maxDistance = properties->exists("max_distance") ? properties->getFloat("max_distance") : 0.0f;
+        sound._duration = source->getDuration();
+        SAFE_RELEASE(propertiesRef);
+    }
+
+    void AudioVoicePool::play(std::string const & url, gameplay::Vector3 const & position)
+    {
+        PROFILE();
+        auto soundItr = _sounds.find(url);
+
+        if(soundItr == _sounds.end())
+        {
+            loadSound(url);
+            soundItr = _sounds.find(url);
+        }
+
+        Sound * sound = &soundItr->second;
+        unsigned int instanceCount = 0;
+        int oldestInstance = -1;
+
+        for(size_t i = 0; i < _instances.size(); ++i)
+        {
+            if(_instances[i]._sound == sound)
+            {
+                ++instanceCount;
+
+                if(oldestInstance < 0 || _instances[i]._playOrder < _instances[oldestInstance]._playOrder)
+                {
+                    oldestInstance = i;
+                }
+            }
+        }
+
+        // Its voice is freed and then reused without having to switch buffers
+        if(oldestInstance >= 0 && instanceCount >= sound->_maxInstances)
+        {
+            removeInstance(oldestInstance);
+        }
+
+        Instance instance;
+        instance._sound = sound;
+        instance._position = position;
+        instance._time = 0.0f;
+        instance._voice = -1;
+        instance._playOrder = _playCount++;
+
+        if(isAudible(instance))
+        {
+            int const voiceIndex = acquireVoice(sound, true);
+
+            if(voiceIndex < 0)
+            {
+                ++_stats._dropped;
+                return;
+            }
+
+            startVoice(instance, voiceIndex);
+        }
+
+        _instances.push_back(instance);
+    }
+
+    void AudioVoicePool::update(float elapsedTime)
+    {
+        PROFILE();
+        unsigned int voicesInUse = 0;
+        unsigned int virtualInstances = 0;
+
+        for(size_t i = 0; i < _instances.size();)
+        {
+            Instance & instance = _instances[i];
+            instance._time += elapsedTime;
+            bool finished = false;
+
+            if(instance._voice >= 0)
+            {
+                finished = _voices[instance._voice]._node->getAudioSource()->getState() != gameplay::AudioSource::PLAYING;
+            }
+            else
+            {
+                finished = instance._time >= instance._sound->_duration && !instance._sound->_source->isLooped();
+            }
+
+            if(finished)
+            {
+                removeInstance(i);
+                continue;
+            }
+
+            bool const audible = isAudible(instance);
+
+            if(instance._voice >= 0 && !audible)
+            {
+                Voice & voice = _voices[instance._voice];
+                voice._node->getAudioSource()->stop();
+                voice._inUse = false;
+                instance._voice = -1;
+            }
+            else if(instance._voice < 0 && audible)
+            {
+                // Becoming audible again only takes spare voices, voices are only stolen for sounds that just started
+                int const voiceIndex = acquireVoice(instance._sound, false);
+
+                if(voiceIndex >= 0)
+                {
+                    startVoice(instance, voiceIndex);
+                }
+            }
+
+            if(instance._voice >= 0)
+            {
+                ++voicesInUse;
+            }
+            else
+            {
+                ++virtualInstances;
+            }
+
+            ++i;
+        }
+
+        _stats._voices = _voices.size();
+        _stats._voicesInUse = voicesInUse;
+        _stats._virtualInstances = virtualInstances;
+    }
+
+    AudioVoicePool::Stats const & AudioVoicePool::getStats() const
+    {
+        return _stats;
+    }
+
+    bool AudioVoicePool::isAudible(Instance const & instance) const
+    {
+        float const maxDistance = instance._sound->_maxDistance;
+        gameplay::AudioListener * listener = gameplay::AudioListener::getInstance();
+
+        if(maxDistance <= 0.0f || !listener)
+        {
+            return true;
+        }
+
+        return instance._position.distanceSquared(listener->getPosition()) <= maxDistance * maxDistance;
+    }
+
+    int AudioVoicePool::acquireVoice(Sound * sound, bool steal)
+    {
+        int freeVoice = -1;
+
+        for(size_t i = 0; i < _voices.size(); ++i)
+        {
+            if(!_voices[i]._inUse)
+            {
+                freeVoice = i;
+
+                if(_voices[i]._sound == sound)
+                {
+                    return i;
+                }
+            }
+        }
+
+        if(freeVoice >= 0)
+        {
+            return freeVoice;
+        }
+
+        if(_voices.size() < _maxVoices)
+        {
+            gameplay::PropertiesRef * propertiesRef = ResourceManager::getInstance().getProperties(sound->_url);
+            gameplay::AudioSource * source = gameplay::AudioSource::create(propertiesRef->get());
+            SAFE_RELEASE(propertiesRef);
+            Voice voice;
+            voice._node = gameplay::Node::create("voice");
+            voice._node->setAudioSource(source);
+            voice._sound = sound;
+            voice._inUse = false;
+            SAFE_RELEASE(source);
+            _voices.push_back(voice);
+            return _voices.size() - 1;
+        }
+
+        if(steal)
+        {
+            int victim = -1;
+
+            for(size_t i = 0; i < _instances.size(); ++i)
+            {
+                Instance const & instance = _instances[i];
+
+                if(instance._voice >= 0 && instance._sound->_priority <= sound->_priority)
+                {
+                    if(victim < 0 ||
+                       instance._sound->_priority < _instances[victim]._sound->_priority ||
+                       (instance._sound->_priority == _instances[victim]._sound->_priority && instance._playOrder < _instances[victim]._playOrder))
+                    {
+                        victim = i;
+                    }
+                }
+            }
+
+            if(victim >= 0)
+            {
+                int const voiceIndex = _instances[victim]._voice;
+                removeInstance(victim);
+                ++_stats._stolen;
+                return voiceIndex;
+            }
+        }
+
+        return -1;
+    }
+
+    void AudioVoicePool::startVoice(Instance & instance, int voiceIndex)
+    {
+        Voice & voice = _voices[voiceIndex];
+        Sound * sound = instance._sound;
+        gameplay::AudioSource * source = voice._node->getAudioSource();
+
+        if(voice._sound != sound)
+        {
+            source->shareBuffer(sound->_source);
+            source->setLooped(sound->_source->isLooped());
+            source->setGain(sound->_source->getGain());
+            source->setPitch(sound->_source->getPitch());
+            voice._sound = sound;
+        }
+
+        voice._node->setTranslation(instance._position);
+        source->play();
+
+        // Instances that were virtual continue from where they would have been
+        if(instance._time > 0.0f)
+        {
+            source->setOffset(instance._time);
+        }
+
+        voice._inUse = true;
+        instance._voice = voiceIndex;
+    }
+
+    void AudioVoicePool::removeInstance(size_t instanceIndex)
+    {
+        Instance & instance = _instances[instanceIndex];
+
+        if(instance._voice >= 0)
+        {
+            Voice & voice = _voices[instance._voice];
+            voice._node->getAudioSource()->stop();
+            voice._inUse = false;
+        }
+
+        _instances[instanceIndex] = _instances.back();
+        _instances.pop_back();
+    }
+}
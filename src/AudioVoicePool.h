@@ -0,0 +1,94 @@
+#ifndef GAME_AUDIO_VOICE_POOL_H
+#define GAME_AUDIO_VOICE_POOL_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "Vector3.h"
+
+namespace gameplay
+{
+    class AudioSource;
+    class Node;
+}
+
+namespace game
+{
+    /**
+     * Plays sound effects through a fixed number of voices that are shared by all sounds.
+     *
+     * Sounds are defined in .audio files which, in addition to the audio source properties, can set:
+     * - 'priority', when all voices are in use a sound takes the voice of the oldest sound with the lowest priority
+     *   that isn't higher than its own, otherwise it is dropped.
+     * - 'max_instances', playing a sound more often than this restarts its oldest instance.
+     * - 'max_distance', instances further than this from the listener are virtual, they keep track of their playback
+     *   time without holding a voice and take one if they become audible again before they would have finished.
+     *
+     * @script{ignore}
+    */
+    class AudioVoicePool
+    {
+    public:
+        struct Stats
+        {
+            unsigned int _voices;
+            unsigned int _voicesInUse;
+            unsigned int _virtualInstances;
+            unsigned int _stolen;
+            unsigned int _dropped;
+        };
+
+        static AudioVoicePool & getInstance();
+
+        void initialize();
+        void finalize();
+        void update(float elapsedTime);
+        void loadSound(std::string const & url);
+        void play(std::string const & url, gameplay::Vector3 const & position);
+        Stats const & getStats() const;
+    private:
+        struct Sound
+        {
+            std::string _url;
+            gameplay::AudioSource * _source;
+            int _priority;
+            unsigned int _maxInstances;
+            float _maxDistance;
+            float _duration;
+        };
+
+        struct Voice
+        {
+            gameplay::Node * _node;
+            Sound * _sound;
+            bool _inUse;
+        };
+
+        struct Instance
+        {
+            Sound * _sound;
+            gameplay::Vector3 _position;
+            float _time;
+            int _voice;
+            unsigned int _playOrder;
+        };
+
+        explicit AudioVoicePool();
+        ~AudioVoicePool();
+        AudioVoicePool(AudioVoicePool const &);
+
+        bool isAudible(Instance const & instance) const;
+        int acquireVoice(Sound * sound, bool steal);
+        void startVoice(Instance & instance, int voiceIndex);
+        void removeInstance(size_t instanceIndex);
+
+        std::map<std::string, Sound> _sounds;
+        std::vector<Voice> _voices;
+        std::vector<Instance> _instances;
+        unsigned int _maxVoices;
+        unsigned int _playCount;
+        Stats _stats;
+    };
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include "Messages.h"
 #include "PlayerComponent.h"
 #include "Scene.h"
+#include "World.h"
 
 namespace game
 {
@@ -93,7 +94,11 @@ namespace game
         }
 
         _targetPosition.smooth(target, elapsedTime / 1000.0f, _smoothSpeedScale);
-        gameplay::Game::getInstance()->getAudioListener()->setPosition(_targetPosition.x, _targetPosition.y, 0.0);
+        if(!World::getCurrent().isHeadless())
+        {
+            gameplay::Game::getInstance()->getAudioListener()->setPosition(_targetPosition.x, _targetPosition.y, 0.0);
+        }
+
         if(clamp)
         {
             float const offsetX = (gameplay::Game::getInstance()->getWidth() / 2) *  _currentZoom;
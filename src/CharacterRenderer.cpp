@@ -36,12 +36,12 @@ namespace game
         return _renderCount;
     }
 
-    bool CharacterRenderer::render(SpriteAnimationComponent * animation, gameplay::SpriteBatch * spriteBatch,
-        gameplay::Matrix const & projection, int orientation,
-        gameplay::Vector3 const & position, gameplay::Rectangle const & viewport, float alpha)
+    bool CharacterRenderer::render(SpriteAnimationComponent::DrawTarget const & target, gameplay::SpriteBatch * spriteBatch,
+        gameplay::Matrix const & projection, gameplay::Vector3 const & position,
+        gameplay::Rectangle const & viewport, float alpha)
     {
         bool wasRendered = false;
-        SpriteAnimationComponent::DrawTarget drawTarget = animation->getDrawTarget(0.0f, static_cast<Sprite::Flip::Enum>(orientation));
+        SpriteAnimationComponent::DrawTarget drawTarget = target;
         gameplay::Rectangle const bounds(position.x - ((fabs(drawTarget._scale.x / 2) * GAME_UNIT_SCALAR)),
             position.y - ((fabs(drawTarget._scale.y / 2) * GAME_UNIT_SCALAR)),
             fabs(drawTarget._scale.x) * GAME_UNIT_SCALAR,
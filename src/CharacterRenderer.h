@@ -1,6 +1,8 @@
 #ifndef GAME_CHARACTER_RENDERER_COMPONENT_H
 #define GAME_CHARACTER_RENDERER_COMPONENT_H
 
+#include "SpriteAnimationComponent.h"
+
 namespace gameplay
 {
     class Matrix;
@@ -11,8 +13,6 @@ namespace gameplay
 
 namespace game
 {
-    class SpriteAnimationComponent;
-
     class CharacterRenderer
     {
     public:
@@ -20,9 +20,9 @@ namespace game
         void start();
         void finish();
         unsigned int getRenderCount() const;
-        bool render(SpriteAnimationComponent * animation, gameplay::SpriteBatch * spriteBatch,
-            gameplay::Matrix const & spriteBatchProjection, int orientation,
-            gameplay::Vector3 const & position, gameplay::Rectangle const & viewport, float alpha = 1.0f);
+        bool render(SpriteAnimationComponent::DrawTarget const & drawTarget, gameplay::SpriteBatch * spriteBatch,
+            gameplay::Matrix const & spriteBatchProjection, gameplay::Vector3 const & position,
+            gameplay::Rectangle const & viewport, float alpha = 1.0f);
     private:
         gameplay::SpriteBatch * _previousSpritebatch;
         bool _started;
@@ -1,6 +1,7 @@
 #include "Common.h"
 
 #include "Font.h"
+#include "LogWriter.h"
 #include "ScreenDisplayer.h"
 #include "ScreenOverlay.h"
 #include "Texture.h"
@@ -17,12 +18,6 @@ namespace game
         int _secondsRemaining;
     };
 
-    static std::deque<std::string> & getLogHistory()
-    {
-        static std::deque<std::string> logHistory;
-        return logHistory;
-    }
-    
     /** @script{ignore} */
     struct LogRenderer
     {
@@ -35,19 +30,21 @@ namespace game
             int const margin = 10;
             int x = margin;
             int y = margin;
-            int const yPadding = font->getSize();
+            int const yPadding = GAME_FONT_SIZE_SMALL;
             std::array<char, UCHAR_MAX> buffer;
             sprintf(&buffer[0], "%s! Resuming in %d", msg->_level == gameplay::Logger::LEVEL_ERROR ? "ERROR" : "WARNING", msg->_secondsRemaining);
             font->start();
-            font->drawText(&buffer[0], x, y += yPadding, gameplay::Vector4(1, 0, 0, 1));
-            font->drawText(msg->_message, x, y += yPadding, gameplay::Vector4::one());
+            font->drawText(&buffer[0], x, y += yPadding, gameplay::Vector4(1, 0, 0, 1), GAME_FONT_SIZE_SMALL);
+            font->drawText(msg->_message, x, y += yPadding, gameplay::Vector4::one(), GAME_FONT_SIZE_SMALL);
             y += yPadding;
-            font->drawText("Recent log history:", x, y += yPadding, gameplay::Vector4::one());
+            font->drawText("Recent log history:", x, y += yPadding, gameplay::Vector4::one(), GAME_FONT_SIZE_SMALL);
             y += yPadding;
 
-            for (auto itr = getLogHistory().rbegin(); itr != getLogHistory().rend(); ++itr)
+            std::vector<std::string> const logHistory = LogWriter::getInstance().getHistory();
+
+            for (auto itr = logHistory.rbegin(); itr != logHistory.rend(); ++itr)
             {
-                font->drawText(itr->c_str(), x, y += yPadding, gameplay::Vector4::fromColor(0xDBFF28FF));
+                font->drawText(itr->c_str(), x, y += yPadding, gameplay::Vector4::fromColor(0xDBFF28FF), GAME_FONT_SIZE_SMALL);
             }
 
             font->finish();
@@ -56,7 +53,7 @@ namespace game
 
     void clearLogHistory()
     {
-        getLogHistory().clear();
+        LogWriter::getInstance().clearHistory();
     }
 
     int & getIndent()
@@ -97,10 +94,11 @@ namespace game
     void loggingCallback(gameplay::Logger::Level level, const char* msg)
     {
 #ifndef _FINAL
+        // Warnings and errors arrive in three calls (function, message, new line), each thread gathers its own
         int const callsPerMessage = 3;
-        static int callCount = 0;
-        static std::string logOutput;
-        static bool forceAssert = callCount == 0 && strcmp(msg, "lua assert:") == 0;
+        static thread_local int callCount = 0;
+        static thread_local std::string logOutput;
+        static thread_local bool forceAssert = callCount == 0 && strcmp(msg, "lua assert:") == 0;
         
         if (level != gameplay::Logger::Level::LEVEL_INFO)
         {
@@ -109,12 +107,14 @@ namespace game
             
             if (callCount == callsPerMessage)
             {
-                gameplay::print(logOutput.c_str());
+                LogWriter::getInstance().write(level, logOutput.c_str());
 
                 int timeout = getConfig()->getInt("assert_timeout_ms");
 
-                if (timeout > 0)
+                // The screen can only be displayed from the main thread, other threads just log
+                if (timeout > 0 && LogWriter::getInstance().isMainThread())
                 {
+                    LogWriter::getInstance().flush();
                     LogDisplayMessage message;
                     message._level = level;
                     message._message = logOutput.c_str();
@@ -141,13 +141,7 @@ namespace game
         }
         else
         {
-            if (getLogHistory().size() == GAME_ON_SCREEN_LOG_HISTORY_CAPACITY)
-            {
-                getLogHistory().pop_front();
-            }
-
-            getLogHistory().push_back(msg);
-            gameplay::print(msg);
+            LogWriter::getInstance().write(level, msg);
         }
 #else
         if (level != gameplay::Logger::Level::LEVEL_INFO)
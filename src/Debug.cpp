@@ -2,12 +2,15 @@
 
 #include "Debug.h"
 
+#include "AudioVoicePool.h"
 #include "CameraComponent.h"
 #include "Common.h"
 #include "Font.h"
 #include "Game.h"
 #include "GameObjectController.h"
+#include "GLStateCache.h"
 #include "LineBatch.h"
+#include "LogWriter.h"
 #include "Messages.h"
 #include "ProfilerController.h"
 #include "Properties.h"
@@ -62,6 +65,9 @@ namespace  game
         , _textY(0)
         , _levelIndex(0)
         , _selectedProfilerIndex(0)
+        , _framesSinceLevelLoaded(-1)
+        , _screenTextRunIndex(0)
+        , _worldTextRunIndex(0)
     {
     }
 
@@ -176,6 +182,9 @@ namespace  game
                         toggleSetting("show_enemy_stats");
                         toggleSetting("show_platform_stats");
                         break;
+                    case gameplay::Keyboard::KEY_F8:
+                        toggleSetting("show_resource_stats");
+                        break;
                     case gameplay::Keyboard::KEY_UP_ARROW:
                         game->setTimeScale(MATH_CLAMP(game->getTimeScale() + timeScaleDelta, minTimeScale, maxTimeScale));
                         break;
@@ -222,6 +231,42 @@ namespace  game
         _cursorX = x;
     }
 
+    void Debug::levelLoaded()
+    {
+        _framesSinceLevelLoaded = 0;
+    }
+
+    void Debug::checkFrameAllocations()
+    {
+#ifdef GP_USE_MEM_LEAK_DETECTION
+        // The first frames after a level is loaded still fill caches and grow containers to their working size
+        int const steadyStateFrames = 60;
+        gameplay::ProfilerController * profiler = gameplay::Game::getInstance()->getProfilerController();
+
+        if(_framesSinceLevelLoaded < 0 || !profiler->isRecording())
+        {
+            return;
+        }
+
+        if(_framesSinceLevelLoaded < steadyStateFrames)
+        {
+            ++_framesSinceLevelLoaded;
+            return;
+        }
+
+        unsigned int const previousFrameIndex = profiler->getFrameIndex() > 0 ? profiler->getFrameIndex() - 1 : profiler->getFrameHistorySize() - 1;
+        unsigned int const allocations = profiler->getAllocations(previousFrameIndex);
+
+        if(allocations > 0 && getConfig()->getBool("assert_frame_allocations"))
+        {
+            // Start over so that the allocations made while showing the error aren't reported as well
+            _framesSinceLevelLoaded = 0;
+            GAME_ASSERTFAIL("Frame made %d allocations (%llu bytes) after the level was loaded, pause the profiler (F6) to find them",
+                allocations, profiler->getAllocatedBytes(previousFrameIndex));
+        }
+#endif
+    }
+
     void Debug::renderStart()
     {
         gameplay::Game * game = gameplay::Game::getInstance();
@@ -233,11 +278,14 @@ namespace  game
         {
             game->clear(gameplay::Game::CLEAR_COLOR, clearColor, clearDepth, clearStencil);
         }
+        checkFrameAllocations();
         if(_rendererEnabled)
         {
             PROFILE();
             _previousTextType = TextType::None;
             _textY = 0;
+            _screenTextRunIndex = 0;
+            _worldTextRunIndex = 0;
             {
                 FRAME_BUFFER_SCOPE();
                 game->clear(gameplay::Game::CLEAR_COLOR, clearColor, clearDepth, clearStencil);
@@ -248,6 +296,38 @@ namespace  game
                 game->getWidth(),
                 game->getHeight(),
                 game->getTimeScale());
+            DEBUG_RENDER_TEXT_WITH_ARGS("show_stats", "[gl state %d issued/%d skipped]",
+                gameplay::GLStateCache::getFrameStats().issued,
+                gameplay::GLStateCache::getFrameStats().skipped);
+            DEBUG_RENDER_TEXT_WITH_ARGS("show_stats", "[voices %d/%d][%d virtual][%d stolen][%d dropped]",
+                AudioVoicePool::getInstance().getStats()._voicesInUse,
+                AudioVoicePool::getInstance().getStats()._voices,
+                AudioVoicePool::getInstance().getStats()._virtualInstances,
+                AudioVoicePool::getInstance().getStats()._stolen,
+                AudioVoicePool::getInstance().getStats()._dropped);
+            DEBUG_RENDER_TEXT_WITH_ARGS("show_stats", "[log %d written/%d dropped/%d suppressed]",
+                LogWriter::getInstance().getStats()._written,
+                LogWriter::getInstance().getStats()._dropped,
+                LogWriter::getInstance().getStats()._suppressed);
+            DEBUG_RENDER_TEXT_WITH_ARGS("show_stats", "[physics thread %.2fms][%s]",
+                game->getPhysicsController()->getStepThreadTime(),
+                game->isRenderPipelined() ? "pipelined" : "serial");
+            gameplay::PhysicsController::StepStats const & stepStats = game->getPhysicsController()->getStepStats();
+            DEBUG_RENDER_TEXT_WITH_ARGS("show_stats", "[physics %d/%d substeps][%.3fms/substep][%.2fms debt][%.0fms dropped in %d steps]",
+                stepStats.substeps,
+                stepStats.substepLimit,
+                stepStats.substepCost,
+                stepStats.timeDebt,
+                stepStats.droppedTime,
+                stepStats.droppedSteps);
+#ifdef GP_USE_MEM_LEAK_DETECTION
+            unsigned int const frameIndex = game->getProfilerController()->getFrameIndex();
+            unsigned int const previousFrameIndex = frameIndex > 0 ? frameIndex - 1 : game->getProfilerController()->getFrameHistorySize() - 1;
+            DEBUG_RENDER_TEXT_WITH_ARGS("show_stats", "[allocations %d/%llu bytes]",
+                game->getProfilerController()->getAllocations(previousFrameIndex),
+                game->getProfilerController()->getAllocatedBytes(previousFrameIndex));
+#endif
+            renderResourceStats();
             renderLegend(                                                   "ARROWS            - move");
             renderLegend(                                                   "SPACE             - jump");
             renderLegend(                                                   "PGUP/PGDOWN       - +/- zoom");
@@ -273,9 +353,33 @@ namespace  game
             renderLegendToggleSetting("show_nodes",                         "SHIFT+F5          - toggle nodes              ");
             renderLegendToggleSetting("show_level_stats",                   "SHIFT+F6          - toggle level stats        ");
             renderLegendToggleSetting("show_physics_stats",                 "SHIFT+F7          - toggle physics stats      ");
+            renderLegendToggleSetting("show_resource_stats",                "SHIFT+F8          - toggle resource stats     ");
         }
     }
 
+    void Debug::renderResourceStats()
+    {
+        ResourceManager & resourceManager = ResourceManager::getInstance();
+        char const * const cacheNames[] = { "textures", "spritesheets", "properties", "effects" };
+        float const bytesToMB = 1.0f / (1024 * 1024);
+        size_t totalBytes = 0;
+
+        for(int cacheType = 0; cacheType < ResourceManager::CacheType::Count; ++cacheType)
+        {
+            ResourceManager::CacheStats const & stats = resourceManager.getCacheStats(static_cast<ResourceManager::CacheType::Enum>(cacheType));
+            unsigned int const requests = stats._hits + stats._misses;
+            DEBUG_RENDER_TEXT_WITH_ARGS("show_resource_stats", "%-13s [%.2fmb][%d][%d%% hit][%d evicted]",
+                cacheNames[cacheType],
+                stats._bytes * bytesToMB,
+                stats._entries,
+                requests > 0 ? (stats._hits * 100) / requests : 100,
+                stats._evictions);
+            totalBytes += stats._bytes;
+        }
+
+        DEBUG_RENDER_TEXT_WITH_ARGS("show_resource_stats", "resident      [%.2f/%.2fmb]", totalBytes * bytesToMB, resourceManager.getBudget() * bytesToMB);
+    }
+
     void Debug::renderFinish()
     {
         if(_rendererEnabled)
@@ -285,7 +389,7 @@ namespace  game
             renderNodes();
             renderProfiler();
             gameplay::Font * font = ResourceManager::getInstance().getDebugFront();
-            if(font->getSpriteBatch(font->getSize())->isStarted())
+            if(font->getSpriteBatch(GAME_FONT_SIZE_SMALL)->isStarted())
             {
                 FRAME_BUFFER_SCOPE();
                 font->finish();
@@ -301,6 +405,7 @@ namespace  game
         if(_rendererEnabled && getConfig()->getBool("show_physics"))
         {
             FRAME_BUFFER_SCOPE();
+            gameplay::Game::getInstance()->getPhysicsController()->waitForStep();
             gameplay::Game::getInstance()->getPhysicsController()->drawDebug(CameraComponent::getViewProjectionMatrix(), CameraComponent::getRenderViewport());
         }
     }
@@ -309,6 +414,7 @@ namespace  game
     {
         if (_rendererEnabled && getConfig()->getBool("show_nodes"))
         {
+            gameplay::Game::getInstance()->getPhysicsController()->waitForStep();
             renderText("show_nodes", "%d", _nodeCount);
             _nodeCount = 0;
             _nodeDepth = 0;
@@ -323,7 +429,11 @@ namespace  game
         virtual void read(const Event& event) override
         {
             double const frameDuration = gameplay::Game::getInstance()->getProfilerController()->getDuration(Debug::getInstance()._selectedProfilerIndex);
+#ifdef GP_USE_MEM_LEAK_DETECTION
+            Debug::getInstance().renderText("show_profiler", "%*s%-*s%4d %8.3f %8.3f %8.3f %8.3f %8.1f %6d %9llu",
+#else
             Debug::getInstance().renderText("show_profiler", "%*s%-*s%4d %8.3f %8.3f %8.3f %8.3f %8.1f",
+#endif
                 event._depth,
                 "",
                 PROFILER_NAME_COLUMN_WIDTH - event._depth,
@@ -333,7 +443,12 @@ namespace  game
                 event._maxTime,
                 event._totalTime / event._hits,
                 event._totalTime,
-                (100.0f / frameDuration) * event._totalTime);
+                (100.0f / frameDuration) * event._totalTime
+#ifdef GP_USE_MEM_LEAK_DETECTION
+                , event._allocations
+                , event._allocatedBytes
+#endif
+                );
         }
     };
 
@@ -376,6 +491,15 @@ namespace  game
                 ++index;
             }
 
+            // A lane for each job worker and one shared by the threads that help while they wait
+            gameplay::JobController * jobs = gameplay::Game::getInstance()->getJobController();
+            for(unsigned int laneIndex = 0; laneIndex <= jobs->getWorkerCount(); ++laneIndex)
+            {
+                gameplay::JobController::Lane const & lane = jobs->getLane(laneIndex);
+                char const * laneName = laneIndex < jobs->getWorkerCount() ? "worker" : "waiting";
+                renderText("show_profiler", "[%s %d][%4d jobs][%4d steals][%8.3f ms]", laneName, laneIndex, lane.jobs, lane.steals, lane.busyTime);
+            }
+
             if(!profiler->isRecording())
             {
                 static gameplay::Vector4 const selectionColor(0.0, 0.0f, 1.0f, 1.0f);
@@ -398,7 +522,14 @@ namespace  game
                 {
                     _selectedProfilerIndex -= size;
                 }
+#ifdef GP_USE_MEM_LEAK_DETECTION
+                renderText("show_profiler", "Frame allocations %d (%llu bytes)",
+                    profiler->getAllocations(_selectedProfilerIndex),
+                    profiler->getAllocatedBytes(_selectedProfilerIndex));
+                renderText("show_profiler", "%*sHits      Min      Max  Average    Total        %%  Allocs     Bytes", PROFILER_NAME_COLUMN_WIDTH , "");
+#else
                 renderText("show_profiler", "%*sHits      Min      Max  Average    Total", PROFILER_NAME_COLUMN_WIDTH , "");
+#endif
                 static EventRenderer framePrinter;
                 profiler->getFrameEvents(_selectedProfilerIndex, &framePrinter);
             }
@@ -449,7 +580,7 @@ namespace  game
             gameplay::Matrix::createOrthographicOffCenter(0, gameplay::Game::getInstance()->getWidth(),
                 gameplay::Game::getInstance()->getHeight(), 0, 0, 1, &view);
             int const paddingX = 5;
-            int const paddingY = ResourceManager::getInstance().getDebugFront()->getSize() * 0.75f;
+            int const paddingY = GAME_FONT_SIZE_SMALL * 0.75f;
             if(renderText(TextType::Screen, view, gameplay::Vector3(paddingX, _textY, 0), setting, &buffer[0]))
             {
                 _textY += paddingY;
@@ -472,35 +603,39 @@ namespace  game
             renderPosition.scale(1.0f / GAME_UNIT_SCALAR);
             unsigned int pixelWidth, pixelHeight = 0;
             char const * text = &buffer[0];
-            font->measureText(text, font->getSize(GAME_FONT_SIZE_LARGE_INDEX), &pixelWidth, &pixelHeight);
-            renderPosition.x -= pixelWidth * 0.25f;
+            font->measureText(text, GAME_FONT_SIZE_SMALL, &pixelWidth, &pixelHeight);
+            renderPosition.x -= pixelWidth * 0.5f;
             renderText(TextType::World, CameraComponent::getRenderViewProjectionMatrix(), renderPosition, setting, text);
         }
     }
 
-    bool Debug::renderText(TextType textType, gameplay::Matrix const & view, gameplay::Vector3 const & position, char const * setting, char const * message, ...)
+    bool Debug::renderText(TextType textType, gameplay::Matrix const & view, gameplay::Vector3 const & position, char const * setting, char const * text)
     {
         if(getConfig()->getBool(setting))
         {
             gameplay::Font * font = ResourceManager::getInstance().getDebugFront();
-            gameplay::SpriteBatch * batch = font->getSpriteBatch(font->getSize());
+            gameplay::SpriteBatch * batch = font->getSpriteBatch(GAME_FONT_SIZE_SMALL);
             if(batch->isStarted() && _previousTextType != TextType::None && _previousTextType != textType)
             {
                 FRAME_BUFFER_SCOPE();
                 font->finish();
             }
-            static std::array<char, 4096> buffer;
-            va_list args;
-            va_start(args, message);
-            va_end(args);
-            vsprintf(&buffer[0], message, args);
+            // Each line keeps its own run from the previous frame so only the characters that changed are laid out again
+            std::vector<gameplay::Font::TextRun> & runs = textType == TextType::Screen ? _screenTextRuns : _worldTextRuns;
+            unsigned int & runIndex = textType == TextType::Screen ? _screenTextRunIndex : _worldTextRunIndex;
+            if(runIndex >= runs.size())
+            {
+                runs.resize(runIndex + 1);
+            }
+            gameplay::Font::TextRun & run = runs[runIndex++];
+            font->layoutText(&run, text, GAME_FONT_SIZE_SMALL);
             if(!batch->isStarted() && textType == TextType::World)
             {
                 font->drawText("", 0, 0, gameplay::Vector4::one());
             }
             batch->setProjectionMatrix(view);
             static const gameplay::Vector4 color = gameplay::Vector4(1, 0, 0, 1);
-            font->drawText(&buffer[0], position.x, position.y, color);
+            font->drawText(&run, position.x, position.y, color);
             _previousTextType = textType;
             return true;
         }
@@ -1,6 +1,8 @@
 #ifndef GAME_DEBUG
 #define GAME_DEBUG
 
+#include "Base.h"
+#include "Font.h"
 #include "GameObjectMessage.h"
 #include "Keyboard.h"
 #include "Rectangle.h"
@@ -37,6 +39,7 @@ namespace game
         static Debug & getInstance();
         void renderText(char const * setting, char const * message, ...);
         void renderTextWorld(gameplay::Vector3 const & position, char const * setting, char const * message, ...);
+        void levelLoaded();
     private:
         enum TextType
         {
@@ -51,6 +54,8 @@ namespace game
         void renderPhysics();
         void renderNodes();
         void renderProfiler();
+        void renderResourceStats();
+        void checkFrameAllocations();
         void renderLegend(char const * description);
         void renderLegendToggle(bool const enabled, char const * description);
         void renderLegendToggleSetting(char const * setting, char const * description);
@@ -59,7 +64,7 @@ namespace game
         void resizeEvent();
         void cursorEvent(unsigned int x, unsigned int y);
         bool renderText(TextType textType, gameplay::Matrix const & view, gameplay::Vector3 const & position,
-                        char const * setting, char const * message, ...);
+                        char const * setting, char const * text);
         int _textY;
         int _nodeCount;
         int _nodeDepth;
@@ -69,6 +74,7 @@ namespace game
         float _profilerPointSpacingX;
         unsigned int _cursorX;
         unsigned int _selectedProfilerIndex;
+        int _framesSinceLevelLoaded;
         TextType _textType;
         TextType _previousTextType;
         gameplay::FrameBuffer * _frameBuffer;
@@ -78,6 +84,10 @@ namespace game
         gameobjects::Message * _loadMessage;
         gameplay::Rectangle _viewport;
         gameplay::Rectangle _profilerBounds;
+        std::vector<gameplay::Font::TextRun> _screenTextRuns;
+        std::vector<gameplay::Font::TextRun> _worldTextRuns;
+        unsigned int _screenTextRunIndex;
+        unsigned int _worldTextRunIndex;
     };
 }
 
@@ -90,6 +100,7 @@ namespace game
 #define DEBUG_RENDER_TEXT(setting, message) game::Debug::getInstance().renderText(setting, message)
 #define DEBUG_RENDER_TEXT_WITH_ARGS(setting, message, ...) game::Debug::getInstance().renderText(setting, message, __VA_ARGS__)
 #define DEBUG_RENDER_WORLD_TEXT(position, setting, message, ...) game::Debug::getInstance().renderTextWorld(position, setting, message, __VA_ARGS__)
+#define DEBUG_LEVEL_LOADED() game::Debug::getInstance().levelLoaded()
 #else
 #define DEBUG_INITIALIZE()
 #define DEBUG_FINALIZE()
@@ -100,5 +111,6 @@ namespace game
 #define DEBUG_RENDER_TEXT(setting, message, ...)
 #define DEBUG_RENDER_TEXT_WITH_ARGS(setting, message, ...)
 #define DEBUG_RENDER_WORLD_TEXT(position, setting, message, ...)
+#define DEBUG_LEVEL_LOADED()
 #endif
 #endif
@@ -5,12 +5,16 @@
 #include "Game.h"
 #include "GameObject.h"
 #include "Messages.h"
+#include "ProfilerController.h"
 #include "PropertiesRef.h"
 #include "ResourceManager.h"
 #include "SpriteAnimationComponent.h"
 
 namespace game
 {
+    // The number of enemies updated by each job
+    static unsigned int const ENEMY_UPDATE_GRAIN_SIZE = 16;
+
     EnemyComponent::EnemyComponent()
         : _flipFlags(MATH_RANDOM_0_1() > 0.5f ? Sprite::Flip::Horizontal : Sprite::Flip::None)
         , _movementSpeed(5.0f)
@@ -24,6 +28,8 @@ namespace game
         , _respawnTimeSeconds(0.0f)
         , _respawnElapsed(0.0f)
         , _velocityX(0.0f)
+        , _collisionEnabled(true)
+        , _frozen(false)
     {
     }
 
@@ -67,12 +73,6 @@ namespace game
                 onSimulationUpdate(msg._elapsedTime);
                 break;
             }
-            case Messages::Type::PostSimulationUpdate:
-            {
-                PostSimulationUpdateMessage msg(message);
-                onPostSimulationUpdate(msg._elapsedTime);
-                break;
-            }
             default:
                 break;
         }
@@ -90,6 +90,18 @@ namespace game
         gameobjects::setIfExists(properties, "respawn_range_seconds", _respawnTimeRangeSeconds);
     }
 
+    bool EnemyComponent::copyProperties(gameobjects::Component const & prototype)
+    {
+        EnemyComponent const & other = static_cast<EnemyComponent const &>(prototype);
+        _walkAnimComponentId = other._walkAnimComponentId;
+        _deathAnimComponentId = other._deathAnimComponentId;
+        _triggerComponentId = other._triggerComponentId;
+        _movementSpeed = other._movementSpeed;
+        _snapToCollisionY = other._snapToCollisionY;
+        _respawnTimeRangeSeconds = other._respawnTimeRangeSeconds;
+        return true;
+    }
+
     EnemyComponent::State::Enum EnemyComponent::getState() const
     {
         return _state;
@@ -118,6 +130,11 @@ namespace game
 
     void EnemyComponent::onSimulationUpdate(float elapsedTime)
     {
+        if(_frozen)
+        {
+            return;
+        }
+
         _previousPosition = _node->getTranslation();
 
         if(_state != State::Dead)
@@ -144,7 +161,31 @@ namespace game
         }
     }
 
-    void EnemyComponent::onPostSimulationUpdate(float elapsedTime)
+    void EnemyComponent::postSimulationUpdate(std::vector<EnemyComponent *> const & enemies, float elapsedTime)
+    {
+        PROFILE();
+        gameplay::Game::getInstance()->getJobController()->parallelFor(enemies.size(), ENEMY_UPDATE_GRAIN_SIZE, [&enemies, elapsedTime](unsigned int begin, unsigned int end)
+        {
+            for(unsigned int i = begin; i < end; ++i)
+            {
+                if(!enemies[i]->_frozen)
+                {
+                    enemies[i]->updateState(elapsedTime);
+                }
+            }
+        });
+
+        // Enabling collision changes the physics world which can't be done from a job
+        for(EnemyComponent * enemy : enemies)
+        {
+            if(!enemy->_frozen)
+            {
+                enemy->_node->getCollisionObject()->setEnabled(enemy->_collisionEnabled);
+            }
+        }
+    }
+
+    void EnemyComponent::updateState(float elapsedTime)
     {
         float const dt = elapsedTime / 1000.0f;
         bool const isAlive = _state != State::Dead;
@@ -158,7 +199,7 @@ namespace game
         float fadeDirection = isAlive ? 1.0f : -1.0f;
         _alpha = MATH_CLAMP(_alpha + ((dt * fadeSpeed) * fadeDirection), 0, 1.0f);
         bool const isVisibleTarget = _alpha > 0.35f;
-        _node->getCollisionObject()->setEnabled(isVisibleTarget && (isAlive || isRespawnRequired));
+        _collisionEnabled = isVisibleTarget && (isAlive || isRespawnRequired);
     }
 
     SpriteAnimationComponent * EnemyComponent::getCurrentAnimation()
@@ -193,6 +234,21 @@ namespace game
         getCurrentAnimation()->play();
     }
 
+    void EnemyComponent::setFrozen(bool frozen)
+    {
+        _frozen = frozen;
+
+        if(_frozen)
+        {
+            _node->getCollisionObject()->setEnabled(false);
+        }
+    }
+
+    bool EnemyComponent::isFrozen() const
+    {
+        return _frozen;
+    }
+
     bool EnemyComponent::isSnappedToCollisionY() const
     {
         return _snapToCollisionY;
@@ -34,9 +34,21 @@ namespace game
         explicit EnemyComponent();
         ~EnemyComponent();
 
+        /**
+         * Updates the animation and fade of the enemies of a level together, the enemies are updated in jobs and
+         * their collision is enabled or disabled once all of them have been updated.
+        */
+        static void postSimulationUpdate(std::vector<EnemyComponent *> const & enemies, float elapsedTime);
+
         void forEachAnimation(std::function <bool(State::Enum, SpriteAnimationComponent *)> func);
         void setHorizontalConstraints(float minX, float maxX);
         void kill();
+
+        /**
+         * A frozen enemy isn't updated and has no collision, it carries on from the same state once unfrozen
+        */
+        void setFrozen(bool frozen);
+        bool isFrozen() const;
         State::Enum getState() const;
         gameplay::Vector3 getRenderPosition() const;
         gameplay::Vector3 getVelocity() const;
@@ -50,11 +62,13 @@ namespace game
         void finalize() override;
         bool onMessageReceived(gameobjects::Message * message, int messageType) override;
         void onSimulationUpdate(float elapsedTime);
-        void onPostSimulationUpdate(float elapsedTime);
         void readProperties(gameplay::Properties & properties) override;
+        bool copyProperties(gameobjects::Component const & prototype) override;
     private:
         EnemyComponent(EnemyComponent const &);
 
+        void updateState(float elapsedTime);
+
         gameplay::Node * _node;
         std::map<State::Enum, SpriteAnimationComponent*> _animations;
         int _flipFlags;
@@ -67,6 +81,8 @@ namespace game
         float _respawnElapsed;
         float _velocityX;
         bool _snapToCollisionY;
+        bool _collisionEnabled;
+        bool _frozen;
         std::string _walkAnimComponentId;
         std::string _deathAnimComponentId;
         std::string _triggerComponentId;
@@ -0,0 +1,340 @@
+#include "LevelActivationComponent.h"
+
+#include "CameraComponent.h"
+#include "Common.h"
+#include "EnemyComponent.h"
+#include "Game.h"
+#include "GameObject.h"
+#include "LevelLoaderComponent.h"
+#include "LevelPlatformsComponent.h"
+#include "Messages.h"
+#include "PlayerComponent.h"
+#include "ProfilerController.h"
+
+namespace game
+{
+    LevelActivationComponent::LevelActivationComponent()
+        : _enabled(true)
+        , _regionWidthTiles(16.0f)
+        , _paddingTiles(4.0f)
+        , _regionWidth(0.0f)
+        , _padding(0.0f)
+        , _regionCount(0)
+        , _firstActiveRegion(-1)
+        , _lastActiveRegion(-1)
+        , _activeItemCount(0)
+        , _level(nullptr)
+        , _platforms(nullptr)
+        , _camera(nullptr)
+        , _player(nullptr)
+    {
+    }
+
+    LevelActivationComponent::~LevelActivationComponent()
+    {
+    }
+
+    LevelActivationComponent::LevelActivationComponent(LevelActivationComponent const &)
+    {
+    }
+
+    void LevelActivationComponent::readProperties(gameplay::Properties & properties)
+    {
+        gameobjects::setIfExists(properties, "enabled", _enabled);
+        gameobjects::setIfExists(properties, "region_width", _regionWidthTiles);
+        gameobjects::setIfExists(properties, "padding", _paddingTiles);
+    }
+
+    void LevelActivationComponent::initialize()
+    {
+        _level = getParent()->getComponent<LevelLoaderComponent>();
+        _level->addRef();
+        _camera = getRootParent()->getComponent<CameraComponent>();
+        GAME_SAFE_ADD(_camera);
+    }
+
+    void LevelActivationComponent::finalize()
+    {
+        onPreLevelUnloaded();
+        SAFE_RELEASE(_level);
+        SAFE_RELEASE(_camera);
+    }
+
+    bool LevelActivationComponent::onMessageReceived(gameobjects::Message * message, int messageType)
+    {
+        switch(messageType)
+        {
+        case(Messages::Type::LevelLoaded):
+            onPreLevelUnloaded();
+            onLevelLoaded();
+            break;
+        case(Messages::Type::PreLevelUnloaded):
+            onPreLevelUnloaded();
+            break;
+        case(Messages::Type::LevelChunkLoaded):
+            onLevelChunkLoaded(LevelChunkLoadedMessage(message)._chunkIndex);
+            break;
+        case(Messages::Type::PreLevelChunkUnloaded):
+            onPreLevelChunkUnloaded(PreLevelChunkUnloadedMessage(message)._chunkIndex);
+            break;
+        case(Messages::Type::PreSimulationUpdate):
+            onPreSimulationUpdate();
+            break;
+        }
+
+        return true;
+    }
+
+    void LevelActivationComponent::onLevelLoaded()
+    {
+        if(!_enabled)
+        {
+            return;
+        }
+
+        PROFILE();
+
+        float const tileWidth = _level->getTileWidth() * GAME_UNIT_SCALAR;
+        _regionWidth = std::max(_regionWidthTiles, 1.0f) * tileWidth;
+        _padding = _paddingTiles * tileWidth;
+        _regionCount = std::max(static_cast<int>(std::ceil((_level->getWidth() * tileWidth) / _regionWidth)), 1);
+        _player = getParent()->getComponentInChildren<PlayerComponent>();
+        GAME_SAFE_ADD(_player);
+        _platforms = getParent()->getComponentInChildren<LevelPlatformsComponent>();
+        GAME_SAFE_ADD(_platforms);
+
+        Item item;
+        item._node = nullptr;
+        item._enemy = nullptr;
+        item._bridgeIndex = 0;
+        item._minX = 0.0f;
+        item._maxX = 0.0f;
+        item._active = true;
+
+        // Bodies and enemies move about so they are placed by their current position each time the regions change
+        item._type = Item::Type::Body;
+        _level->forEachCachedNode(collision::Type::DYNAMIC, [this, &item](gameplay::Node * node)
+        {
+            item._node = node;
+            _items.push_back(item);
+        });
+
+        item._type = Item::Type::Enemy;
+        item._node = nullptr;
+        for(EnemyComponent * enemy : _level->getEnemies())
+        {
+            item._enemy = enemy;
+            _items.push_back(item);
+        }
+
+        // The segments of a bridge are hinged to each other so they're suspended together, by the span of the bridge
+        item._type = Item::Type::Bridge;
+        item._enemy = nullptr;
+        std::vector<std::vector<gameplay::Node*>> const & bridges = _level->getBridges();
+        for(unsigned int bridgeIndex = 0; bridgeIndex < bridges.size(); ++bridgeIndex)
+        {
+            item._bridgeIndex = bridgeIndex;
+            item._minX = std::numeric_limits<float>::max();
+            item._maxX = -std::numeric_limits<float>::max();
+
+            for(gameplay::Node * segmentNode : bridges[bridgeIndex])
+            {
+                float const x = segmentNode->getTranslationWorld().x;
+                item._minX = std::min(item._minX, x);
+                item._maxX = std::max(item._maxX, x);
+            }
+
+            _items.push_back(item);
+        }
+
+        // Platforms only ever move along their path
+        item._type = Item::Type::Platform;
+        if(_platforms)
+        {
+            _platforms->forEachPlatform([this, &item](gameplay::Node * node, gameplay::Rectangle const & pathBounds)
+            {
+                item._node = node;
+                item._minX = pathBounds.left();
+                item._maxX = pathBounds.right();
+                _items.push_back(item);
+            });
+        }
+
+        _activeItemCount = _items.size();
+        onPreSimulationUpdate();
+    }
+
+    void LevelActivationComponent::onPreLevelUnloaded()
+    {
+        // The bodies, enemies and platforms are destroyed with the level so there is nothing to restore
+        _items.clear();
+        _regionCount = 0;
+        _firstActiveRegion = -1;
+        _lastActiveRegion = -1;
+        _activeItemCount = 0;
+        SAFE_RELEASE(_player);
+        SAFE_RELEASE(_platforms);
+    }
+
+    void LevelActivationComponent::onLevelChunkLoaded(int chunkIndex)
+    {
+        if(_regionCount == 0)
+        {
+            return;
+        }
+
+        // Enemies are spawned with the chunk they start in
+        Item item;
+        item._type = Item::Type::Enemy;
+        item._node = nullptr;
+        item._bridgeIndex = 0;
+        item._minX = 0.0f;
+        item._maxX = 0.0f;
+        item._active = true;
+
+        _level->forEachChunkEnemy(chunkIndex, [this, &item](EnemyComponent * enemy)
+        {
+            item._enemy = enemy;
+            _items.push_back(item);
+            updateItem(_items.back());
+        });
+    }
+
+    void LevelActivationComponent::onPreLevelChunkUnloaded(int chunkIndex)
+    {
+        if(_regionCount == 0)
+        {
+            return;
+        }
+
+        _level->forEachChunkEnemy(chunkIndex, [this](EnemyComponent * enemy)
+        {
+            auto itr = std::find_if(_items.begin(), _items.end(), [enemy](Item const & item) { return item._enemy == enemy; });
+
+            if(itr != _items.end())
+            {
+                _activeItemCount -= itr->_active ? 1 : 0;
+                _items.erase(itr);
+            }
+        });
+    }
+
+    void LevelActivationComponent::onPreSimulationUpdate()
+    {
+        if(_regionCount == 0)
+        {
+            return;
+        }
+
+        // Uses last frame's camera, the padding covers the distance it can travel in a frame
+        float minX = std::numeric_limits<float>::max();
+        float maxX = -std::numeric_limits<float>::max();
+
+        if(_camera)
+        {
+            float const halfViewWidth = (gameplay::Game::getInstance()->getWidth() / 2) * _camera->getZoom();
+            float const cameraX = _camera->getPosition().x;
+            minX = cameraX - halfViewWidth;
+            maxX = cameraX + halfViewWidth;
+        }
+
+        if(_player)
+        {
+            float const playerX = _player->getPosition().x;
+            minX = std::min(minX, playerX);
+            maxX = std::max(maxX, playerX);
+        }
+
+        int const firstActiveRegion = getRegionIndex(minX - _padding);
+        int const lastActiveRegion = getRegionIndex(maxX + _padding);
+
+        if(firstActiveRegion != _firstActiveRegion || lastActiveRegion != _lastActiveRegion)
+        {
+            PROFILE();
+            _firstActiveRegion = firstActiveRegion;
+            _lastActiveRegion = lastActiveRegion;
+            _activeItemCount = 0;
+
+            for(Item & item : _items)
+            {
+                updateItem(item);
+            }
+        }
+    }
+
+    void LevelActivationComponent::updateItem(Item & item)
+    {
+        float minX = item._minX;
+        float maxX = item._maxX;
+
+        if(item._type == Item::Type::Body)
+        {
+            minX = maxX = item._node->getTranslationWorld().x;
+        }
+        else if(item._type == Item::Type::Enemy)
+        {
+            minX = maxX = item._enemy->getNode()->getTranslationWorld().x;
+        }
+
+        bool const active = getRegionIndex(maxX) >= _firstActiveRegion && getRegionIndex(minX) <= _lastActiveRegion;
+
+        if(active != item._active)
+        {
+            setItemActive(item, active);
+        }
+
+        if(active)
+        {
+            ++_activeItemCount;
+        }
+    }
+
+    void LevelActivationComponent::setItemActive(Item & item, bool active)
+    {
+        switch(item._type)
+        {
+        case Item::Type::Body:
+            item._node->getCollisionObject()->setSuspended(!active);
+            break;
+        case Item::Type::Bridge:
+            for(gameplay::Node * segmentNode : _level->getBridges()[item._bridgeIndex])
+            {
+                segmentNode->getCollisionObject()->setSuspended(!active);
+            }
+            break;
+        case Item::Type::Enemy:
+            item._enemy->setFrozen(!active);
+            break;
+        case Item::Type::Platform:
+            _platforms->setActive(item._node, active);
+            break;
+        }
+
+        item._active = active;
+    }
+
+    int LevelActivationComponent::getRegionIndex(float x) const
+    {
+        return MATH_CLAMP(static_cast<int>(std::floor(x / _regionWidth)), 0, _regionCount - 1);
+    }
+
+    int LevelActivationComponent::getRegionCount() const
+    {
+        return _regionCount;
+    }
+
+    int LevelActivationComponent::getActiveRegionCount() const
+    {
+        return _regionCount > 0 ? (_lastActiveRegion - _firstActiveRegion) + 1 : 0;
+    }
+
+    int LevelActivationComponent::getActiveItemCount() const
+    {
+        return _activeItemCount;
+    }
+
+    int LevelActivationComponent::getItemCount() const
+    {
+        return _items.size();
+    }
+}
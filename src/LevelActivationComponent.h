@@ -0,0 +1,89 @@
+#ifndef GAME_LEVEL_ACTIVATION_COMPONENT_H
+#define GAME_LEVEL_ACTIVATION_COMPONENT_H
+
+#include "Component.h"
+
+namespace game
+{
+    class CameraComponent;
+    class EnemyComponent;
+    class LevelLoaderComponent;
+    class LevelPlatformsComponent;
+    class PlayerComponent;
+
+    /**
+     * Splits a level into columns of tiles and only simulates what is in the columns around the camera and player.
+     *
+     * Outside of them dynamic bodies and bridges have their physics suspended, enemies are frozen and moving platforms
+     * stop. Everything is reconsidered only when the camera crosses into another column, so the cost of a frame doesn't
+     * grow with the length of the level.
+     *
+     * @script{ignore}
+    */
+    class LevelActivationComponent : public gameobjects::Component
+    {
+    public:
+        explicit LevelActivationComponent();
+        ~LevelActivationComponent();
+
+        int getRegionCount() const;
+        int getActiveRegionCount() const;
+        int getActiveItemCount() const;
+        int getItemCount() const;
+    protected:
+        virtual void readProperties(gameplay::Properties & properties) override;
+        virtual void initialize() override;
+        virtual void finalize() override;
+        virtual bool onMessageReceived(gameobjects::Message * message, int messageType) override;
+    private:
+        struct Item
+        {
+            struct Type
+            {
+                enum Enum
+                {
+                    Body,
+                    Bridge,
+                    Enemy,
+                    Platform
+                };
+            };
+
+            Type::Enum _type;
+            gameplay::Node * _node;
+            EnemyComponent * _enemy;
+            unsigned int _bridgeIndex;
+            float _minX;
+            float _maxX;
+            bool _active;
+        };
+
+        LevelActivationComponent(LevelActivationComponent const &);
+
+        void onLevelLoaded();
+        void onPreLevelUnloaded();
+        void onLevelChunkLoaded(int chunkIndex);
+        void onPreLevelChunkUnloaded(int chunkIndex);
+        void onPreSimulationUpdate();
+        void updateItem(Item & item);
+        void setItemActive(Item & item, bool active);
+        int getRegionIndex(float x) const;
+
+        bool _enabled;
+        float _regionWidthTiles;
+        float _paddingTiles;
+        float _regionWidth;
+        float _padding;
+        int _regionCount;
+        int _firstActiveRegion;
+        int _lastActiveRegion;
+        int _activeItemCount;
+        std::vector<Item> _items;
+        LevelLoaderComponent * _level;
+        LevelPlatformsComponent * _platforms;
+        CameraComponent * _camera;
+        PlayerComponent * _player;
+    };
+}
+
+#endif
@@ -41,6 +41,15 @@ namespace game
         case(Messages::Type::LevelUnloaded):
             onLevelUnloaded();
             break;
+        case(Messages::Type::LevelChunkLoaded):
+            onLevelChunkLoaded(LevelChunkLoadedMessage(message)._chunkIndex);
+            break;
+        case(Messages::Type::PreLevelChunkUnloaded):
+            onPreLevelChunkUnloaded(PreLevelChunkUnloadedMessage(message)._chunkIndex);
+            break;
+        case(Messages::Type::LevelChunkUnloaded):
+            onLevelChunkUnloaded();
+            break;
         case(Messages::Type::PostSimulationUpdate):
             onPostSimulationUpdate();
             break;
@@ -53,9 +62,10 @@ namespace game
                                       gameplay::PhysicsRigidBody::CollisionListener * listener,
                                       LevelLoaderComponent * level,
                                       gameplay::PhysicsCollisionObject * collisionObject,
-                                      bool add)
+                                      bool add,
+                                      int chunkIndex = -1)
     {
-        level->forEachCachedNode(collisionType, [&add, listener, &collisionObject](gameplay::Node * node)
+        auto addOrRemove = [&add, listener, &collisionObject](gameplay::Node * node)
         {
             if(add)
             {
@@ -66,7 +76,16 @@ namespace game
                 collisionObject->removeCollisionListener(listener, node->getCollisionObject());
             }
 
-        });
+        };
+
+        if(chunkIndex >= 0)
+        {
+            level->forEachChunkNode(chunkIndex, collisionType, addOrRemove);
+        }
+        else
+        {
+            level->forEachCachedNode(collisionType, addOrRemove);
+        }
     }
 
     void LevelCollisionComponent::onLevelLoaded()
@@ -115,6 +134,37 @@ namespace game
         SAFE_RELEASE(_level);
     }
 
+    void LevelCollisionComponent::onLevelChunkLoaded(int chunkIndex)
+    {
+        if(_playerNode)
+        {
+            addOrRemoveCollisionListener(collision::Type::LADDER, _playerCollisionListener, _level, _playerNode->getCollisionObject(), true, chunkIndex);
+            addOrRemoveCollisionListener(collision::Type::RESET, _playerCollisionListener, _level, _playerNode->getCollisionObject(), true, chunkIndex);
+            addOrRemoveCollisionListener(collision::Type::COLLECTABLE, _playerCollisionListener, _level, _playerNode->getCollisionObject(), true, chunkIndex);
+            _collectables.clear();
+            _level->getCollectables(_collectables);
+        }
+    }
+
+    void LevelCollisionComponent::onPreLevelChunkUnloaded(int chunkIndex)
+    {
+        if(_playerNode)
+        {
+            addOrRemoveCollisionListener(collision::Type::LADDER, _playerCollisionListener, _level, _playerNode->getCollisionObject(), false, chunkIndex);
+            addOrRemoveCollisionListener(collision::Type::RESET, _playerCollisionListener, _level, _playerNode->getCollisionObject(), false, chunkIndex);
+            addOrRemoveCollisionListener(collision::Type::COLLECTABLE, _playerCollisionListener, _level, _playerNode->getCollisionObject(), false, chunkIndex);
+        }
+    }
+
+    void LevelCollisionComponent::onLevelChunkUnloaded()
+    {
+        if(_level)
+        {
+            _collectables.clear();
+            _level->getCollectables(_collectables);
+        }
+    }
+
     void LevelCollisionComponent::onPostSimulationUpdate()
     {
         if(_waitForPhysicsCleanup)
@@ -37,6 +37,9 @@ namespace game
 
         void onLevelLoaded();
         void onLevelUnloaded();
+        void onLevelChunkLoaded(int chunkIndex);
+        void onPreLevelChunkUnloaded(int chunkIndex);
+        void onLevelChunkUnloaded();
         void onPostSimulationUpdate();
         void onCharacterCollision(gameplay::Node * enemyNode, gameplay::Vector3 firstNormal);
         void onTerrainCollision(gameplay::PhysicsCollisionObject::CollisionListener::EventType type,
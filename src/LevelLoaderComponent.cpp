@@ -1,7 +1,9 @@
 ﻿#include "LevelLoaderComponent.h"
 
 #include "base64.h"
+#include "CameraComponent.h"
 #include "Common.h"
+#include "Debug.h"
 #include "PhysicsLoaderComponent.h"
 #include "ProfilerController.h"
 #include "EnemyComponent.h"
@@ -9,19 +11,40 @@
 #include "GameObject.h"
 #include "GameObjectController.h"
 #include "LevelPlatformsComponent.h"
+#include "LoadPipeline.h"
 #include "Messages.h"
+#include "PlayerComponent.h"
 #include "PropertiesRef.h"
 #include "ResourceManager.h"
 #include "SpriteSheet.h"
+#include "World.h"
 #include "zlib.h"
 
 namespace game
 {
+    // How often the loading screen is drawn while waiting for the level to be parsed
+    static float const LOAD_OVERLAY_INTERVAL_MS = 1000.0f / 60.0f;
+
     LevelLoaderComponent::LevelLoaderComponent()
         : _loadedMessage(nullptr)
         , _unloadedMessage(nullptr)
         , _preUnloadedMessage(nullptr)
+        , _chunkLoadedMessage(nullptr)
+        , _preChunkUnloadedMessage(nullptr)
+        , _chunkUnloadedMessage(nullptr)
+        , _player(nullptr)
         , _loadBroadcasted(true)
+        , _streamChunks(true)
+        , _chunkWidthTiles(32.0f)
+        , _loadDistanceTiles(16.0f)
+        , _unloadDistanceTiles(32.0f)
+        , _chunkLoadsPerFrame(1)
+        , _chunkColumnCount(0)
+        , _chunkWidth(0.0f)
+        , _collectablesScale(1.0f)
+        , _loadedChunkCount(0)
+        , _arenaBlockSize(0)
+        , _arena(nullptr)
     {
     }
 
@@ -37,17 +60,18 @@ namespace game
             unload();
             break;
         case Messages::PostSimulationUpdate:
-            processLoadRequests();
+            {
+                PostSimulationUpdateMessage postSimulationUpdate(message);
+                EnemyComponent::postSimulationUpdate(_enemies, postSimulationUpdate._elapsedTime);
+                processLoadRequests();
+            }
             break;
         case Messages::Type::ScreenFadeStateChanged:
             {
                 ScreenFadeStateChangedMessage fadeActive(message);
                 if (!fadeActive._isActive)
                 {
-                    forEachCachedNode(collision::Type::DYNAMIC, [](gameplay::Node * node)
-                    {
-                        node->getCollisionObject()->setEnabled(true);
-                    });
+                    enableDynamicCollision();
                 }
             }
             break;
@@ -73,19 +97,56 @@ namespace game
 
     void LevelLoaderComponent::processLoadRequests()
     {
+        // Loading creates textures, a world stepped in a job loads once it is back on the main thread
+        if(gameplay::JobController::isWorkerThread())
+        {
+            return;
+        }
+
         if(!_loadBroadcasted)
         {
             unload();
+
+            // The level file is parsed on a worker while the resources it uses are loaded
+            beginLoad();
+
+            // Which resources stay resident follows the level the player is in
+            if(!World::getCurrent().isHeadless())
+            {
+                ResourceManager::getInstance().loadLevelResources(_level);
+            }
+
             load();
             _loadBroadcasted = true;
+
+            // There is no screen fade to wait for in a headless world
+            if(World::getCurrent().isHeadless())
+            {
+                enableDynamicCollision();
+            }
+        }
+        else
+        {
+            streamChunks(false);
         }
     }
 
+    void LevelLoaderComponent::enableDynamicCollision()
+    {
+        forEachCachedNode(collision::Type::DYNAMIC, [](gameplay::Node * node)
+        {
+            node->getCollisionObject()->setEnabled(true);
+        });
+    }
+
     void LevelLoaderComponent::initialize()
     {
         _loadedMessage = LevelLoadedMessage::create();
         _unloadedMessage = LevelUnloadedMessage::create();
         _preUnloadedMessage = PreLevelUnloadedMessage::create();
+        _chunkLoadedMessage = LevelChunkLoadedMessage::create();
+        _preChunkUnloadedMessage = PreLevelChunkUnloadedMessage::create();
+        _chunkUnloadedMessage = LevelChunkUnloadedMessage::create();
     }
 
     void LevelLoaderComponent::finalize()
@@ -94,15 +155,19 @@ namespace game
         gameobjects::Message::destroy(&_loadedMessage);
         gameobjects::Message::destroy(&_unloadedMessage);
         gameobjects::Message::destroy(&_preUnloadedMessage);
+        gameobjects::Message::destroy(&_chunkLoadedMessage);
+        gameobjects::Message::destroy(&_preChunkUnloadedMessage);
+        gameobjects::Message::destroy(&_chunkUnloadedMessage);
     }
 
-    void LevelLoaderComponent::loadTerrain(gameplay::Properties * layerNamespace)
+    void inflateTiles(std::string const & compressedData, int width, int height, std::function<void(int, int, int)> const & func)
     {
+        // Inflated a block at a time and handed on rather than kept, so decoding a chunk doesn't hold the whole grid
         int zlibErr;
         unsigned const int bufferSize = 4096;
-        char buffer[bufferSize];
-        std::string decompressedData;
-        std::string compressedData = base64_decode(layerNamespace->getString("data"));
+        unsigned char buffer[bufferSize];
+        std::array<unsigned char, 4> tileBytes;
+        unsigned int tileByteCount = 0;
         z_stream zStream;
         zStream.zalloc = Z_NULL;
         zStream.zfree = Z_NULL;
@@ -113,7 +178,12 @@ namespace game
         if ((zlibErr = inflateInit(&zStream)) != Z_OK)
         {
             GAME_ASSERTFAIL("ZLIB inflateInit failed. Error: %d.", zlibErr);
+            return;
         }
+
+        int x = 0;
+        int y = 0;
+
         do
         {
             zStream.next_out = (Bytef*)buffer;
@@ -126,41 +196,45 @@ namespace game
                 case Z_MEM_ERROR:
                     inflateEnd(&zStream);
                     GAME_ASSERTFAIL("ZLIB inflateInit failed. Error: %d.", zlibErr);
-                    break;
+                    return;
             }
 
-            std::string decomBlock(buffer, bufferSize - zStream.avail_out);
-            decompressedData += decomBlock;
-        } while (zlibErr != Z_STREAM_END);
-
-        inflateEnd(&zStream);
-        size_t byteDataSize = decompressedData.size();
-
-        int x = 0;
-        int y = 0;
-        for (unsigned int i = 0; i < byteDataSize; i += 4)
-        {
-            unsigned int const tileId = static_cast<unsigned char>(decompressedData[i + 0]) |
-                (static_cast<unsigned char>(decompressedData[i + 1]) << 8u) |
-                (static_cast<unsigned char>(decompressedData[i + 2]) << 16u) |
-                (static_cast<unsigned char>(decompressedData[i + 3]) << 24u);
+            unsigned int const inflatedSize = bufferSize - zStream.avail_out;
 
-            _grid[y][x]._tileId = tileId;
-            ++x;
-            if (x == _width)
+            for (unsigned int i = 0; i < inflatedSize; ++i)
             {
-                x = 0;
-                ++y;
-                if (y == _height)
+                tileBytes[tileByteCount++] = buffer[i];
+
+                if (tileByteCount == tileBytes.size())
                 {
-                    x = 0;
-                    y = 0;
+                    tileByteCount = 0;
+                    unsigned int const tileId = tileBytes[0] | (tileBytes[1] << 8u) | (tileBytes[2] << 16u) | (tileBytes[3] << 24u);
+                    func(x, y, tileId);
+                    ++x;
+                    if (x == width)
+                    {
+                        x = 0;
+                        ++y;
+                        if (y == height)
+                        {
+                            x = 0;
+                            y = 0;
+                        }
+                    }
                 }
             }
-        }
+        } while (zlibErr != Z_STREAM_END);
+
+        inflateEnd(&zStream);
     }
 
-    void LevelLoaderComponent::loadCharacters(gameplay::Properties * layerNamespace)
+    void LevelLoaderComponent::decodeTerrain(gameplay::Properties * layerNamespace)
+    {
+        // Kept compressed, the tiles of a chunk are inflated from it when the chunk is loaded
+        _terrainData.push_back(base64_decode(layerNamespace->getString("data")));
+    }
+
+    void LevelLoaderComponent::loadCharacters(gameplay::Properties * layerNamespace, std::vector<ChunkSpawn> & spawnsOut)
     {
         if (gameplay::Properties * objectsNamespace = layerNamespace->getNamespace("objects", true))
         {
@@ -170,20 +244,13 @@ namespace game
             {
                 char const * gameObjectTypeName = objectNamespace->getString("name");
                 bool const isPlayer = strcmp(gameObjectTypeName, "player") == 0;
+                gameplay::Rectangle boumds = getObjectBounds(objectNamespace);
+                gameplay::Vector3 spawnPos(boumds.x, boumds.y, 0.0f);
 
-#ifndef _FINAL
-                if (getConfig()->getBool("spawn_enemies") || isPlayer)
-#endif
+                if (isPlayer)
                 {
+                    _playerSpawnPosition = spawnPos;
                     gameobjects::GameObject * gameObject = gameobjects::GameObjectController::getInstance().createGameObject(gameObjectTypeName, getParent());
-                    gameplay::Rectangle boumds = getObjectBounds(objectNamespace);
-                    gameplay::Vector3 spawnPos(boumds.x, boumds.y, 0.0f);
-
-                    if (isPlayer)
-                    {
-                        _playerSpawnPosition = spawnPos;
-                    }
-
                     std::vector<PhysicsLoaderComponent*> collisionComponents;
                     gameObject->getComponents(collisionComponents);
 
@@ -194,6 +261,20 @@ namespace game
 
                     _children.push_back(gameObject);
                 }
+#ifndef _FINAL
+                else if (getConfig()->getBool("spawn_enemies"))
+#else
+                else
+#endif
+                {
+                    // Spawned with the chunk they start in
+                    ChunkSpawn spawn;
+                    spawn._typeName = gameObjectTypeName;
+                    spawn._position = spawnPos;
+                    spawn._hasBounds = false;
+                    spawn._dead = false;
+                    spawnsOut.push_back(spawn);
+                }
             }
 
             objectsNamespace->rewind();
@@ -228,6 +309,13 @@ namespace game
     gameplay::Node * LevelLoaderComponent::createCollisionObject(collision::Type::Enum collisionType, gameplay::Properties * collisionProperties, gameplay::Rectangle const & bounds, float rotationZ)
     {
         std::string const name = std::string(collisionProperties->getId()) + "_" + toString(_collisionNodes[collisionType].size());
+        gameplay::Node * node = createCollisionNode(name, collisionType, collisionProperties, bounds, rotationZ);
+        _collisionNodes[collisionType].push_back(node);
+        return node;
+    }
+
+    gameplay::Node * LevelLoaderComponent::createCollisionNode(std::string const & name, collision::Type::Enum collisionType, gameplay::Properties * collisionProperties, gameplay::Rectangle const & bounds, float rotationZ)
+    {
         gameplay::Node * node = gameplay::Node::create(name.c_str());
         collision::NodeData * info = new collision::NodeData();
         info->_type = collisionType;
@@ -237,10 +325,18 @@ namespace game
         getParent()->getNode()->addChild(node);
         node->setScale(bounds.width, bounds.height, 1.0f);
         node->setCollisionObject(collisionProperties);
-        _collisionNodes[collisionType].push_back(node);
         return node;
     }
 
+    void LevelLoaderComponent::destroyCollisionNode(gameplay::Node * node)
+    {
+        collision::NodeData * info = collision::NodeData::get(node);
+        node->setUserObject(nullptr);
+        SAFE_RELEASE(info);
+        getParent()->getNode()->removeChild(node);
+        SAFE_RELEASE(node);
+    }
+
     void setProperty(char const * id, gameplay::Vector3 const & vec, gameplay::Properties * properties)
     {
         std::array<char, 255> buffer;
@@ -310,8 +406,16 @@ namespace game
                     bounds.y -= bounds.height / 2;
                 }
 
-                setProperty("extents", gameplay::Vector3(bounds.width, bounds.height, 1), collisionProperties);
-                createCollisionObject(collisionType, collisionProperties, bounds, rotationZ);
+                // Water stays resident, the renderer bakes it into the tile map when the level loads
+                if(collisionType != collision::Type::WATER)
+                {
+                    addChunkObject(collisionType, collisionPropertiesRef, bounds, rotationZ);
+                }
+                else
+                {
+                    setProperty("extents", gameplay::Vector3(bounds.width, bounds.height, 1), collisionProperties);
+                    createCollisionObject(collisionType, collisionProperties, bounds, rotationZ);
+                }
             }
 
             objectsNamespace->rewind();
@@ -436,7 +540,6 @@ namespace game
         {
             SpriteSheet * spriteSheet = ResourceManager::getInstance().getSpriteSheet("res/spritesheets/collectables.ss");
             gameplay::PropertiesRef * collisionPropertiesRef = ResourceManager::getInstance().getProperties("res/physics/level.physics#collectable");
-            gameplay::Properties * collisionProperties = collisionPropertiesRef->get();
             std::vector<Sprite> sprites;
 
             spriteSheet->forEachSprite([&sprites](Sprite const & sprite)
@@ -467,19 +570,7 @@ namespace game
 
                         if(lineLength > 0)
                         {
-                            std::array<char, 255> extentsBuffer;
-                            sprintf(&extentsBuffer[0], "%f, %f, 1", collectableWidth, collectableWidth);
-                            collisionProperties->setString("extents", &extentsBuffer[0]);
-                            gameplay::Rectangle bounds(position.x, position.y, collectableWidth, collectableWidth);
-                            gameplay::Node * collectableNode = createCollisionObject(collision::Type::COLLECTABLE, collisionProperties, bounds);
-                            collectableNode->addRef();
-                            Collectable collectable;
-                            collectable._src = sprite._src;
-                            collectable._node = collectableNode;
-                            collectable._startPosition = collectableNode->getTranslation();
-                            collectable._active = true;
-                            collectable._visible = false;
-                            _collectables[collectableNode] = collectable;
+                            addChunkObject(collision::Type::COLLECTABLE, collisionPropertiesRef, gameplay::Rectangle(position.x, position.y, collectableWidth, collectableWidth), 0.0f, sprite._src);
                             float const padding = 1.25f;
                             position += direction * (collectableWidth * padding);
                         }
@@ -534,6 +625,8 @@ namespace game
                         bounds.y -= bridgeDirection.y * bounds.width;
                     }
 
+                    _bridges.push_back(segmentNodes);
+
                     // Link them to each other and the end pieces with the world
                     for (int segmentIndex = 0; segmentIndex < numSegments; ++segmentIndex)
                     {
@@ -568,35 +661,409 @@ namespace game
         }
     }
 
-    void LevelLoaderComponent::load()
+    void LevelLoaderComponent::createChunks()
+    {
+        // Without streaming the whole level is a single chunk which is loaded with it
+        _chunkColumnCount = _streamChunks ? std::max(static_cast<int>(_chunkWidthTiles), 1) : std::max(_width, 1);
+        _chunkWidth = _chunkColumnCount * _tileWidth * GAME_UNIT_SCALAR;
+        int const chunkCount = std::max((_width + _chunkColumnCount - 1) / _chunkColumnCount, 1);
+        _chunks.resize(chunkCount);
+
+        for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+        {
+            Chunk & chunk = _chunks[chunkIndex];
+            chunk._firstColumn = chunkIndex * _chunkColumnCount;
+            chunk._columnCount = std::max(std::min(_chunkColumnCount, _width - chunk._firstColumn), 0);
+            chunk._minX = chunkIndex * _chunkWidth;
+            chunk._maxX = (chunkIndex + 1) * _chunkWidth;
+            chunk._loaded = false;
+            chunk._loading = false;
+        }
+    }
+
+    int LevelLoaderComponent::getChunkIndex(float x) const
+    {
+        if (_chunks.empty())
+        {
+            return -1;
+        }
+
+        return MATH_CLAMP(static_cast<int>(std::floor(x / _chunkWidth)), 0, static_cast<int>(_chunks.size()) - 1);
+    }
+
+    void LevelLoaderComponent::addChunkObject(collision::Type::Enum collisionType, gameplay::PropertiesRef * collisionPropertiesRef, gameplay::Rectangle const & bounds, float rotationZ, gameplay::Rectangle const & src)
+    {
+        // Objects belong to the chunk their left edge is in, the chunk is widened to cover any that reach past it
+        float const halfWidth = bounds.width / 2;
+        int const chunkIndex = getChunkIndex(bounds.x - halfWidth);
+
+        if (chunkIndex < 0)
+        {
+            return;
+        }
+
+        if (_chunkCollisionProperties.find(collisionType) == _chunkCollisionProperties.end())
+        {
+            collisionPropertiesRef->addRef();
+            _chunkCollisionProperties[collisionType] = collisionPropertiesRef;
+        }
+
+        ChunkObject object;
+        object._type = collisionType;
+        object._bounds = bounds;
+        object._rotationZ = rotationZ;
+        object._src = src;
+        object._collected = false;
+
+        Chunk & chunk = _chunks[chunkIndex];
+        chunk._minX = std::min(chunk._minX, bounds.x - halfWidth);
+        chunk._maxX = std::max(chunk._maxX, bounds.x + halfWidth);
+        chunk._objects.push_back(object);
+    }
+
+    void LevelLoaderComponent::addChunkSpawns(std::vector<ChunkSpawn> const & spawns)
+    {
+        float const margin = _tileWidth * GAME_UNIT_SCALAR;
+
+        for (ChunkSpawn spawn : spawns)
+        {
+            int const chunkIndex = getChunkIndex(spawn._position.x);
+
+            if (chunkIndex < 0)
+            {
+                return;
+            }
+
+            float nearestDistance = std::numeric_limits<float>::max();
+
+            for (gameplay::Rectangle const & characterBound : _characterBounds)
+            {
+                gameplay::Vector3 const boundPosition(characterBound.x, characterBound.y, 0);
+                float const distance = boundPosition.distanceSquared(spawn._position);
+
+                if (distance < nearestDistance)
+                {
+                    spawn._bounds = characterBound;
+                    spawn._hasBounds = true;
+                    nearestDistance = distance;
+                }
+            }
+
+            // Enemies patrol their character bounds so the chunk covers them, keeping it loaded while they can be seen
+            Chunk & chunk = _chunks[chunkIndex];
+            chunk._minX = std::min(chunk._minX, spawn._position.x - margin);
+            chunk._maxX = std::max(chunk._maxX, spawn._position.x + margin);
+
+            if (spawn._hasBounds)
+            {
+                chunk._minX = std::min(chunk._minX, spawn._bounds.x - margin);
+                chunk._maxX = std::max(chunk._maxX, spawn._bounds.x + spawn._bounds.width + margin);
+            }
+
+            chunk._spawns.push_back(spawn);
+        }
+    }
+
+    void LevelLoaderComponent::requestChunk(int chunkIndex, bool broadcast)
+    {
+        _chunks[chunkIndex]._loading = true;
+
+        // The tiles are decoded on the worker, nodes, bodies and game objects have to be created on this thread
+        _pipeline->add([this, chunkIndex]()
+        {
+            decodeChunkTiles(chunkIndex);
+        },
+        [this, chunkIndex, broadcast]()
+        {
+            loadChunk(chunkIndex);
+
+            if (broadcast)
+            {
+                LevelChunkLoadedMessage::set(_chunkLoadedMessage, chunkIndex);
+                getRootParent()->broadcastMessage(_chunkLoadedMessage);
+            }
+        });
+    }
+
+    void LevelLoaderComponent::decodeChunkTiles(int chunkIndex)
+    {
+        // Only the tiles of the chunk are written, which isn't read by this thread until it has loaded
+        Chunk & chunk = _chunks[chunkIndex];
+        int const firstColumn = chunk._firstColumn;
+        int const columnCount = chunk._columnCount;
+        std::vector<int> & tiles = chunk._tiles;
+        tiles.assign(columnCount * _height, EMPTY_TILE);
+
+        for (std::string const & compressedData : _terrainData)
+        {
+            // Later layers overwrite the tiles of earlier ones
+            inflateTiles(compressedData, _width, _height, [&tiles, firstColumn, columnCount](int x, int y, int tileId)
+            {
+                if (x >= firstColumn && x < firstColumn + columnCount)
+                {
+                    tiles[(y * columnCount) + (x - firstColumn)] = tileId;
+                }
+            });
+        }
+    }
+
+    void LevelLoaderComponent::loadChunk(int chunkIndex)
     {
         PROFILE();
+        gameplay::Arena::Scope arenaScope(_arena);
+        Chunk & chunk = _chunks[chunkIndex];
+        chunk._nodes.reserve(chunk._objects.size());
 
-        getParent()->getNode()->setId(_level.c_str());
-        gameplay::PropertiesRef * rootRef = ResourceManager::getInstance().getProperties(_level.c_str());
-        gameplay::Properties * root = rootRef->get();
-        float collectablesScale = 1.0f;
+        for (ChunkObject const & object : chunk._objects)
+        {
+            gameplay::Properties * collisionProperties = _chunkCollisionProperties[object._type]->get();
+            std::string const name = std::string(collisionProperties->getId()) + "_" + toString(chunkIndex) + "_" + toString(chunk._nodes.size());
+            setProperty("extents", gameplay::Vector3(object._bounds.width, object._bounds.height, 1), collisionProperties);
+            gameplay::Node * node = createCollisionNode(name, object._type, collisionProperties, object._bounds, object._rotationZ);
+            chunk._nodes.push_back(node);
+
+            if (object._type == collision::Type::COLLECTABLE)
+            {
+                Collectable collectable;
+                collectable._src = object._src;
+                collectable._node = node;
+                collectable._startPosition = node->getTranslation();
+                collectable._active = !object._collected;
+                collectable._visible = false;
+                _collectables[node] = collectable;
+                node->getCollisionObject()->setEnabled(collectable._active);
+            }
+        }
+
+        chunk._gameObjects.reserve(chunk._spawns.size());
+
+        for (ChunkSpawn const & spawn : chunk._spawns)
+        {
+            gameobjects::GameObject * gameObject = nullptr;
+
+            // Enemies that were killed stay dead when their chunk is loaded again
+            if (!spawn._dead)
+            {
+                gameObject = gameobjects::GameObjectController::getInstance().createGameObject(spawn._typeName.c_str(), getParent());
+                std::vector<PhysicsLoaderComponent*> collisionComponents;
+                gameObject->getComponents(collisionComponents);
+
+                for (PhysicsLoaderComponent * collisionComponent : collisionComponents)
+                {
+                    collisionComponent->getNode()->setTranslation(spawn._position.x, spawn._position.y, 0);
+                }
+
+                if (EnemyComponent * enemyComponent = gameObject->getComponent<EnemyComponent>())
+                {
+                    placeEnemy(enemyComponent, spawn);
+                    _enemies.push_back(enemyComponent);
+                }
+            }
+
+            chunk._gameObjects.push_back(gameObject);
+        }
+
+        chunk._loaded = true;
+        chunk._loading = false;
+        ++_loadedChunkCount;
+    }
+
+    void LevelLoaderComponent::unloadChunk(int chunkIndex)
+    {
+        PROFILE();
+        Chunk & chunk = _chunks[chunkIndex];
+
+        for (unsigned int i = 0; i < chunk._nodes.size(); ++i)
+        {
+            gameplay::Node * node = chunk._nodes[i];
+
+            // Collectables that were picked up stay that way when their chunk is loaded again
+            if (chunk._objects[i]._type == collision::Type::COLLECTABLE)
+            {
+                auto itr = _collectables.find(node);
+                chunk._objects[i]._collected = !itr->second._active;
+                _collectables.erase(itr);
+            }
+
+            destroyCollisionNode(node);
+        }
+
+        for (unsigned int i = 0; i < chunk._gameObjects.size(); ++i)
+        {
+            if (gameobjects::GameObject * gameObject = chunk._gameObjects[i])
+            {
+                if (EnemyComponent * enemyComponent = gameObject->getComponent<EnemyComponent>())
+                {
+                    chunk._spawns[i]._dead = enemyComponent->getState() == EnemyComponent::State::Dead;
+                    _enemies.erase(std::remove(_enemies.begin(), _enemies.end(), enemyComponent), _enemies.end());
+                }
+
+                gameobjects::GameObjectController::getInstance().destroyGameObject(gameObject);
+            }
+        }
+
+        chunk._nodes.clear();
+        chunk._gameObjects.clear();
+        chunk._tiles.clear();
+        chunk._tiles.shrink_to_fit();
+        chunk._loaded = false;
+        --_loadedChunkCount;
+    }
+
+    void LevelLoaderComponent::streamChunks(bool immediate)
+    {
+        if (!_pipeline || _chunks.empty() || (!_streamChunks && !immediate))
+        {
+            return;
+        }
+
+        // Completes the chunks whose tiles have been decoded since the last frame
+        _pipeline->update();
+
+        // The camera can't be further than half a screen from the player, so this covers the view at any zoom
+        float const playerX = _player ? _player->getPosition().x : _playerSpawnPosition.x;
+        float const tileWidth = _tileWidth * GAME_UNIT_SCALAR;
+        float const viewExtent = (gameplay::Game::getInstance()->getWidth() / 2) * CameraComponent::getMaxZoom();
+        float const loadExtent = viewExtent + _loadDistanceTiles * tileWidth;
+        float const unloadExtent = viewExtent + std::max(_unloadDistanceTiles, _loadDistanceTiles) * tileWidth;
+        int const chunkCount = _chunks.size();
+        int loadingCount = 0;
+        bool wait = immediate;
+
+        auto getDistance = [playerX](Chunk const & chunk)
+        {
+            return std::max(std::max(chunk._minX - playerX, playerX - chunk._maxX), 0.0f);
+        };
 
-        if (gameplay::Properties * propertiesNamespace = root->getNamespace("properties", true, false))
+        // Chunks in view are waited on, such as after the player is reset, the rest are decoded in the background
+        for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+        {
+            Chunk const & chunk = _chunks[chunkIndex];
+            float const distance = getDistance(chunk);
+
+            if (chunk._loaded && distance > unloadExtent)
+            {
+                PreLevelChunkUnloadedMessage::set(_preChunkUnloadedMessage, chunkIndex);
+                getRootParent()->broadcastMessage(_preChunkUnloadedMessage);
+                unloadChunk(chunkIndex);
+                LevelChunkUnloadedMessage::set(_chunkUnloadedMessage, chunkIndex);
+                getRootParent()->broadcastMessage(_chunkUnloadedMessage);
+            }
+            else if (!chunk._loaded && !chunk._loading && (distance <= viewExtent || (immediate && distance <= loadExtent)))
+            {
+                requestChunk(chunkIndex, !immediate);
+            }
+
+            if (chunk._loading)
+            {
+                ++loadingCount;
+                wait |= distance <= viewExtent;
+            }
+        }
+
+        while (loadingCount < _chunkLoadsPerFrame)
+        {
+            int nearestChunkIndex = -1;
+            float nearestDistance = loadExtent;
+
+            for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+            {
+                Chunk const & chunk = _chunks[chunkIndex];
+                float const distance = getDistance(chunk);
+
+                if (!chunk._loaded && !chunk._loading && distance <= nearestDistance)
+                {
+                    nearestChunkIndex = chunkIndex;
+                    nearestDistance = distance;
+                }
+            }
+
+            if (nearestChunkIndex < 0)
+            {
+                break;
+            }
+
+            requestChunk(nearestChunkIndex, !immediate);
+            ++loadingCount;
+        }
+
+        if (wait)
+        {
+            _pipeline->finish(nullptr, LOAD_OVERLAY_INTERVAL_MS);
+        }
+    }
+
+    void LevelLoaderComponent::beginLoad()
+    {
+        // A single worker keeps the level from competing with the frame for CPU time once it's loaded
+        _pipeline.reset(new LoadPipeline(std::min(1u, LoadPipeline::getDefaultWorkerCount())));
+        _pipeline->add([this]()
+        {
+            parse();
+        }, nullptr);
+    }
+
+    void LevelLoaderComponent::parse()
+    {
+        // Runs on the worker, the level isn't read by anything else until load() has waited for it
+        _root.reset(gameplay::Properties::create(_level.c_str()));
+
+        if (!_root)
+        {
+            return;
+        }
+
+        _collectablesScale = 1.0f;
+
+        if (gameplay::Properties * propertiesNamespace = _root->getNamespace("properties", true, false))
         {
             _texturePath = propertiesNamespace->getString("texture");
             if (propertiesNamespace->exists("collectable_scale"))
             {
-                collectablesScale = propertiesNamespace->getFloat("collectable_scale");
+                _collectablesScale = propertiesNamespace->getFloat("collectable_scale");
             }
         }
 
-        _width = root->getInt("width");
-        _height = root->getInt("height");
-        _tileWidth = root->getInt("tilewidth");
-        _tileHeight = root->getInt("tileheight");
-        _grid.resize(_height);
-        
-        for (std::vector<Tile> & horizontalTiles : _grid)
+        _width = _root->getInt("width");
+        _height = _root->getInt("height");
+        _tileWidth = _root->getInt("tilewidth");
+        _tileHeight = _root->getInt("tileheight");
+        createChunks();
+
+        if (gameplay::Properties * layersNamespace = _root->getNamespace("layers", true))
         {
-            horizontalTiles.resize(_width);
+            while (gameplay::Properties * layerNamespace = layersNamespace->getNextNamespace())
+            {
+                std::string const layerName = layerNamespace->getString("name");
+
+                if (layerName == "terrain" || layerName == "props")
+                {
+                    decodeTerrain(layerNamespace);
+                }
+            }
+
+            layersNamespace->rewind();
         }
+    }
+
+    void LevelLoaderComponent::load()
+    {
+        PROFILE();
+
+        // Keeps drawing the loading screen if the level is still being parsed once its resources have loaded
+        _pipeline->finish([]()
+        {
+            STALL_SCOPE();
+        }, LOAD_OVERLAY_INTERVAL_MS);
+
+        GAME_ASSERT(_root, "Failed to load level '%s'", _level.c_str());
+
+        // The nodes, their collision data and the components of the level share its lifetime so they're allocated together
+        _arena = gameplay::Arena::create(_arenaBlockSize);
+        gameplay::Arena::Scope arenaScope(_arena);
 
+        getParent()->getNode()->setId(_level.c_str());
+        gameplay::Properties * root = _root.get();
         std::vector<gameplay::Properties*> characterProperties;
 
         if (gameplay::Properties * layersNamespace = root->getNamespace("layers", true))
@@ -605,11 +1072,7 @@ namespace game
             {
                 std::string const layerName = layerNamespace->getString("name");
 
-                if (layerName == "terrain" || layerName == "props")
-                {
-                    loadTerrain(layerNamespace);
-                }
-                else if (layerName == "characters")
+                if (layerName == "characters")
                 {
                     characterProperties.push_back(layerNamespace);
                 }
@@ -667,67 +1130,54 @@ namespace game
 #ifndef _FINAL
                     if (getConfig()->getBool("spawn_collectables"))
 #endif
-                        loadCollectables(layerNamespace, collectablesScale);
+                        loadCollectables(layerNamespace, _collectablesScale);
                 }
             }
 
             layersNamespace->rewind();
         }
 
+        std::vector<ChunkSpawn> spawns;
+
         for (gameplay::Properties * properties : characterProperties)
         {
-            loadCharacters(properties);
+            loadCharacters(properties, spawns);
         }
 
-        placeEnemies();
-        root->rewind();
-        SAFE_RELEASE(rootRef);
+        addChunkSpawns(spawns);
+        _player = getParent()->getComponentInChildren<PlayerComponent>();
+        streamChunks(true);
+
+        // Only the compressed tiles are kept to decode chunks from
+        _root.reset();
         getRootParent()->broadcastMessage(_loadedMessage);
+        DEBUG_LEVEL_LOADED();
     }
 
-    void LevelLoaderComponent::placeEnemies()
+    void LevelLoaderComponent::placeEnemy(EnemyComponent * enemyComponent, ChunkSpawn const & spawn)
     {
-        for(gameobjects::GameObject * gameObject : _children)
+        if(spawn._hasBounds)
         {
-            if(EnemyComponent * enemyComponent = gameObject->getComponent<EnemyComponent>())
+            if (enemyComponent->isSnappedToCollisionY())
             {
-                gameplay::Rectangle * nearestCharacterBound = nullptr;
-                float nearestDistance = std::numeric_limits<float>::max();
-                gameplay::Vector3 const & enemyPosition = enemyComponent->getNode()->getTranslation();
-
-                for (gameplay::Rectangle & characterBound : _characterBounds)
-                {
-                    gameplay::Vector3 const boundPosition(characterBound.x, characterBound.y, 0);
-                    float const distance = boundPosition.distanceSquared(enemyPosition);
-
-                    if (distance < nearestDistance)
-                    {
-                        nearestCharacterBound = &characterBound;
-                        nearestDistance = distance;
-                    }
-                }
-
-                if(nearestCharacterBound)
-                {
-                    if (enemyComponent->isSnappedToCollisionY())
-                    {
-                        enemyComponent->getNode()->setTranslationY(nearestCharacterBound->y + enemyComponent->getNode()->getScaleY() / 2);
-                    }
-
-                    enemyComponent->setHorizontalConstraints(nearestCharacterBound->x - (enemyComponent->getNode()->getScaleX() / 2),
-                                                    nearestCharacterBound->x + nearestCharacterBound->width + (enemyComponent->getNode()->getScaleX() / 2));
-                }
-                else
-                {
-                    GAME_ASSERTFAIL("Unable to place %s", enemyComponent->getId().c_str());
-                }
+                enemyComponent->getNode()->setTranslationY(spawn._bounds.y + enemyComponent->getNode()->getScaleY() / 2);
             }
+
+            enemyComponent->setHorizontalConstraints(spawn._bounds.x - (enemyComponent->getNode()->getScaleX() / 2),
+                                            spawn._bounds.x + spawn._bounds.width + (enemyComponent->getNode()->getScaleX() / 2));
+        }
+        else
+        {
+            GAME_ASSERTFAIL("Unable to place %s", enemyComponent->getId().c_str());
         }
     }
 
     void LevelLoaderComponent::unload()
     {
         PROFILE();
+
+        // Waits for the worker, chunks it was decoding are dropped along with the rest of the level
+        _pipeline.reset();
         getRootParent()->broadcastMessage(_preUnloadedMessage);
 
         for (auto & listPair : _collisionNodes)
@@ -735,31 +1185,38 @@ namespace game
             for (gameplay::Node* node : listPair.second)
             {
                 STALL_SCOPE();
-                collision::NodeData * info = collision::NodeData::get(node);
-                node->setUserObject(nullptr);
-                SAFE_RELEASE(info);
                 if (listPair.first == collision::Type::KINEMATIC)
                 {
                     gameplay::Node * parent = node->getParent();
                     SAFE_RELEASE(parent);
                 }
                 
-                getParent()->getNode()->removeChild(node);
-                SAFE_RELEASE(node);
+                destroyCollisionNode(node);
             }
         }
 
-        for(auto & collectablePair : _collectables)
+        for (int chunkIndex = 0; chunkIndex < static_cast<int>(_chunks.size()); ++chunkIndex)
         {
-            STALL_SCOPE();
-            getParent()->getNode()->removeChild(collectablePair.second._node);
-            SAFE_RELEASE(collectablePair.second._node);
+            if (_chunks[chunkIndex]._loaded)
+            {
+                STALL_SCOPE();
+                unloadChunk(chunkIndex);
+            }
+        }
+
+        for (auto & propertiesPair : _chunkCollisionProperties)
+        {
+            SAFE_RELEASE(propertiesPair.second);
         }
 
+        _chunks.clear();
+        _chunkCollisionProperties.clear();
+        _player = nullptr;
         _collectables.clear();
         _collisionNodes.clear();
         _characterBounds.clear();
-        _grid.clear();
+        _terrainData.clear();
+        _root.reset();
 
         for(auto childItr = _children.begin(); childItr != _children.end(); ++childItr)
         {
@@ -768,8 +1225,17 @@ namespace game
         }
 
         _children.clear();
+        _enemies.clear();
+        _bridges.clear();
 
         getRootParent()->broadcastMessage(_unloadedMessage);
+
+        if (_arena)
+        {
+            // Released once game objects whose removal was deferred have been destroyed
+            _arena->retire();
+            _arena = nullptr;
+        }
     }
 
     void LevelLoaderComponent::readProperties(gameplay::Properties & properties)
@@ -778,6 +1244,21 @@ namespace game
         {
             _level = properties.getString("level");
         }
+
+        gameobjects::setIfExists(properties, "stream_chunks", _streamChunks);
+        gameobjects::setIfExists(properties, "chunk_width", _chunkWidthTiles);
+        gameobjects::setIfExists(properties, "load_distance", _loadDistanceTiles);
+        gameobjects::setIfExists(properties, "unload_distance", _unloadDistanceTiles);
+
+        if(properties.exists("chunk_loads_per_frame"))
+        {
+            _chunkLoadsPerFrame = properties.getInt("chunk_loads_per_frame");
+        }
+
+        if(properties.exists("arena_block_size"))
+        {
+            _arenaBlockSize = properties.getInt("arena_block_size");
+        }
     }
 
     std::string const & LevelLoaderComponent::getTexturePath() const
@@ -797,7 +1278,8 @@ namespace game
 
     int LevelLoaderComponent::getTile(int x, int y) const
     {
-        return _grid[y][x]._tileId;
+        Chunk const & chunk = _chunks[x / _chunkColumnCount];
+        return chunk._loaded ? chunk._tiles[(y * chunk._columnCount) + (x - chunk._firstColumn)] : EMPTY_TILE;
     }
 
     int LevelLoaderComponent::getWidth() const
@@ -821,6 +1303,61 @@ namespace game
         {
             func(node);
         }
+
+        for (int chunkIndex = 0; chunkIndex < static_cast<int>(_chunks.size()); ++chunkIndex)
+        {
+            forEachChunkNode(chunkIndex, collisionType, func);
+        }
+    }
+
+    void LevelLoaderComponent::forEachChunkNode(int chunkIndex, collision::Type::Enum collisionType, std::function<void(gameplay::Node *)> func)
+    {
+        Chunk const & chunk = _chunks[chunkIndex];
+
+        for (unsigned int i = 0; i < chunk._nodes.size(); ++i)
+        {
+            if (chunk._objects[i]._type == collisionType)
+            {
+                func(chunk._nodes[i]);
+            }
+        }
+    }
+
+    void LevelLoaderComponent::forEachChunkEnemy(int chunkIndex, std::function<void(EnemyComponent *)> func)
+    {
+        for (gameobjects::GameObject * gameObject : _chunks[chunkIndex]._gameObjects)
+        {
+            if (EnemyComponent * enemyComponent = gameObject ? gameObject->getComponent<EnemyComponent>() : nullptr)
+            {
+                func(enemyComponent);
+            }
+        }
+    }
+
+    int LevelLoaderComponent::getChunkCount() const
+    {
+        return _chunks.size();
+    }
+
+    int LevelLoaderComponent::getChunkColumnCount() const
+    {
+        return _chunkColumnCount;
+    }
+
+    bool LevelLoaderComponent::isChunkLoaded(int chunkIndex) const
+    {
+        return _chunks[chunkIndex]._loaded;
+    }
+
+    int LevelLoaderComponent::getLoadedChunkCount() const
+    {
+        return _loadedChunkCount;
+    }
+
+    gameplay::Arena::Stats LevelLoaderComponent::getArenaStats() const
+    {
+        gameplay::Arena::Stats stats = {};
+        return _arena ? _arena->getStats() : stats;
     }
 
     LevelLoaderComponent::Collectable * LevelLoaderComponent::findCollectable(gameplay::Node * node)
@@ -836,4 +1373,14 @@ namespace game
             collectablesOut.push_back(&collectablePair.second);
         }
     }
+
+    std::vector<EnemyComponent*> const & LevelLoaderComponent::getEnemies() const
+    {
+        return _enemies;
+    }
+
+    std::vector<std::vector<gameplay::Node*>> const & LevelLoaderComponent::getBridges() const
+    {
+        return _bridges;
+    }
 }
@@ -7,16 +7,29 @@
 namespace gameplay
 {
     class Properties;
+    class PropertiesRef;
 }
 
 namespace game
 {
+    class EnemyComponent;
+    class LoadPipeline;
+    class PlayerComponent;
+
     /**
      * Loads a level from a .level file
      *
      * Level files are created in [Tiled], exported as JSON and then converted to the
      * gameplay property format using [Json2gp3d]
      *
+     * The level file is read and parsed on a worker thread while the resources the level uses are loaded.
+     *
+     * Tiles, static collision, collectables and enemies are sorted into chunks, columns of tiles, which are created
+     * as the player approaches them and destroyed once they are left behind. The tiles of a chunk are decoded on a
+     * worker thread, getTile() returns EMPTY_TILE for tiles in chunks that aren't loaded. Enemies belong to the chunk
+     * they spawn in, which is widened to cover the area they patrol. LevelChunkLoaded, PreLevelChunkUnloaded and
+     * LevelChunkUnloaded are broadcast for each chunk streamed after the level has loaded.
+     *
      * [Tiled]      Download @ http://www.mapeditor.org/download.html
      * [Json2gp3d]  Download @ https://github.com/louis-mclaughlin/json-to-gameplay3d
      *
@@ -40,6 +53,7 @@ namespace game
         ~LevelLoaderComponent();
 
         void reload();
+        void processLoadRequests();
 
         std::string const & getTexturePath() const;
         int getTileWidth() const;
@@ -50,24 +64,68 @@ namespace game
         gameplay::Vector3 const & getPlayerSpawnPosition() const;
         Collectable * findCollectable(gameplay::Node * node);
         void getCollectables(std::vector<Collectable*> & collectablesOut);
+        std::vector<EnemyComponent*> const & getEnemies() const;
+        std::vector<std::vector<gameplay::Node*>> const & getBridges() const;
         void forEachCachedNode(collision::Type::Enum terrainType, std::function<void(gameplay::Node *)> func);
+        void forEachChunkNode(int chunkIndex, collision::Type::Enum terrainType, std::function<void(gameplay::Node *)> func);
+        void forEachChunkEnemy(int chunkIndex, std::function<void(EnemyComponent *)> func);
+        int getChunkCount() const;
+        int getChunkColumnCount() const;
+        bool isChunkLoaded(int chunkIndex) const;
+        int getLoadedChunkCount() const;
+        gameplay::Arena::Stats getArenaStats() const;
     protected:
         virtual void initialize() override;
         virtual void finalize() override;
         virtual bool onMessageReceived(gameobjects::Message * message, int messageType) override;
         virtual void readProperties(gameplay::Properties & properties) override;
     private:
-        struct Tile
+        /**
+         * An object described by the level which is created when its chunk is loaded
+        */
+        struct ChunkObject
+        {
+            collision::Type::Enum _type;
+            gameplay::Rectangle _bounds;
+            float _rotationZ;
+            gameplay::Rectangle _src;
+            bool _collected;
+        };
+
+        /**
+         * A character described by the level which is spawned when its chunk is loaded
+        */
+        struct ChunkSpawn
+        {
+            std::string _typeName;
+            gameplay::Vector3 _position;
+            gameplay::Rectangle _bounds;
+            bool _hasBounds;
+            bool _dead;
+        };
+
+        struct Chunk
         {
-            Tile() : _tileId(0) {}
-            int _tileId;
+            std::vector<ChunkObject> _objects;
+            std::vector<ChunkSpawn> _spawns;
+            std::vector<gameplay::Node*> _nodes;
+            std::vector<gameobjects::GameObject*> _gameObjects;
+            std::vector<int> _tiles;
+            int _firstColumn;
+            int _columnCount;
+            float _minX;
+            float _maxX;
+            bool _loaded;
+            bool _loading;
         };
 
         LevelLoaderComponent(LevelLoaderComponent const &);
 
+        void beginLoad();
+        void parse();
         void load();
-        void loadTerrain(gameplay::Properties * layerNamespace);
-        void loadCharacters(gameplay::Properties * layerNamespace);
+        void decodeTerrain(gameplay::Properties * layerNamespace);
+        void loadCharacters(gameplay::Properties * layerNamespace, std::vector<ChunkSpawn> & spawnsOut);
         void loadCharacterBounds(gameplay::Properties * layerNamespace);
         void loadStaticCollision(gameplay::Properties * layerNamespace, collision::Type::Enum terrainType);
         void loadDynamicCollision(gameplay::Properties * layerNamespace);
@@ -78,8 +136,19 @@ namespace game
 
         gameplay::Rectangle getObjectBounds(gameplay::Properties * objectNamespace) const;
         gameplay::Node * createCollisionObject(collision::Type::Enum collisionType, gameplay::Properties * collisionProperties, gameplay::Rectangle const & bounds, float rotationZ = 0.0f);
-        void placeEnemies();
-        void processLoadRequests();
+        gameplay::Node * createCollisionNode(std::string const & name, collision::Type::Enum collisionType, gameplay::Properties * collisionProperties, gameplay::Rectangle const & bounds, float rotationZ);
+        void destroyCollisionNode(gameplay::Node * node);
+        void createChunks();
+        int getChunkIndex(float x) const;
+        void addChunkObject(collision::Type::Enum collisionType, gameplay::PropertiesRef * collisionPropertiesRef, gameplay::Rectangle const & bounds, float rotationZ, gameplay::Rectangle const & src = gameplay::Rectangle());
+        void addChunkSpawns(std::vector<ChunkSpawn> const & spawns);
+        void requestChunk(int chunkIndex, bool broadcast);
+        void decodeChunkTiles(int chunkIndex);
+        void loadChunk(int chunkIndex);
+        void unloadChunk(int chunkIndex);
+        void streamChunks(bool immediate);
+        void placeEnemy(EnemyComponent * enemyComponent, ChunkSpawn const & spawn);
+        void enableDynamicCollision();
 
         std::string _level;
         std::string _texturePath;
@@ -88,15 +157,36 @@ namespace game
         int _tileWidth;
         int _tileHeight;
         bool _loadBroadcasted;
+        bool _streamChunks;
+        float _chunkWidthTiles;
+        float _loadDistanceTiles;
+        float _unloadDistanceTiles;
+        int _chunkLoadsPerFrame;
+        int _chunkColumnCount;
+        float _chunkWidth;
+        float _collectablesScale;
+        int _loadedChunkCount;
+        int _arenaBlockSize;
+        gameplay::Arena * _arena;
         gameplay::Vector3 _playerSpawnPosition;
-        std::vector<std::vector<Tile>> _grid;
+        std::unique_ptr<LoadPipeline> _pipeline;
+        std::unique_ptr<gameplay::Properties> _root;
+        std::vector<std::string> _terrainData;
         gameobjects::Message * _loadedMessage;
         gameobjects::Message * _unloadedMessage;
         gameobjects::Message * _preUnloadedMessage;
+        gameobjects::Message * _chunkLoadedMessage;
+        gameobjects::Message * _preChunkUnloadedMessage;
+        gameobjects::Message * _chunkUnloadedMessage;
+        PlayerComponent * _player;
         std::vector<gameobjects::GameObject*> _children;
+        std::vector<EnemyComponent*> _enemies;
+        std::vector<std::vector<gameplay::Node*>> _bridges;
         std::vector<gameplay::Rectangle> _characterBounds;
         std::map <collision::Type::Enum, std::vector<gameplay::Node*>> _collisionNodes;
         std::map<gameplay::Node *, Collectable> _collectables;
+        std::vector<Chunk> _chunks;
+        std::map<collision::Type::Enum, gameplay::PropertiesRef *> _chunkCollisionProperties;
     };
 }
 
@@ -20,7 +20,7 @@ namespace game
         for (auto & pair : _animations)
         {
             gameplay::Node * node = pair.first;
-            gameplay::Curve * curve = pair.second;
+            gameplay::Curve * curve = pair.second._curve;
             SAFE_RELEASE(node);
             SAFE_RELEASE(curve);
         }
@@ -40,15 +40,54 @@ namespace game
         node->addRef();
         gameplay::Curve * curve = gameplay::Curve::create(points.size(), 2);
         float controlPoints[2];
+        gameplay::Vector2 min = points.front();
+        gameplay::Vector2 max = points.front();
 
         for (int i = 0; i < points.size(); ++i)
         {
             controlPoints[0] = points[i].x;
             controlPoints[1] = points[i].y;
             curve->setPoint(i, (1.0f / (points.size() - 1)) * i, controlPoints, gameplay::Curve::FLAT);
+            min.x = std::min(min.x, points[i].x);
+            min.y = std::min(min.y, points[i].y);
+            max.x = std::max(max.x, points[i].x);
+            max.y = std::max(max.y, points[i].y);
         }
 
-        _animations[node] = curve;
+        Platform & platform = _animations[node];
+        platform._curve = curve;
+        platform._pathBounds = gameplay::Rectangle(min.x, min.y, max.x - min.x, max.y - min.y);
+        platform._active = true;
+    }
+
+    void LevelPlatformsComponent::forEachPlatform(std::function<void(gameplay::Node *, gameplay::Rectangle const & pathBounds)> func) const
+    {
+        for (auto const & pair : _animations)
+        {
+            func(pair.first, pair.second._pathBounds);
+        }
+    }
+
+    void LevelPlatformsComponent::setActive(gameplay::Node * node, bool active)
+    {
+        auto itr = _animations.find(node);
+        if(itr != _animations.end() && itr->second._active != active)
+        {
+            itr->second._active = active;
+
+            if(active)
+            {
+                move(node, itr->second);
+            }
+        }
+    }
+
+    void LevelPlatformsComponent::move(gameplay::Node * node, Platform const & platform)
+    {
+        float kinematicPos[2];
+        platform._curve->evaluate(_timer, kinematicPos);
+        gameplay::Vector3 position(kinematicPos[0], kinematicPos[1], 0);
+        node->getParent()->setTranslation(position);
     }
 
     gameplay::Vector3 LevelPlatformsComponent::getRenderPosition(gameplay::Node * node) const
@@ -81,11 +120,10 @@ namespace game
 
         for (auto & pair : _animations)
         {
-            gameplay::Node * node = pair.first;
-            float kinematicPos[2];
-            pair.second->evaluate(_timer, kinematicPos);
-            gameplay::Vector3 position(kinematicPos[0], kinematicPos[1], 0);
-            node->getParent()->setTranslation(position);
+            if (pair.second._active)
+            {
+                move(pair.first, pair.second);
+            }
         }
     }
 }
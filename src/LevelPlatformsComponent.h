@@ -13,14 +13,28 @@ namespace game
     public:
         LevelPlatformsComponent();
         void add(gameplay::Node * node, std::vector<gameplay::Vector2> const & points);
+        void forEachPlatform(std::function<void(gameplay::Node *, gameplay::Rectangle const & pathBounds)> func) const;
+
+        /**
+         * Inactive platforms aren't moved, a platform that becomes active is moved to where the shared timer puts it
+        */
+        void setActive(gameplay::Node * node, bool active);
         gameplay::Vector3 getRenderPosition(gameplay::Node * node) const;
     protected:
         virtual void finalize() override;
         virtual bool onMessageReceived(gameobjects::Message * message, int messageType) override;
     private:
+        struct Platform
+        {
+            gameplay::Curve * _curve;
+            gameplay::Rectangle _pathBounds;
+            bool _active;
+        };
+
         void onPostSimulationUpdate(float elapsedTime);
+        void move(gameplay::Node * node, Platform const & platform);
         
-        std::map<gameplay::Node*, gameplay::Curve *> _animations;
+        std::map<gameplay::Node*, Platform> _animations;
         float _timer;
         float _timerDirection;
     };
@@ -9,6 +9,7 @@
 #include "Game.h"
 #include "GameObject.h"
 #include "GameObjectController.h"
+#include "LevelActivationComponent.h"
 #include "LevelPlatformsComponent.h"
 #include "Messages.h"
 #include "PlayerComponent.h"
@@ -21,6 +22,9 @@
 
 namespace game
 {
+    // The number of interactables or collectables captured by each job
+    static unsigned int const CAPTURE_GRAIN_SIZE = 64;
+
     LevelRendererComponent::LevelRendererComponent()
         : _levelLoaded(false)
         , _levelLoadedOnce(false)
@@ -39,6 +43,7 @@ namespace game
         , _frameBuffer(nullptr)
         , _waterUniformTimer(0.0f)
     {
+        _snapshot._valid = false;
     }
 
     LevelRendererComponent::~LevelRendererComponent()
@@ -56,12 +61,18 @@ namespace game
         case(Messages::Type::LevelUnloaded):
             onLevelUnloaded();
             break;
-        case(Messages::Type::Render):
-        {
-            RenderMessage msg(message);
-            render(msg._elapsedTime);
-        }
-            return false;
+        case(Messages::Type::LevelChunkLoaded):
+            onLevelChunkLoaded(LevelChunkLoadedMessage(message)._chunkIndex);
+            break;
+        case(Messages::Type::PreLevelChunkUnloaded):
+            onPreLevelChunkUnloaded(PreLevelChunkUnloadedMessage(message)._chunkIndex);
+            break;
+        case(Messages::Type::LevelChunkUnloaded):
+            onLevelChunkUnloaded(LevelChunkUnloadedMessage(message)._chunkIndex);
+            break;
+        case(Messages::Type::RenderSnapshot):
+            captureSnapshot();
+            break;
         }
 
         return true;
@@ -82,21 +93,38 @@ namespace game
         return result;
     }
 
-    void LevelRendererComponent::resizeTileMap()
+    void LevelRendererComponent::loadChunkTiles(int chunkIndex)
     {
-        _tileMap.resize(_level->getHeight());
+        // Every chunk holds a full chunk of columns, the ones past the edge of the level stay empty
+        int const columnCount = _level->getChunkColumnCount();
+        int const firstColumn = chunkIndex * columnCount;
+        int const lastColumn = std::min(firstColumn + columnCount, _level->getWidth());
+        std::vector<Tile> & tiles = _chunkTiles[chunkIndex];
+        Tile emptyTile;
+        emptyTile.id = LevelLoaderComponent::EMPTY_TILE;
+        emptyTile.foreground = false;
+        tiles.assign(columnCount * _level->getHeight(), emptyTile);
 
-        for (auto & horizontalTiles : _tileMap)
+        for (int y = 0; y < _level->getHeight(); ++y)
         {
-            horizontalTiles.resize(_level->getWidth());
+            for (int x = firstColumn; x < lastColumn; ++x)
+            {
+                tiles[(y * columnCount) + (x - firstColumn)].id = _level->getTile(x, y);
+            }
         }
 
-        for (int y = 0; y < _level->getHeight(); ++y)
+        for (gameplay::Rectangle const & waterTileArea : _waterTileAreas)
         {
-            for (int x = 0; x < _level->getWidth(); ++x)
+            int const minX = std::max(static_cast<int>(waterTileArea.x), firstColumn);
+            int const maxX = std::min(static_cast<int>(waterTileArea.x + waterTileArea.width), lastColumn);
+
+            for (int y = waterTileArea.y; y < waterTileArea.y + waterTileArea.height; ++y)
             {
-                _tileMap[y][x].id = _level->getTile(x, y);
-                _tileMap[y][x].foreground = false;
+                for (int x = minX; x < maxX; ++x)
+                {
+                    Tile & tile = tiles[(y * columnCount) + (x - firstColumn)];
+                    tile.foreground = tile.id != LevelLoaderComponent::EMPTY_TILE;
+                }
             }
         }
     }
@@ -124,24 +152,21 @@ namespace game
         });
     }
 
-    void LevelRendererComponent::createEnemyAnimationSpriteBatches(std::vector<gameplay::SpriteBatch *> & spriteBatchesToInitialise)
+    void LevelRendererComponent::createEnemyAnimationSpriteBatches(std::vector<EnemyComponent *> const & enemies, std::vector<gameplay::SpriteBatch *> & spriteBatchesToInitialise)
     {
-        std::map<std::string, gameplay::SpriteBatch *> enemyspriteBatchesToInitialise;
-        std::vector<EnemyComponent *> enemies;
-        _level->getParent()->getComponentsInChildren(enemies);
-
+        // Enemies spawned by chunks streamed in later share the batches of the level
         for (EnemyComponent * enemy : enemies)
         {
             enemy->addRef();
 
-            enemy->forEachAnimation([this, &enemyspriteBatchesToInitialise, &enemy, &spriteBatchesToInitialise](EnemyComponent::State::Enum state, SpriteAnimationComponent * animation) -> bool
+            enemy->forEachAnimation([this, &enemy, &spriteBatchesToInitialise](EnemyComponent::State::Enum state, SpriteAnimationComponent * animation) -> bool
             {
                 SpriteSheet * animSheet = ResourceManager::getInstance().getSpriteSheet(animation->getSpriteSheetPath());
                 gameplay::SpriteBatch * spriteBatch = nullptr;
 
-                auto enemyBatchItr = enemyspriteBatchesToInitialise.find(animation->getSpriteSheetPath());
+                auto enemyBatchItr = _enemySpriteBatches.find(animation->getSpriteSheetPath());
 
-                if (enemyBatchItr != enemyspriteBatchesToInitialise.end())
+                if (enemyBatchItr != _enemySpriteBatches.end())
                 {
                     spriteBatch = enemyBatchItr->second;
                 }
@@ -150,7 +175,7 @@ namespace game
                     spriteBatch = gameplay::SpriteBatch::create(animSheet->getTexture());
                     spriteBatch->getSampler()->setFilterMode(gameplay::Texture::Filter::LINEAR, gameplay::Texture::Filter::LINEAR);
                     spriteBatch->getSampler()->setWrapMode(gameplay::Texture::Wrap::CLAMP, gameplay::Texture::Wrap::CLAMP);
-                    enemyspriteBatchesToInitialise[animation->getSpriteSheetPath()] = spriteBatch;
+                    _enemySpriteBatches[animation->getSpriteSheetPath()] = spriteBatch;
                     spriteBatchesToInitialise.push_back(spriteBatch);
                 }
 
@@ -255,14 +280,11 @@ namespace game
             waterTileArea.y = _level->getHeight() - (((bounds.y + bounds.height) / GAME_UNIT_SCALAR) / _level->getTileHeight());
             int const targetX = MATH_CLAMP(waterTileArea.x + waterTileArea.width, 0, _level->getWidth());
             int const targetY = MATH_CLAMP(waterTileArea.y + waterTileArea.height, 0, _level->getHeight());
+            int const startX = MATH_CLAMP(waterTileArea.x, 0, std::numeric_limits<float>::max());
+            int const startY = MATH_CLAMP(waterTileArea.y, 0, std::numeric_limits<float>::max());
 
-            for (int y = MATH_CLAMP(waterTileArea.y, 0, std::numeric_limits<float>::max()); y < targetY; ++y)
-            {
-                for (int x = MATH_CLAMP(waterTileArea.x, 0, std::numeric_limits<float>::max()); x < targetX; ++x)
-                {
-                    _tileMap[y][x].foreground = _tileMap[y][x].id != LevelLoaderComponent::EMPTY_TILE;
-                }
-            }
+            // The tiles under water are drawn in front of it as their chunks are loaded
+            _waterTileAreas.push_back(gameplay::Rectangle(startX, startY, std::max(targetX - startX, 0), std::max(targetY - startY, 0)));
             _waterBounds.push_back(bounds);
         });
     }
@@ -284,23 +306,26 @@ namespace game
         _platforms = _level->getParent()->getComponentInChildren<LevelPlatformsComponent>();
         GAME_SAFE_ADD(_platforms);
 
-        resizeTileMap();
+        std::vector<EnemyComponent *> enemies;
+        _level->getParent()->getComponentsInChildren(enemies);
         createReusableSpriteBatches(spriteBatchesToInitialise);
         createTileSpriteBatch(&_backgroundTileBatch, spriteBatchesToInitialise);
         createTileSpriteBatch(&_foregroundTileBatch, spriteBatchesToInitialise);
         createPlayerAnimationSpriteBatches(spriteBatchesToInitialise);
-        createEnemyAnimationSpriteBatches(spriteBatchesToInitialise);
+        createEnemyAnimationSpriteBatches(enemies, spriteBatchesToInitialise);
         cacheInteractableTextureTargets();
         createWaterDrawTargets();
+        _chunkTiles.resize(_level->getChunkCount());
 
-        // The first call to draw will perform some lazy initialisation in Effect::Bind
-        for (gameplay::SpriteBatch * spriteBatch : spriteBatchesToInitialise)
+        for (int chunkIndex = 0; chunkIndex < _level->getChunkCount(); ++chunkIndex)
         {
-            spriteBatch->start();
-            spriteBatch->draw(gameplay::Rectangle(), gameplay::Rectangle());
-            spriteBatch->finish();
+            if (_level->isChunkLoaded(chunkIndex))
+            {
+                loadChunkTiles(chunkIndex);
+            }
         }
 
+        initialiseSpriteBatches(spriteBatchesToInitialise);
         _levelLoaded = true;
         _levelLoadedOnce = true;
 
@@ -308,10 +333,74 @@ namespace game
         ScreenOverlay::getInstance().queueFadeOut(fadeOutDuration);
     }
 
+    void LevelRendererComponent::initialiseSpriteBatches(std::vector<gameplay::SpriteBatch *> const & spriteBatches)
+    {
+        // The first call to draw will perform some lazy initialisation in Effect::Bind
+        for (gameplay::SpriteBatch * spriteBatch : spriteBatches)
+        {
+            spriteBatch->start();
+            spriteBatch->draw(gameplay::Rectangle(), gameplay::Rectangle());
+            spriteBatch->finish();
+        }
+    }
+
+    void LevelRendererComponent::onLevelChunkLoaded(int chunkIndex)
+    {
+        if(!_levelLoaded)
+        {
+            return;
+        }
+
+        std::vector<EnemyComponent *> enemies;
+        std::vector<gameplay::SpriteBatch *> spriteBatchesToInitialise;
+        _level->forEachChunkEnemy(chunkIndex, [&enemies](EnemyComponent * enemy)
+        {
+            enemies.push_back(enemy);
+        });
+        createEnemyAnimationSpriteBatches(enemies, spriteBatchesToInitialise);
+        initialiseSpriteBatches(spriteBatchesToInitialise);
+        loadChunkTiles(chunkIndex);
+        _collectables.clear();
+        _level->getCollectables(_collectables);
+    }
+
+    void LevelRendererComponent::onPreLevelChunkUnloaded(int chunkIndex)
+    {
+        if(!_levelLoaded)
+        {
+            return;
+        }
+
+        // The batches stay with the level for the enemies of other chunks
+        _level->forEachChunkEnemy(chunkIndex, [this](EnemyComponent * enemy)
+        {
+            if (_enemyAnimationBatches.erase(enemy) > 0)
+            {
+                SAFE_RELEASE(enemy);
+            }
+        });
+    }
+
+    void LevelRendererComponent::onLevelChunkUnloaded(int chunkIndex)
+    {
+        if(!_levelLoaded)
+        {
+            return;
+        }
+
+        _chunkTiles[chunkIndex].clear();
+        _chunkTiles[chunkIndex].shrink_to_fit();
+        _collectables.clear();
+        _level->getCollectables(_collectables);
+    }
+
     void LevelRendererComponent::onLevelUnloaded()
     {
         PROFILE();
 
+        // The snapshot refers to the sprite batches and characters of the level
+        _snapshot._valid = false;
+
         SAFE_RELEASE(_player);
         SAFE_RELEASE(_platforms);
         SAFE_DELETE(_backgroundTileBatch);
@@ -322,25 +411,18 @@ namespace game
             SAFE_DELETE(playerAnimBatchPairItr.second);
         }
 
-        static std::set<gameplay::SpriteBatch *> uniqueEnemyBatches;
-
         for (auto & enemyAnimPairItr : _enemyAnimationBatches)
         {
             EnemyComponent * enemy = enemyAnimPairItr.first;
             SAFE_RELEASE(enemy);
-
-            for (auto & enemyAnimBatchPairItr : enemyAnimPairItr.second)
-            {
-                uniqueEnemyBatches.insert(enemyAnimBatchPairItr.second);
-            }
         }
 
-        for(gameplay::SpriteBatch * spriteBatch : uniqueEnemyBatches)
+        for (auto & enemyBatchPair : _enemySpriteBatches)
         {
-            SAFE_DELETE(spriteBatch);
+            SAFE_DELETE(enemyBatchPair.second);
         }
 
-        uniqueEnemyBatches.clear();
+        _enemySpriteBatches.clear();
 
         for (auto & nodePair : _dynamicCollisionNodes)
         {
@@ -351,8 +433,9 @@ namespace game
         _playerAnimationBatches.clear();
         _enemyAnimationBatches.clear();
         _waterBounds.clear();
+        _waterTileAreas.clear();
         _collectables.clear();
-        _tileMap.clear();
+        _chunkTiles.clear();
 
         if(_levelLoaded)
         {
@@ -522,11 +605,20 @@ namespace game
             int tileTextureHeight = tileHeight * tileTexureScale;
             int const numSpritesX = _backgroundTileBatch->getSampler()->getTexture()->getWidth() / tileTextureWidth;
 
+            int const columnCount = _level->getChunkColumnCount();
+
             for (int y = minY; y < maxY; ++y)
             {
                 for (int x = minX; x < maxX; ++x)
                 {
-                    Tile const & tile =  _tileMap[y][x];
+                    std::vector<Tile> const & chunkTiles = _chunkTiles[x / columnCount];
+
+                    if (chunkTiles.empty())
+                    {
+                        continue;
+                    }
+
+                    Tile const & tile = chunkTiles[(y * columnCount) + (x % columnCount)];
 
                     if (tile.id != LevelLoaderComponent::EMPTY_TILE)
                     {
@@ -559,30 +651,9 @@ namespace game
         int interactableDrawn = 0;
 
         // Draw dynamic collision (crates, boulders etc)
-        for (auto & nodePair : _dynamicCollisionNodes)
+        for (InteractableSnapshot const & interactable : _snapshot._interactables)
         {
-            gameplay::Node * node = nodePair.first;
-            gameplay::Rectangle dst;
-            dst.width = node->getScaleX();
-            dst.height = node->getScaleY();
-            collision::NodeData * data = collision::NodeData::get(node);
-            bool const isPlatform = data->_type == collision::Type::KINEMATIC;
-            gameplay::Vector3 const nodePosition = isPlatform ? _platforms->getRenderPosition(node) : node->getTranslation();
-            dst.x = nodePosition.x - (dst.width / 2);
-            dst.y = nodePosition.y - (dst.height / 2);
-
-            gameplay::Rectangle maxBounds = dst;
-
-            // Extend non-spherical shapes for viewport intersection test, prevents shapes being culled when still visible during rotation
-            if(node->getCollisionObject()->getShapeType() != gameplay::PhysicsCollisionShape::Type::SHAPE_SPHERE)
-            {
-                maxBounds.width = gameplay::Vector2(dst.width, dst.height).length();
-                maxBounds.height = maxBounds.width;
-                maxBounds.x = nodePosition.x - (maxBounds.width / 2);
-                maxBounds.y = nodePosition.y - (maxBounds.height / 2);
-            }
-
-            if (maxBounds.intersects(_viewport))
+            if (interactable._visible)
             {
                 if (interactableDrawn == 0)
                 {
@@ -592,22 +663,20 @@ namespace game
 
                 ++interactableDrawn;
 
-                gameplay::Quaternion const & q = node->getRotation();
-                float const rotation = -static_cast<float>(atan2f(2.0f * q.x * q.y + 2.0f * q.z * q.w, 1.0f - 2.0f * ((q.y * q.y) + (q.z * q.z))));
-                gameplay::Rectangle const renderDst = getRenderDestination(dst);
+                gameplay::Rectangle const renderDst = getRenderDestination(interactable._dst);
                 _interactablesSpritebatch->draw(gameplay::Vector3(renderDst.x, renderDst.y, 0),
-                    nodePair.second,
+                    interactable._src,
                     gameplay::Vector2(renderDst.width, renderDst.height),
                     gameplay::Vector4::one(),
                     (gameplay::Vector2::one() / 2),
-                    rotation);
+                    interactable._rotation);
 
-                if(isPlatform)
+                if(interactable._isPlatform)
                 {
-                    DEBUG_RENDER_WORLD_TEXT(nodePosition, "show_platform_stats",
+                    DEBUG_RENDER_WORLD_TEXT(interactable._position, "show_platform_stats",
                                           GAME_VEC3_STR "\n" GAME_VEC3_STR,
-                                          GAME_VEC3_ARG(nodePosition),
-                                          GAME_VEC3_ARG(static_cast<gameplay::PhysicsRigidBody*>(node->getCollisionObject())->getLinearVelocity()));
+                                          GAME_VEC3_ARG(interactable._position),
+                                          GAME_VEC3_ARG(interactable._velocity));
                 }
             }
         }
@@ -624,37 +693,20 @@ namespace game
     {
         int collectableDrawn = 0;
 
-        for(LevelLoaderComponent::Collectable * collectable : _collectables)
+        for(CollectableSnapshot const & collectable : _snapshot._collectables)
         {
-            gameplay::Rectangle dst;
-            dst.width = collectable->_node->getScaleX();
-            dst.height = collectable->_node->getScaleY();
-            dst.x = collectable->_startPosition.x - dst.width / 2;
-            dst.y = collectable->_startPosition.y - dst.height / 2;
-
-            if (collectable->_active)
+            if (!collectable._visible)
             {
-                collectable->_visible = dst.intersects(_viewport);
-
-                if (collectable->_visible)
-                {
-                    if (collectableDrawn == 0)
-                    {
-                        _collectablesSpritebatch->setProjectionMatrix(_viewProj);
-                        _collectablesSpritebatch->start();
-                    }
-                    ++collectableDrawn;
+                continue;
+            }
 
-                    if(gameplay::Game::getInstance()->getState() != gameplay::Game::State::PAUSED)
-                    {
-                        float const speed = 5.0f;
-                        float const height = collectable->_node->getScaleY() * 0.05f;
-                        float bounce = sin((gameplay::Game::getGameTime() / 1000.0f) * speed + (collectable->_node->getTranslationX() + collectable->_node->getTranslationY())) * height;
-                        dst.y += bounce;
-                    }
-                    _collectablesSpritebatch->draw(getRenderDestination(dst), getSafeDrawRect(collectable->_src));
-                }
+            if (collectableDrawn == 0)
+            {
+                _collectablesSpritebatch->setProjectionMatrix(_viewProj);
+                _collectablesSpritebatch->start();
             }
+            ++collectableDrawn;
+            _collectablesSpritebatch->draw(getRenderDestination(collectable._dst), getSafeDrawRect(collectable._src));
         }
 
         DEBUG_RENDER_TEXT_WITH_ARGS("show_level_stats", "collectables  [%d/%d]", collectableDrawn, _collectables.size());
@@ -670,40 +722,29 @@ namespace game
         _characterRenderer->start();
 
         // Enemies
-        for (auto & enemyAnimPairItr : _enemyAnimationBatches)
+        for (CharacterSnapshot const & enemy : _snapshot._enemies)
         {
-            EnemyComponent * enemy = enemyAnimPairItr.first;
-            float const alpha = enemy->getAlpha();
-
-            if(alpha > 0.0f)
+            bool const wasRenderered = _characterRenderer->render(enemy._drawTarget, enemy._spriteBatch, _viewProj,
+                            enemy._position, _viewport, enemy._alpha);
+            if(wasRenderered)
             {
-                std::map<int, gameplay::SpriteBatch *> & enemyBatches = enemyAnimPairItr.second;
-                bool const wasRenderered = _characterRenderer->render(enemy->getCurrentAnimation(),
-                                enemyBatches[enemy->getState()], _viewProj,
-                                enemy->getFlipFlags(),
-                                enemy->getRenderPosition(), _viewport, alpha);
-                if(wasRenderered)
-                {
-                    DEBUG_RENDER_WORLD_TEXT(enemy->getRenderPosition(), "show_enemy_stats",
-                                          GAME_VEC3_STR "\n" GAME_VEC3_STR,
-                                          GAME_VEC3_ARG(enemy->getRenderPosition()),
-                                          GAME_VEC3_ARG(enemy->getVelocity()));
-                }
+                DEBUG_RENDER_WORLD_TEXT(enemy._position, "show_enemy_stats",
+                                      GAME_VEC3_STR "\n" GAME_VEC3_STR,
+                                      GAME_VEC3_ARG(enemy._position),
+                                      GAME_VEC3_ARG(enemy._velocity));
             }
         }
 
         DEBUG_RENDER_TEXT_WITH_ARGS("show_level_stats", "enemies       [%d/%d]", _characterRenderer->getRenderCount(), _enemyAnimationBatches.size());
 
         // Player
-        _characterRenderer->render(_player->getCurrentAnimation(),
-                        _playerAnimationBatches[_player->getState()], _viewProj,
-                        _player->getFlipFlags(),
-                        _player->getRenderPosition(), _viewport);
+        CharacterSnapshot const & player = _snapshot._player;
+        _characterRenderer->render(player._drawTarget, player._spriteBatch, _viewProj, player._position, _viewport);
         _characterRenderer->finish();
-        DEBUG_RENDER_WORLD_TEXT(_player->getRenderPosition(), "show_player_stats",
+        DEBUG_RENDER_WORLD_TEXT(player._position, "show_player_stats",
             GAME_VEC3_STR "\n" GAME_VEC3_STR,
-            GAME_VEC3_ARG(_player->getRenderPosition()),
-            GAME_VEC3_ARG(_player->getCharacter()->getCurrentVelocity()));
+            GAME_VEC3_ARG(player._position),
+            GAME_VEC3_ARG(player._velocity));
     }
 
     void LevelRendererComponent::renderWater(float elapsedTime)
@@ -754,9 +795,143 @@ namespace game
         return _waterUniformTimer * MATH_PIX2;
     }
 
+    void LevelRendererComponent::captureCharacter(CharacterSnapshot & character, SpriteAnimationComponent * animation, gameplay::SpriteBatch * spriteBatch,
+        int flipFlags, gameplay::Vector3 const & position, gameplay::Vector3 const & velocity, float alpha)
+    {
+        character._spriteBatch = spriteBatch;
+        character._drawTarget = animation->getDrawTarget(0.0f, static_cast<Sprite::Flip::Enum>(flipFlags));
+        character._position = position;
+        character._velocity = velocity;
+        character._alpha = alpha;
+    }
+
+    void LevelRendererComponent::captureSnapshot()
+    {
+        _snapshot._valid = _levelLoaded;
+
+        if(!_levelLoaded)
+        {
+            return;
+        }
+
+        PROFILE();
+        _snapshot._viewProj = CameraComponent::getRenderViewProjectionMatrix();
+        _snapshot._viewport = CameraComponent::getRenderViewport();
+        _snapshot._enemies.clear();
+#ifndef _FINAL
+        LevelActivationComponent * activation = _level->getParent()->getComponent<LevelActivationComponent>();
+        _snapshot._hasActivation = activation != nullptr;
+
+        if(activation)
+        {
+            _snapshot._activeRegionCount = activation->getActiveRegionCount();
+            _snapshot._regionCount = activation->getRegionCount();
+            _snapshot._activeItemCount = activation->getActiveItemCount();
+            _snapshot._itemCount = activation->getItemCount();
+        }
+
+        _snapshot._loadedChunkCount = _level->getLoadedChunkCount();
+        _snapshot._chunkCount = _level->getChunkCount();
+        _snapshot._arenaStats = _level->getArenaStats();
+#endif
+
+        for (auto & enemyAnimPairItr : _enemyAnimationBatches)
+        {
+            EnemyComponent * enemy = enemyAnimPairItr.first;
+            float const alpha = enemy->getAlpha();
+
+            if(alpha > 0.0f)
+            {
+                _snapshot._enemies.emplace_back();
+                captureCharacter(_snapshot._enemies.back(), enemy->getCurrentAnimation(), enemyAnimPairItr.second[enemy->getState()],
+                                 enemy->getFlipFlags(), enemy->getRenderPosition(), enemy->getVelocity(), alpha);
+            }
+        }
+
+        captureCharacter(_snapshot._player, _player->getCurrentAnimation(), _playerAnimationBatches[_player->getState()],
+                         _player->getFlipFlags(), _player->getRenderPosition(), _player->getCharacter()->getCurrentVelocity(), 1.0f);
+
+        // Culling and building the render data only reads the simulation, each job writes to its own range of the snapshot
+        gameplay::JobController * jobs = gameplay::Game::getInstance()->getJobController();
+        _snapshot._interactables.resize(_dynamicCollisionNodes.size());
+        _snapshot._collectables.resize(_collectables.size());
+
+        jobs->parallelFor(_dynamicCollisionNodes.size(), CAPTURE_GRAIN_SIZE, [this](unsigned int begin, unsigned int end)
+        {
+            for(unsigned int i = begin; i < end; ++i)
+            {
+                captureInteractable(_snapshot._interactables[i], _dynamicCollisionNodes[i].first, _dynamicCollisionNodes[i].second);
+            }
+        });
+
+        bool const bounce = gameplay::Game::getInstance()->getState() != gameplay::Game::State::PAUSED;
+        jobs->parallelFor(_collectables.size(), CAPTURE_GRAIN_SIZE, [this, bounce](unsigned int begin, unsigned int end)
+        {
+            for(unsigned int i = begin; i < end; ++i)
+            {
+                captureCollectable(_snapshot._collectables[i], _collectables[i], bounce);
+            }
+        });
+    }
+
+    void LevelRendererComponent::captureInteractable(InteractableSnapshot & interactable, gameplay::Node * node, gameplay::Rectangle const & src)
+    {
+        interactable._dst.width = node->getScaleX();
+        interactable._dst.height = node->getScaleY();
+        collision::NodeData * data = collision::NodeData::get(node);
+        interactable._isPlatform = data->_type == collision::Type::KINEMATIC;
+        interactable._position = interactable._isPlatform ? _platforms->getRenderPosition(node) : node->getTranslation();
+        interactable._dst.x = interactable._position.x - (interactable._dst.width / 2);
+        interactable._dst.y = interactable._position.y - (interactable._dst.height / 2);
+        interactable._bounds = interactable._dst;
+
+        // Extend non-spherical shapes for viewport intersection test, prevents shapes being culled when still visible during rotation
+        if(node->getCollisionObject()->getShapeType() != gameplay::PhysicsCollisionShape::Type::SHAPE_SPHERE)
+        {
+            interactable._bounds.width = gameplay::Vector2(interactable._dst.width, interactable._dst.height).length();
+            interactable._bounds.height = interactable._bounds.width;
+            interactable._bounds.x = interactable._position.x - (interactable._bounds.width / 2);
+            interactable._bounds.y = interactable._position.y - (interactable._bounds.height / 2);
+        }
+
+        interactable._visible = interactable._bounds.intersects(_snapshot._viewport);
+        gameplay::Quaternion const & q = node->getRotation();
+        interactable._rotation = -static_cast<float>(atan2f(2.0f * q.x * q.y + 2.0f * q.z * q.w, 1.0f - 2.0f * ((q.y * q.y) + (q.z * q.z))));
+        interactable._src = src;
+        interactable._velocity = interactable._isPlatform ?
+            static_cast<gameplay::PhysicsRigidBody*>(node->getCollisionObject())->getLinearVelocity() : gameplay::Vector3::zero();
+    }
+
+    void LevelRendererComponent::captureCollectable(CollectableSnapshot & snapshot, LevelLoaderComponent::Collectable * collectable, bool bounce)
+    {
+        snapshot._dst.width = collectable->_node->getScaleX();
+        snapshot._dst.height = collectable->_node->getScaleY();
+        snapshot._dst.x = collectable->_startPosition.x - snapshot._dst.width / 2;
+        snapshot._dst.y = collectable->_startPosition.y - snapshot._dst.height / 2;
+        snapshot._visible = false;
+
+        if (collectable->_active)
+        {
+            collectable->_visible = snapshot._dst.intersects(_snapshot._viewport);
+            snapshot._visible = collectable->_visible;
+
+            if (collectable->_visible)
+            {
+                if(bounce)
+                {
+                    float const speed = 5.0f;
+                    float const height = collectable->_node->getScaleY() * 0.05f;
+                    float bounceOffset = sin((gameplay::Game::getGameTime() / 1000.0f) * speed + (collectable->_node->getTranslationX() + collectable->_node->getTranslationY())) * height;
+                    snapshot._dst.y += bounceOffset;
+                }
+                snapshot._src = collectable->_src;
+            }
+        }
+    }
+
     void LevelRendererComponent::render(float elapsedTime)
     {
-        bool renderingEnabled = _levelLoaded;
+        bool renderingEnabled = _levelLoaded && _snapshot._valid;
 #ifndef _FINAL
         renderingEnabled &= getConfig()->getBool("show_level");
 #endif
@@ -770,8 +945,8 @@ namespace game
                 previousFrameBuffer = _frameBuffer->bind();
             }
 
-            _viewProj = CameraComponent::getRenderViewProjectionMatrix();
-            _viewport = CameraComponent::getRenderViewport();
+            _viewProj = _snapshot._viewProj;
+            _viewport = _snapshot._viewport;
             renderBackground(elapsedTime);
             renderTiles();
             renderCollectables();
@@ -779,6 +954,19 @@ namespace game
             renderInteractables();
             renderWater(elapsedTime);
             _foregroundTileBatch->finish();
+#ifndef _FINAL
+            if(_snapshot._hasActivation)
+            {
+                DEBUG_RENDER_TEXT_WITH_ARGS("show_level_stats", "active        [%d/%d regions][%d/%d]",
+                    _snapshot._activeRegionCount, _snapshot._regionCount, _snapshot._activeItemCount, _snapshot._itemCount);
+            }
+
+            DEBUG_RENDER_TEXT_WITH_ARGS("show_level_stats", "chunks        [%d/%d]", _snapshot._loadedChunkCount, _snapshot._chunkCount);
+
+            gameplay::Arena::Stats const & arenaStats = _snapshot._arenaStats;
+            DEBUG_RENDER_TEXT_WITH_ARGS("show_level_stats", "arena         [%.2f/%.2fmb][%d objects][%d blocks]",
+                arenaStats.liveBytes / (1024.0f * 1024.0f), arenaStats.reservedBytes / (1024.0f * 1024.0f), arenaStats.liveObjects, arenaStats.blocks);
+#endif
 
             if(previousFrameBuffer)
             {
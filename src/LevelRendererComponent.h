@@ -25,6 +25,12 @@ namespace game
     public:
         explicit LevelRendererComponent();
         ~LevelRendererComponent();
+
+        /**
+         * Draws the snapshot captured at the end of the last simulation update. Called by the main world rather
+         * than broadcast so that it can run on the main thread while physics steps the simulation on its own.
+        */
+        void render(float elapsedTime);
     protected:
         virtual void initialize() override;
         virtual void finalize() override;
@@ -40,19 +46,80 @@ namespace game
             bool _cameraIndependent;
         };
 
+        struct CharacterSnapshot
+        {
+            gameplay::SpriteBatch * _spriteBatch;
+            SpriteAnimationComponent::DrawTarget _drawTarget;
+            gameplay::Vector3 _position;
+            gameplay::Vector3 _velocity;
+            float _alpha;
+        };
+
+        struct InteractableSnapshot
+        {
+            gameplay::Rectangle _dst;
+            gameplay::Rectangle _bounds;
+            gameplay::Rectangle _src;
+            gameplay::Vector3 _position;
+            gameplay::Vector3 _velocity;
+            float _rotation;
+            bool _isPlatform;
+            bool _visible;
+        };
+
+        struct CollectableSnapshot
+        {
+            gameplay::Rectangle _dst;
+            gameplay::Rectangle _src;
+            bool _visible;
+        };
+
+        /**
+         * Everything rendering reads from the simulation, captured once the simulation of a frame has finished
+         * so that it can be rendered while the next frame is simulated.
+        */
+        struct RenderSnapshot
+        {
+            gameplay::Matrix _viewProj;
+            gameplay::Rectangle _viewport;
+            CharacterSnapshot _player;
+            std::vector<CharacterSnapshot> _enemies;
+            std::vector<InteractableSnapshot> _interactables;
+            std::vector<CollectableSnapshot> _collectables;
+#ifndef _FINAL
+            int _activeRegionCount;
+            int _regionCount;
+            int _activeItemCount;
+            int _itemCount;
+            int _loadedChunkCount;
+            int _chunkCount;
+            gameplay::Arena::Stats _arenaStats;
+            bool _hasActivation;
+#endif
+            bool _valid;
+        };
+
         LevelRendererComponent(LevelRendererComponent const &);
 
         void onLevelLoaded();
         void onLevelUnloaded();
-        void resizeTileMap();
+        void onLevelChunkLoaded(int chunkIndex);
+        void onPreLevelChunkUnloaded(int chunkIndex);
+        void onLevelChunkUnloaded(int chunkIndex);
+        void loadChunkTiles(int chunkIndex);
         void createWaterDrawTargets();
         void cacheInteractableTextureTargets();
         void createRenderTargets(unsigned int width, unsigned int height);
         void createTileSpriteBatch(gameplay::SpriteBatch ** spriteBatch, std::vector<gameplay::SpriteBatch *> & spriteBatchesToInitialise);
         void createReusableSpriteBatches(std::vector<gameplay::SpriteBatch *> & spriteBatchesToInitialise);
         void createPlayerAnimationSpriteBatches(std::vector<gameplay::SpriteBatch *> & spriteBatchesToInitialise);
-        void createEnemyAnimationSpriteBatches(std::vector<gameplay::SpriteBatch *> & spriteBatchesToInitialise);
-        void render(float elapsedTime);
+        void createEnemyAnimationSpriteBatches(std::vector<EnemyComponent *> const & enemies, std::vector<gameplay::SpriteBatch *> & spriteBatchesToInitialise);
+        void initialiseSpriteBatches(std::vector<gameplay::SpriteBatch *> const & spriteBatches);
+        void captureSnapshot();
+        void captureCharacter(CharacterSnapshot & character, SpriteAnimationComponent * animation, gameplay::SpriteBatch * spriteBatch,
+            int flipFlags, gameplay::Vector3 const & position, gameplay::Vector3 const & velocity, float alpha);
+        void captureInteractable(InteractableSnapshot & interactable, gameplay::Node * node, gameplay::Rectangle const & src);
+        void captureCollectable(CollectableSnapshot & snapshot, LevelLoaderComponent::Collectable * collectable, bool bounce);
         void renderCharacters();
         void renderBackground(float elapsedTime);
         void renderInteractables();
@@ -70,11 +137,12 @@ namespace game
         bool _levelLoaded;
         bool _levelLoadedOnce;
         float _waterUniformTimer;
-        std::vector<std::vector<Tile>> _tileMap;
+        std::vector<std::vector<Tile>> _chunkTiles;
         PlayerComponent * _player;
         LevelLoaderComponent * _level;
         std::map<int, gameplay::SpriteBatch *> _playerAnimationBatches;
         std::map<EnemyComponent *, std::map<int, gameplay::SpriteBatch *>> _enemyAnimationBatches;
+        std::map<std::string, gameplay::SpriteBatch *> _enemySpriteBatches;
         LevelPlatformsComponent * _platforms;
         gameplay::SpriteBatch * _backgroundTileBatch;
         gameplay::SpriteBatch * _foregroundTileBatch;
@@ -92,10 +160,12 @@ namespace game
         std::vector<std::pair<gameplay::Node *, gameplay::Rectangle>> _dynamicCollisionNodes;
         std::vector<LevelLoaderComponent::Collectable *> _collectables;
         std::vector<gameplay::Rectangle> _waterBounds;
+        std::vector<gameplay::Rectangle> _waterTileAreas;
         gameplay::FrameBuffer * _frameBuffer;
         gameplay::SpriteBatch * _pauseSpriteBatch;
         gameplay::Matrix _viewProj;
         gameplay::Rectangle _viewport;
+        RenderSnapshot _snapshot;
     };
 }
 
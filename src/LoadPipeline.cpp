@@ -0,0 +1,212 @@
+#include "LoadPipeline.h"
+
+#include "Base.h"
+#include <chrono>
+
+namespace game
+{
+    LoadPipeline::LoadPipeline(unsigned int workerCount)
+        : _outstanding(0)
+        , _exiting(false)
+    {
+        for(unsigned int i = 0; i < workerCount; ++i)
+        {
+            _workers.push_back(std::thread(&LoadPipeline::workerThreadProc, this));
+        }
+    }
+
+    LoadPipeline::~LoadPipeline()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _exiting = true;
+        }
+
+        _workQueued.notify_all();
+
+        for(std::thread & worker : _workers)
+        {
+            worker.join();
+        }
+    }
+
+    LoadPipeline::LoadPipeline(LoadPipeline const &)
+    {
+    }
+
+    unsigned int LoadPipeline::getDefaultWorkerCount()
+    {
+#ifdef GP_USE_MEM_LEAK_DETECTION
+        // The allocation and ref trackers are not thread safe
+        return 0;
+#else
+        unsigned int const hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+#endif
+    }
+
+    LoadPipeline::TaskId LoadPipeline::add(std::function<void()> const & work, std::function<void()> const & complete,
+                                           std::vector<TaskId> const & dependencies)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        TaskId const id = _tasks.size();
+        _tasks.push_back(Task());
+        Task & task = _tasks.back();
+        task._work = work;
+        task._complete = complete;
+        task._pendingDependencies = 0;
+        task._completed = false;
+
+        for(TaskId dependency : dependencies)
+        {
+            GP_ASSERT(dependency < id);
+            if(!_tasks[dependency]._completed)
+            {
+                _tasks[dependency]._dependents.push_back(id);
+                ++task._pendingDependencies;
+            }
+        }
+
+        ++_outstanding;
+
+        if(task._pendingDependencies == 0)
+        {
+            _queued.push_back(id);
+            _workQueued.notify_one();
+        }
+
+        return id;
+    }
+
+    void LoadPipeline::workerThreadProc()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        while(true)
+        {
+            _workQueued.wait(lock, [this]() { return _exiting || !_queued.empty(); });
+
+            if(_exiting)
+            {
+                break;
+            }
+
+            TaskId const id = _queued.front();
+            _queued.pop_front();
+            // Deque elements are never moved by push_back so the task can be read without the lock
+            Task & task = _tasks[id];
+            lock.unlock();
+
+            if(task._work)
+            {
+                task._work();
+            }
+
+            lock.lock();
+            _ready.push_back(id);
+            _workReady.notify_one();
+        }
+    }
+
+    void LoadPipeline::runQueuedWork(std::unique_lock<std::mutex> & lock, bool runAll)
+    {
+        // Without any workers the queued work is run inline, in the order it was queued
+        while(!_queued.empty())
+        {
+            TaskId const id = _queued.front();
+            _queued.pop_front();
+            Task & task = _tasks[id];
+            lock.unlock();
+            if(task._work)
+            {
+                task._work();
+            }
+            lock.lock();
+            _ready.push_back(id);
+
+            if(!runAll)
+            {
+                break;
+            }
+        }
+    }
+
+    void LoadPipeline::completeReadyTasks(std::unique_lock<std::mutex> & lock)
+    {
+        std::vector<TaskId> completed(_ready.begin(), _ready.end());
+        _ready.clear();
+        lock.unlock();
+
+        // Completion callbacks may add more tasks so they are called without holding the lock
+        for(TaskId id : completed)
+        {
+            if(_tasks[id]._complete)
+            {
+                _tasks[id]._complete();
+            }
+        }
+
+        lock.lock();
+
+        for(TaskId id : completed)
+        {
+            Task & task = _tasks[id];
+            task._completed = true;
+            task._work = nullptr;
+            task._complete = nullptr;
+            --_outstanding;
+
+            for(TaskId dependentId : task._dependents)
+            {
+                if(--_tasks[dependentId]._pendingDependencies == 0)
+                {
+                    _queued.push_back(dependentId);
+                    _workQueued.notify_one();
+                }
+            }
+        }
+    }
+
+    void LoadPipeline::finish(std::function<void()> const & onIdle, float idleIntervalMs)
+    {
+        typedef std::chrono::steady_clock Clock;
+        Clock::time_point lastIdle = Clock::now();
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        while(_outstanding > 0)
+        {
+            if(_workers.empty())
+            {
+                runQueuedWork(lock, true);
+            }
+            else if(_ready.empty())
+            {
+                _workReady.wait_for(lock, std::chrono::duration<float, std::milli>(idleIntervalMs));
+            }
+
+            completeReadyTasks(lock);
+
+            if(onIdle && std::chrono::duration<float, std::milli>(Clock::now() - lastIdle).count() >= idleIntervalMs)
+            {
+                lock.unlock();
+                onIdle();
+                lastIdle = Clock::now();
+                lock.lock();
+            }
+        }
+    }
+
+    bool LoadPipeline::update()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        if(_workers.empty())
+        {
+            // One task per call so that the inline work is spread across frames
+            runQueuedWork(lock, false);
+        }
+
+        completeReadyTasks(lock);
+        return _outstanding == 0;
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef GAME_LOAD_PIPELINE_H
+#define GAME_LOAD_PIPELINE_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace game
+{
+    /**
+     * Runs the file reading/decoding/parsing part of load tasks on a pool of worker threads
+     * while the thread calling finish() completes them (e.g. GL uploads, cache inserts) in the
+     * order that their work becomes ready.
+     *
+     * A task only starts once all of the tasks it depends on have been completed, tasks can be
+     * added from within completion callbacks to extend the graph as dependencies are discovered.
+     *
+     * update() can be called once per frame instead of finish() to complete tasks in the background.
+     *
+     * @script{ignore}
+    */
+    class LoadPipeline
+    {
+    public:
+        typedef unsigned int TaskId;
+
+        explicit LoadPipeline(unsigned int workerCount);
+        ~LoadPipeline();
+
+        TaskId add(std::function<void()> const & work, std::function<void()> const & complete,
+                   std::vector<TaskId> const & dependencies = std::vector<TaskId>());
+        void finish(std::function<void()> const & onIdle, float idleIntervalMs);
+        bool update();
+        static unsigned int getDefaultWorkerCount();
+    private:
+        struct Task
+        {
+            std::function<void()> _work;
+            std::function<void()> _complete;
+            std::vector<TaskId> _dependents;
+            unsigned int _pendingDependencies;
+            bool _completed;
+        };
+
+        LoadPipeline(LoadPipeline const &);
+
+        void workerThreadProc();
+        void runQueuedWork(std::unique_lock<std::mutex> & lock, bool runAll);
+        void completeReadyTasks(std::unique_lock<std::mutex> & lock);
+
+        std::deque<Task> _tasks;
+        std::deque<TaskId> _queued;
+        std::deque<TaskId> _ready;
+        std::vector<std::thread> _workers;
+        std::mutex _mutex;
+        std::condition_variable _workQueued;
+        std::condition_variable _workReady;
+        unsigned int _outstanding;
+        bool _exiting;
+    };
+}
+
+#endif
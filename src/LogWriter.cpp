@@ -0,0 +1,322 @@
+#include "LogWriter.h"
+
+#include <chrono>
+#include "Common.h"
+#include "FileSystem.h"
+#include "Properties.h"
+#include "Stream.h"
+
+namespace game
+{
+    // Must be a power of two so that positions can wrap around the ring with a mask
+    static unsigned int const LOG_SLOT_COUNT = 1024;
+    static long long const LOG_REPEAT_INTERVAL_MS = 1000;
+
+    static long long getTimeMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static size_t hashMessage(gameplay::Logger::Level level, char const * message)
+    {
+        size_t hash = 2166136261U ^ level;
+
+        while(*message)
+        {
+            hash = (hash ^ static_cast<unsigned char>(*message++)) * 16777619U;
+        }
+
+        return hash;
+    }
+
+    LogWriter::LogWriter()
+        : _enqueuePosition(0)
+        , _dequeuePosition(0)
+        , _lastHash(0)
+        , _lastTime(0)
+        , _written(0)
+        , _dropped(0)
+        , _suppressed(0)
+        , _running(false)
+        , _writerSleeping(false)
+        , _wakeRequested(false)
+        , _reportedDropped(0)
+        , _reportedSuppressed(0)
+        , _file(nullptr)
+    {
+    }
+
+    LogWriter::~LogWriter()
+    {
+        finalize();
+    }
+
+    LogWriter::LogWriter(LogWriter const &)
+    {
+    }
+
+    LogWriter & LogWriter::getInstance()
+    {
+        static LogWriter instance;
+        return instance;
+    }
+
+    void LogWriter::initialize()
+    {
+        if(_running)
+        {
+            return;
+        }
+
+        // The ring is kept after finalize() in case another thread is still writing to it
+        if(!_slots)
+        {
+            _slots.reset(new Slot[LOG_SLOT_COUNT]);
+        }
+
+        for(unsigned int i = 0; i < LOG_SLOT_COUNT; ++i)
+        {
+            _slots[i]._sequence = i;
+        }
+
+        _enqueuePosition = 0;
+        _dequeuePosition = 0;
+        _mainThreadId = std::this_thread::get_id();
+
+        if(getConfig()->exists("log_file"))
+        {
+            std::string const logFile = getConfig()->getString("log_file");
+
+            if(!logFile.empty())
+            {
+                _file = gameplay::FileSystem::open(logFile.c_str(), gameplay::FileSystem::WRITE);
+            }
+        }
+
+        _running = true;
+        _thread.reset(new std::thread(&LogWriter::writerThreadProc, this));
+    }
+
+    void LogWriter::finalize()
+    {
+        if(!_running)
+        {
+            return;
+        }
+
+        _running = false;
+        wakeWriterThread();
+        _thread->join();
+        _thread.reset();
+
+        if(_file)
+        {
+            _file->close();
+            SAFE_DELETE(_file);
+        }
+    }
+
+    void LogWriter::write(gameplay::Logger::Level level, char const * message)
+    {
+        if(!_running)
+        {
+            output(level, message);
+            return;
+        }
+
+        // Only the previous message is compared, a message repeating every frame still appears once per interval
+        size_t const hash = hashMessage(level, message);
+        long long const time = getTimeMs();
+
+        if(_lastHash.exchange(hash, std::memory_order_relaxed) == hash &&
+           time - _lastTime.load(std::memory_order_relaxed) < LOG_REPEAT_INTERVAL_MS)
+        {
+            _suppressed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        _lastTime.store(time, std::memory_order_relaxed);
+
+        // A slot can be claimed once its sequence matches the position, the writer thread moves it a lap ahead when done
+        unsigned int position = _enqueuePosition.load(std::memory_order_relaxed);
+        Slot * slot = nullptr;
+
+        for(;;)
+        {
+            slot = &_slots[position & (LOG_SLOT_COUNT - 1)];
+            int const difference = static_cast<int>(slot->_sequence.load(std::memory_order_acquire) - position);
+
+            if(difference == 0)
+            {
+                if(_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if(difference < 0)
+            {
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else
+            {
+                position = _enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->_level = level;
+        strncpy(slot->_message, message, sizeof(slot->_message) - 1);
+        slot->_message[sizeof(slot->_message) - 1] = '\0';
+        slot->_sequence.store(position + 1, std::memory_order_release);
+
+        // Pairs with the fence in writerThreadProc(), either the writer sees this message or it is woken for it
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if(_writerSleeping.load(std::memory_order_relaxed))
+        {
+            wakeWriterThread();
+        }
+    }
+
+    void LogWriter::flush()
+    {
+        if(!_running)
+        {
+            return;
+        }
+
+        unsigned int const position = _enqueuePosition.load(std::memory_order_acquire);
+
+        while(static_cast<int>(_dequeuePosition.load(std::memory_order_acquire) - position) < 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    bool LogWriter::isMainThread() const
+    {
+        return !_running || std::this_thread::get_id() == _mainThreadId;
+    }
+
+    LogWriter::Stats LogWriter::getStats() const
+    {
+        Stats stats;
+        stats._written = _written.load(std::memory_order_relaxed);
+        stats._dropped = _dropped.load(std::memory_order_relaxed);
+        stats._suppressed = _suppressed.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+#ifndef _FINAL
+    std::vector<std::string> LogWriter::getHistory() const
+    {
+        std::lock_guard<std::mutex> lock(_historyMutex);
+        return std::vector<std::string>(_history.begin(), _history.end());
+    }
+
+    void LogWriter::clearHistory()
+    {
+        std::lock_guard<std::mutex> lock(_historyMutex);
+        _history.clear();
+    }
+#endif
+
+    void LogWriter::writerThreadProc()
+    {
+        for(;;)
+        {
+            // Read before emptying the ring so that nothing written before finalize() is lost
+            bool const running = _running;
+            unsigned int position = _dequeuePosition.load(std::memory_order_relaxed);
+            bool idle = true;
+
+            for(;;)
+            {
+                Slot & slot = _slots[position & (LOG_SLOT_COUNT - 1)];
+
+                if(slot._sequence.load(std::memory_order_acquire) != position + 1)
+                {
+                    break;
+                }
+
+                output(slot._level, slot._message);
+                slot._sequence.store(position + LOG_SLOT_COUNT, std::memory_order_release);
+                _dequeuePosition.store(++position, std::memory_order_release);
+                idle = false;
+            }
+
+            std::array<char, UCHAR_MAX> report;
+            unsigned int const dropped = _dropped.load(std::memory_order_relaxed);
+            unsigned int const suppressed = _suppressed.load(std::memory_order_relaxed);
+
+            if(dropped != _reportedDropped)
+            {
+                sprintf(&report[0], "[log] %u messages dropped\n", dropped - _reportedDropped);
+                output(gameplay::Logger::Level::LEVEL_WARN, &report[0]);
+                _reportedDropped = dropped;
+            }
+
+            if(suppressed != _reportedSuppressed)
+            {
+                sprintf(&report[0], "[log] %u repeated messages suppressed\n", suppressed - _reportedSuppressed);
+                output(gameplay::Logger::Level::LEVEL_INFO, &report[0]);
+                _reportedSuppressed = suppressed;
+            }
+
+            if(!running)
+            {
+                break;
+            }
+
+            if(idle)
+            {
+                // Producers only take the lock to wake this thread once it has announced that it is about to sleep
+                _writerSleeping.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                if(_running && _slots[position & (LOG_SLOT_COUNT - 1)]._sequence.load(std::memory_order_acquire) != position + 1)
+                {
+                    std::unique_lock<std::mutex> lock(_wakeMutex);
+                    _wake.wait(lock, [this]() { return _wakeRequested; });
+                    _wakeRequested = false;
+                }
+
+                _writerSleeping.store(false, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void LogWriter::wakeWriterThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            _wakeRequested = true;
+        }
+        _wake.notify_one();
+    }
+
+    void LogWriter::output(gameplay::Logger::Level level, char const * message)
+    {
+        gameplay::print("%s", message);
+
+        if(_file)
+        {
+            _file->write(message, 1, strlen(message));
+        }
+
+#ifndef _FINAL
+        if(level == gameplay::Logger::Level::LEVEL_INFO)
+        {
+            std::lock_guard<std::mutex> lock(_historyMutex);
+
+            if(_history.size() == GAME_ON_SCREEN_LOG_HISTORY_CAPACITY)
+            {
+                _history.pop_front();
+            }
+
+            _history.push_back(message);
+        }
+#endif
+        _written.fetch_add(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,96 @@
+#ifndef GAME_LOG_WRITER_H
+#define GAME_LOG_WRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Base.h"
+
+namespace gameplay
+{
+    class Stream;
+}
+
+namespace game
+{
+    /**
+     * Writes log messages to stdout and an optional 'log_file' on a background thread.
+     *
+     * Messages are copied into a preallocated ring of fixed size slots that any thread can write to without locking,
+     * messages longer than a slot are truncated. When the ring is full messages are dropped rather than waiting for
+     * the writer thread, and a message that repeats the previous one within a second is suppressed. Both are counted
+     * and reported in the output. The writer thread sleeps while the ring is empty and is woken by the next message.
+     *
+     * Messages are written synchronously before initialize() and after finalize().
+     *
+     * @script{ignore}
+    */
+    class LogWriter
+    {
+    public:
+        struct Stats
+        {
+            unsigned int _written;
+            unsigned int _dropped;
+            unsigned int _suppressed;
+        };
+
+        static LogWriter & getInstance();
+
+        void initialize();
+        void finalize();
+        void write(gameplay::Logger::Level level, char const * message);
+        void flush();
+        bool isMainThread() const;
+        Stats getStats() const;
+#ifndef _FINAL
+        std::vector<std::string> getHistory() const;
+        void clearHistory();
+#endif
+    private:
+        struct Slot
+        {
+            std::atomic<unsigned int> _sequence;
+            gameplay::Logger::Level _level;
+            char _message[256];
+        };
+
+        explicit LogWriter();
+        ~LogWriter();
+        LogWriter(LogWriter const &);
+
+        void writerThreadProc();
+        void wakeWriterThread();
+        void output(gameplay::Logger::Level level, char const * message);
+
+        std::unique_ptr<Slot[]> _slots;
+        std::atomic<unsigned int> _enqueuePosition;
+        std::atomic<unsigned int> _dequeuePosition;
+        std::atomic<size_t> _lastHash;
+        std::atomic<long long> _lastTime;
+        std::atomic<unsigned int> _written;
+        std::atomic<unsigned int> _dropped;
+        std::atomic<unsigned int> _suppressed;
+        std::atomic<bool> _running;
+        std::atomic<bool> _writerSleeping;
+        std::mutex _wakeMutex;
+        std::condition_variable _wake;
+        bool _wakeRequested;
+        unsigned int _reportedDropped;
+        unsigned int _reportedSuppressed;
+        std::unique_ptr<std::thread> _thread;
+        std::thread::id _mainThreadId;
+        gameplay::Stream * _file;
+#ifndef _FINAL
+        mutable std::mutex _historyMutex;
+        std::deque<std::string> _history;
+#endif
+    };
+}
+
+#endif
@@ -17,11 +17,14 @@ namespace game
         GAMEOBJECTS_MESSAGE_TYPE(LevelLoaded)
         GAMEOBJECTS_MESSAGE_TYPE(PreLevelUnloaded)
         GAMEOBJECTS_MESSAGE_TYPE(LevelUnloaded)
+        GAMEOBJECTS_MESSAGE_TYPE(LevelChunkLoaded)
+        GAMEOBJECTS_MESSAGE_TYPE(PreLevelChunkUnloaded)
+        GAMEOBJECTS_MESSAGE_TYPE(LevelChunkUnloaded)
         GAMEOBJECTS_MESSAGE_TYPE(QueueLevelLoad)
-        GAMEOBJECTS_MESSAGE_TYPE(Render)
         GAMEOBJECTS_MESSAGE_TYPE(PreSimulationUpdate)
         GAMEOBJECTS_MESSAGE_TYPE(SimulationUpdate)
         GAMEOBJECTS_MESSAGE_TYPE(PostSimulationUpdate)
+        GAMEOBJECTS_MESSAGE_TYPE(RenderSnapshot)
         GAMEOBJECTS_MESSAGE_TYPE(ScreenFadeStateChanged)
     GAMEOBJECTS_MESSAGE_TYPES_END()
 
@@ -32,9 +35,12 @@ namespace game
     GAMEOBJECTS_MESSAGE_0(PreLevelUnloaded)
     GAMEOBJECTS_MESSAGE_0(PlayerJump)
     GAMEOBJECTS_MESSAGE_0(PlayerReset)
+    GAMEOBJECTS_MESSAGE_0(RenderSnapshot)
     GAMEOBJECTS_MESSAGE_1(QueueLevelLoad, char const *, fileName)
+    GAMEOBJECTS_MESSAGE_1(LevelChunkLoaded, int, chunkIndex)
+    GAMEOBJECTS_MESSAGE_1(PreLevelChunkUnloaded, int, chunkIndex)
+    GAMEOBJECTS_MESSAGE_1(LevelChunkUnloaded, int, chunkIndex)
     GAMEOBJECTS_MESSAGE_1(ScreenFadeStateChanged, bool, isActive)
-    GAMEOBJECTS_MESSAGE_1(Render, float, elapsedTime)
     GAMEOBJECTS_MESSAGE_1(PreSimulationUpdate, float, elapsedTime)
     GAMEOBJECTS_MESSAGE_1(SimulationUpdate, float, elapsedTime)
     GAMEOBJECTS_MESSAGE_1(PostSimulationUpdate, float, elapsedTime)
@@ -62,6 +62,14 @@ namespace game
         gameobjects::setIfExists(properties, "create_physics_on_init", _createPhysicsOnInitialize);
     }
 
+    bool PhysicsLoaderComponent::copyProperties(gameobjects::Component const & prototype)
+    {
+        PhysicsLoaderComponent const & other = static_cast<PhysicsLoaderComponent const &>(prototype);
+        _physics = other._physics;
+        _createPhysicsOnInitialize = other._createPhysicsOnInitialize;
+        return true;
+    }
+
     gameplay::Node * PhysicsLoaderComponent::getNode() const
     {
         return _node;
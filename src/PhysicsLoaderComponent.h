@@ -29,6 +29,7 @@ namespace game
         virtual void initialize() override;
         virtual void finalize() override;
         virtual void readProperties(gameplay::Properties & properties) override;
+        virtual bool copyProperties(gameobjects::Component const & prototype) override;
     private:
         PhysicsLoaderComponent(PhysicsLoaderComponent const &);
 
@@ -1,28 +1,16 @@
 #include "Common.h"
 #include "Platformer.h"
 
-#include "AudioComponent.h"
-#include "CameraComponent.h"
+#include "AudioVoicePool.h"
 #include "Debug.h"
-#include "PhysicsLoaderComponent.h"
 #include "ProfilerController.h"
-#include "EnemyComponent.h"
-#include "GameObjectController.h"
-#include "LevelPlatformsComponent.h"
-#include "LevelCollisionComponent.h"
-#include "LevelLoaderComponent.h"
-#include "LevelRendererComponent.h"
+#include "LogWriter.h"
 #include "Messages.h"
-#include "PlayerComponent.h"
-#include "PlayerResetComponent.h"
-#include "PlayerInputComponent.h"
 #include "ResourceManager.h"
 #include "ScriptController.h"
-#include "Scene.h"
 #include "ScreenOverlay.h"
-#include "SpriteSheet.h"
-#include "SpriteAnimationComponent.h"
 #include "UI.h"
+#include "World.h"
 
 game::Platformer platformer;
 
@@ -33,10 +21,6 @@ namespace game
         , _pinchMessage(nullptr)
         , _touchMessage(nullptr)
         , _mouseMessage(nullptr)
-        , _renderMessage(nullptr)
-        , _preSimulationUpdateMessage(nullptr)
-        , _simulationUpdateMessage(nullptr)
-        , _postSimulationUpdateMessage(nullptr)
         , _elapsedTimeToRender(0.0f)
     {
     }
@@ -51,6 +35,7 @@ namespace game
         gameplay::Logger::set(gameplay::Logger::Level::LEVEL_WARN, loggingCallback);
         gameplay::Logger::set(gameplay::Logger::Level::LEVEL_ERROR, loggingCallback);
         ResourceManager::getInstance().initializeForBoot();
+        LogWriter::getInstance().initialize();
         ScreenOverlay::getInstance().initialize();
         UI::getInstance().initialize();
         DEBUG_INITIALIZE();
@@ -67,6 +52,7 @@ namespace game
         }
 #endif
         setMultiTouch(true);
+        setRenderPipelined(getConfig()->getBool("pipeline_render"));
 
         if (isGestureSupported(gameplay::Gesture::GESTURE_PINCH))
         {
@@ -83,64 +69,46 @@ namespace game
         }
 
         ResourceManager::getInstance().initialize();
-        gameobjects::GameObjectController::getInstance().registerComponent<CameraComponent>("camera");
-        gameobjects::GameObjectController::getInstance().registerComponent<PhysicsLoaderComponent>("physics_loader");
-        gameobjects::GameObjectController::getInstance().registerComponent<EnemyComponent>("enemy");
-        gameobjects::GameObjectController::getInstance().registerComponent<LevelLoaderComponent>("level_loader");
-        gameobjects::GameObjectController::getInstance().registerComponent<LevelRendererComponent>("level_renderer");
-        gameobjects::GameObjectController::getInstance().registerComponent<AudioComponent>("audio");
-        gameobjects::GameObjectController::getInstance().registerComponent<PlayerComponent>("player");
-        gameobjects::GameObjectController::getInstance().registerComponent<PlayerResetComponent>("player_reset");
-        gameobjects::GameObjectController::getInstance().registerComponent<PlayerInputComponent>("player_input");
-        gameobjects::GameObjectController::getInstance().registerComponent<SpriteAnimationComponent>("sprite_animation");
-        gameobjects::GameObjectController::getInstance().registerComponent<LevelCollisionComponent>("level_collision");
-        gameobjects::GameObjectController::getInstance().registerComponent<LevelPlatformsComponent>("level_platforms");
-        gameobjects::GameObjectController::getInstance().initialize();
+        AudioVoicePool::getInstance().initialize();
+        World::getMain().initialize();
 
         _pinchMessage = PinchMessage::create();
         _keyMessage = KeyMessage::create();
         _touchMessage = TouchMessage::create();
         _mouseMessage = MouseMessage::create();
-        _renderMessage = RenderMessage::create();
-        _preSimulationUpdateMessage = PreSimulationUpdateMessage::create();
-        _simulationUpdateMessage = SimulationUpdateMessage::create();
-        _postSimulationUpdateMessage = PostSimulationUpdateMessage::create();
-
-        float const unitInCM = 100;
-        float const unitInPixels = GAME_UNIT_SCALAR;
-        gameplay::Vector3 const gravity = getPhysicsController()->getGravity() * (unitInCM * unitInPixels);
-        gameplay::Camera * camera = gameplay::Camera::createOrthographic(getWidth(), getHeight(), getWidth() / getHeight(), DEFAULT_NEAR_PLANE, DEFAULT_FAR_PLANE);
-        gameplay::Node * node = gameplay::Node::create("camera");
-        node->setCamera(camera);
-        getPhysicsController()->setGravity(gravity);
-        gameobjects::GameObjectController::getInstance().getScene()->addNode(node);
+
         getAudioListener()->setCamera(nullptr);
-        gameobjects::GameObject * rootGameObject = gameobjects::GameObjectController::getInstance().createGameObject("root");
-        gameobjects::GameObjectController::getInstance().createGameObject("level", rootGameObject);
+        std::string const bootLevel = getConfig()->getNamespace("boot", true)->getString("level");
         gameobjects::Message * loadLevel = QueueLevelLoadMessage::create();
-        QueueLevelLoadMessage::setAndBroadcast(loadLevel, getConfig()->getNamespace("boot", true)->getString("level"));
+        QueueLevelLoadMessage::setAndBroadcast(loadLevel, bootLevel.c_str());
         gameobjects::Message::destroy(&loadLevel);
-        camera->release();
-        node->release();
+
+        int const headlessWorldCount = getConfig()->getInt("headless_worlds");
+
+        for(int i = 0; i < headlessWorldCount; ++i)
+        {
+            _headlessWorlds.push_back(World::create(bootLevel));
+        }
     }
 
     void Platformer::finalize()
     {
+        LogWriter::getInstance().finalize();
 #ifdef GP_USE_MEM_LEAK_DETECTION
-        gameobjects::Message * exitMessage = ExitMessage::create();
-        ExitMessage::setAndBroadcast(exitMessage);
-        gameobjects::GameObjectController::getInstance().finalize();
-        gameobjects::Message::destroy(&exitMessage);
+        for(World *& world : _headlessWorlds)
+        {
+            World::destroy(&world);
+        }
+
+        _headlessWorlds.clear();
+        World::getMain().finalize();
         gameobjects::Message::destroy(&_pinchMessage);
         gameobjects::Message::destroy(&_keyMessage);
         gameobjects::Message::destroy(&_touchMessage);
         gameobjects::Message::destroy(&_mouseMessage);
-        gameobjects::Message::destroy(&_renderMessage);
-        gameobjects::Message::destroy(&_preSimulationUpdateMessage);
-        gameobjects::Message::destroy(&_postSimulationUpdateMessage);
-        gameobjects::Message::destroy(&_simulationUpdateMessage);
         UI::getInstance().finalize();
         DEBUG_FINALIZE();
+        AudioVoicePool::getInstance().finalize();
         ScreenOverlay::getInstance().finalize();
         ResourceManager::getInstance().finalize();
 #ifndef _FINAL
@@ -201,13 +169,14 @@ namespace game
     void Platformer::preSimulationUpdate(float elapsedTime)
     {
         PROFILE();
-        PreSimulationUpdateMessage::setAndBroadcast(_preSimulationUpdateMessage, elapsedTime);
+        World::getMain().preSimulationUpdate(elapsedTime);
     }
 
     void Platformer::simulationUpdate(float elapsedTime)
     {
         PROFILE();
-        SimulationUpdateMessage::setAndBroadcast(_simulationUpdateMessage, elapsedTime);
+        // Physics steps the world that is current on the calling thread
+        World::getCurrent().simulationUpdate(elapsedTime);
     }
 
     void Platformer::postSimulationUpdate(float elapsedTime)
@@ -216,7 +185,10 @@ namespace game
         _elapsedTimeToRender = elapsedTime;
         UI::getInstance().update(elapsedTime);
         ScreenOverlay::getInstance().update(elapsedTime);
-        PostSimulationUpdateMessage::setAndBroadcast(_postSimulationUpdateMessage, elapsedTime);
+        ResourceManager::getInstance().update();
+        AudioVoicePool::getInstance().update(elapsedTime);
+        World::getMain().postSimulationUpdate(elapsedTime);
+        World::updateAll(_headlessWorlds, elapsedTime);
     }
 
     void Platformer::render(float)
@@ -224,7 +196,7 @@ namespace game
         DEBUG_RENDER();
         {
             PROFILE();
-            RenderMessage::setAndBroadcast(_renderMessage, _elapsedTimeToRender);
+            World::getMain().render(_elapsedTimeToRender);
             ScreenOverlay::getInstance().render();
             UI::getInstance().render();
             _elapsedTimeToRender = 0.0f;
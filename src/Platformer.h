@@ -6,6 +6,8 @@
 
 namespace game
 {
+    class World;
+
     /**
      * Message pump for game systems
      *
@@ -33,10 +35,7 @@ namespace game
         gameobjects::Message * _keyMessage;
         gameobjects::Message * _touchMessage;
         gameobjects::Message * _mouseMessage;
-        gameobjects::Message * _renderMessage;
-        gameobjects::Message * _preSimulationUpdateMessage;
-        gameobjects::Message * _simulationUpdateMessage;
-        gameobjects::Message * _postSimulationUpdateMessage;
+        std::vector<World *> _headlessWorlds;
         float _elapsedTimeToRender;
     };
 }
@@ -7,6 +7,7 @@
 #include "Messages.h"
 #include "PlayerComponent.h"
 #include "ScreenOverlay.h"
+#include "World.h"
 
 namespace game
 {
@@ -42,9 +43,13 @@ namespace game
 
             if (_player)
             {
-                float const fadeOutDuration = 1.15f;
-                ScreenOverlay::getInstance().queueFadeToBlack(0.0f);
-                ScreenOverlay::getInstance().queueFadeOut(fadeOutDuration);
+                if(!World::getCurrent().isHeadless())
+                {
+                    float const fadeOutDuration = 1.15f;
+                    ScreenOverlay::getInstance().queueFadeToBlack(0.0f);
+                    ScreenOverlay::getInstance().queueFadeOut(fadeOutDuration);
+                }
+
                 _player->reset(_resetPosition);
             }
         }
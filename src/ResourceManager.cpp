@@ -1,11 +1,14 @@
 #include "ResourceManager.h"
 
+#include "AudioSource.h"
 #include "Common.h"
 #include "ProfilerController.h"
+#include "Effect.h"
 #include "FileSystem.h"
 #include "Font.h"
 #include "Game.h"
 #include "GameObjectController.h"
+#include "Image.h"
 #include "LevelCollision.h"
 #include "PropertiesRef.h"
 #include "SpriteBatch.h"
@@ -15,12 +18,18 @@
 namespace game
 {
     static char const * PIXEL_TEXTURE_PATH = "pixel";
+    static float const LOAD_OVERLAY_INTERVAL_MS = 1000.0f / 60.0f;
+    // Cached resources are created with a ref and then retained by the cache
+    static unsigned int const CACHE_REF_COUNT = 2;
 
     ResourceManager::ResourceManager()
+        : _budget(0)
+        , _pinning(false)
 #ifndef _FINAL
-        : _debugFont(nullptr)
+        , _debugFont(nullptr)
 #endif
     {
+        memset(_stats, 0, sizeof(_stats));
     }
 
     ResourceManager::~ResourceManager()
@@ -40,6 +49,9 @@ namespace game
     void ResourceManager::initializeForBoot()
     {
         PROFILE();
+        gameplay::Properties::setCompiledPath(getConfig()->getString("compiled_properties_path"));
+        gameplay::Texture::setCompiledPath(getConfig()->getString("compiled_textures_path"));
+        gameplay::Effect::setProgramCachePath(getConfig()->getString("program_cache_path"));
 #ifndef _FINAL
         if(gameplay::Properties * defaultUserConfig = gameplay::Properties::create("default.config"))
         {
@@ -66,9 +78,29 @@ namespace game
 
             SAFE_DELETE(userConfig);
         }
-
-        loadDebugFont();
 #endif
+        // Development builds read loose files so edits are picked up without rebuilding the pack
+        if(gameplay::Properties * packNs = getConfig()->getNamespace("pack", true))
+        {
+            if(!getConfig()->getBool("ignore_pack"))
+            {
+                char const * packPath = packNs->getString("path");
+                if(!gameplay::FileSystem::mountPack(packPath))
+                {
+                    GAME_LOG("Failed to mount '%s', loading loose files", packPath);
+                }
+            }
+        }
+
+        if(gameplay::Properties * soundBankNs = getConfig()->getNamespace("sound_bank", true))
+        {
+            char const * soundBankPath = soundBankNs->getString("path");
+            if(!gameplay::AudioSource::mountSoundBank(soundBankPath))
+            {
+                GAME_LOG("Failed to mount '%s', decoding sound files", soundBankPath);
+            }
+        }
+
         if(gameplay::Properties * mipMapNs = getConfig()->getNamespace("mip_maps", true))
         {
             while(char const * texturePath = mipMapNs->getNextProperty())
@@ -77,7 +109,14 @@ namespace game
             }
         }
 
-        loadPixelSpritebatch();
+        if(gameplay::Properties * residencyNs = getConfig()->getNamespace("residency", true))
+        {
+            _budget = static_cast<size_t>(residencyNs->getFloat("budget_mb") * 1024 * 1024);
+        }
+
+        // Boot assets are used by the loading screen so they are never evicted
+        _pinning = true;
+        LoadPipeline pipeline(LoadPipeline::getDefaultWorkerCount());
 
         if(gameplay::Properties * bootNs = getConfig()->getNamespace("boot", true))
         {
@@ -85,7 +124,7 @@ namespace game
             {
                 while(char const * texturePath = bootTexturesNs->getNextProperty())
                 {
-                    cacheTexture(texturePath);
+                    queueTexture(pipeline, texturePath);
                 }
             }
 
@@ -93,11 +132,18 @@ namespace game
             {
                 while(char const * spritesheetPath = bootSpritesheetsNs->getNextProperty())
                 {
-                    cacheProperties(spritesheetPath);
-                    cacheSpriteSheet(spritesheetPath);
+                    queueSpriteSheet(pipeline, spritesheetPath);
                 }
             }
         }
+
+        // The workers decode the boot assets while the GL resources below are created
+#ifndef _FINAL
+        loadDebugFont();
+#endif
+        loadPixelSpritebatch();
+        finishLoading(pipeline, false);
+        _pinning = false;
     }
 
 #ifndef _FINAL
@@ -118,11 +164,6 @@ namespace game
         cacheTexture(PIXEL_TEXTURE_PATH, gameplay::Texture::create(gameplay::Texture::Format::RGBA, 1, 1, &rgba.front()));
     }
 
-    gameplay::PropertiesRef * ResourceManager::loadProperties(std::string const & propertyPath)
-    {
-        return gameplay::PropertiesRef::create(gameplay::Properties::create(propertyPath.c_str()));
-    }
-
     class GameObjectCallback : public gameobjects::GameObjectCallbackHandler
     {
     public:
@@ -136,14 +177,18 @@ namespace game
     {
         PROFILE();
 
+        LoadPipeline pipeline(LoadPipeline::getDefaultWorkerCount());
+
+        // Without residency manifests every texture and sprite sheet is loaded up front
+        bool const preloadAll = getConfig()->getNamespace("residency", true) == nullptr;
+
         if (gameplay::Properties * aliases = getConfig()->getNamespace("aliases", true))
         {
-            while(char const * path = aliases->getNextProperty())
+            while(char const * path = preloadAll ? aliases->getNextProperty() : nullptr)
             {
                 if(strstr(aliases->getString(), "."))
                 {
-                    STALL_SCOPE();
-                    cacheTexture("@" + std::string(path));
+                    queueTexture(pipeline, "@" + std::string(path));
                 }
             }
 
@@ -157,198 +202,654 @@ namespace game
             {
                 fileList.clear();
                 gameplay::FileSystem::listFiles(dir, fileList);
+                bool const usesTopLevelNamespaceUrls = propertyDirNamespace->getBool();
 
                 for(std::string & propertyUrl : fileList)
                 {
                     std::string const propertyPath = std::string(dir) + std::string("/") + propertyUrl;
-                    gameplay::PropertiesRef * propertiesRef = getProperties(propertyPath);
-                    bool const usesTopLevelNamespaceUrls = propertyDirNamespace->getBool();
 
-                    if (!propertiesRef)
+                    if(usesTopLevelNamespaceUrls)
                     {
-                        STALL_SCOPE();
-                        propertiesRef = loadProperties(propertyPath);
-
-                        if (!usesTopLevelNamespaceUrls)
-                        {
-                            propertiesRef->addRef();
-                        }
+                        queuePropertiesNamespaces(pipeline, propertyPath);
                     }
                     else
                     {
-                        propertiesRef->release();
+                        queueProperties(pipeline, propertyPath);
                     }
+                }
+            }
+        }
 
-                    if(usesTopLevelNamespaceUrls)
-                    {
-                        gameplay::Properties * properties = propertiesRef->get();
+        if(preloadAll)
+        {
+            fileList.clear();
+            std::string const spriteSheetDirectory = "res/spritesheets";
+            gameplay::FileSystem::listFiles(spriteSheetDirectory.c_str(), fileList);
 
-                        while(gameplay::Properties * topLevelChildNS = properties->getNextNamespace())
-                        {
-                            STALL_SCOPE();
-                            cacheProperties(propertyPath + std::string("#") + topLevelChildNS->getId());
-                        }
+            for (std::string & fileName : fileList)
+            {
+                queueSpriteSheet(pipeline, spriteSheetDirectory + "/" + fileName);
+            }
+        }
 
-                        SAFE_RELEASE(propertiesRef);
-                    }
-                    else
+        finishLoading(pipeline, true);
+        gameobjects::GameObjectController::getInstance().registerCallbackHandler(new GameObjectCallback());
+    }
+
+    void ResourceManager::update()
+    {
+        PROFILE();
+
+        if(_prefetchPipeline && _prefetchPipeline->update())
+        {
+            _prefetchPipeline.reset();
+            _textureTasks.clear();
+            _propertiesTasks.clear();
+        }
+
+        // Prefetched resources aren't referenced until their level is loaded so evicting is deferred until they're all in
+        if(!_prefetchPipeline && _budget > 0 && getCachedBytes() > _budget)
+        {
+            evict();
+        }
+
+        // Only writes when a program was linked since the last save, which is already a hitch
+        gameplay::Effect::saveProgramCache();
+    }
+
+    static std::string getManifestPath(std::string const & levelPath)
+    {
+        gameplay::Properties * residencyNs = getConfig()->getNamespace("residency", true);
+        gameplay::Properties * manifestsNs = residencyNs ? residencyNs->getNamespace("manifests", true) : nullptr;
+        char const * manifestPath = manifestsNs ? manifestsNs->getString(levelPath.c_str()) : nullptr;
+        return manifestPath ? manifestPath : "";
+    }
+
+    void ResourceManager::forEachManifestEntry(std::string const & levelPath, std::function<void(CacheType::Enum, std::string const &)> func) const
+    {
+        std::string const manifestPath = getManifestPath(levelPath);
+
+        if(!manifestPath.empty())
+        {
+            std::unique_ptr<gameplay::Properties> manifest(gameplay::Properties::create(manifestPath.c_str()));
+            GAME_ASSERT(manifest, "Failed to load residency manifest '%s' for '%s'", manifestPath.c_str(), levelPath.c_str());
+
+            std::pair<char const *, CacheType::Enum> const sections[] =
+            {
+                std::make_pair("textures", CacheType::Texture),
+                std::make_pair("spritesheets", CacheType::SpriteSheet),
+                std::make_pair("properties", CacheType::Properties),
+                std::make_pair("effects", CacheType::Effect)
+            };
+
+            for(auto const & section : sections)
+            {
+                if(gameplay::Properties * sectionNs = manifest->getNamespace(section.first, true))
+                {
+                    while(char const * path = sectionNs->getNextProperty())
                     {
-                        _cachedProperties[propertyPath] = propertiesRef;
+                        func(section.second, path);
                     }
                 }
             }
         }
+    }
+
+    void ResourceManager::queueManifest(LoadPipeline & pipeline, std::string const & levelPath)
+    {
+        forEachManifestEntry(levelPath, [this, &pipeline](CacheType::Enum cacheType, std::string const & path)
+        {
+            bool const hit = isCached(cacheType, path);
+            ++(hit ? _stats[cacheType]._hits : _stats[cacheType]._misses);
+
+            if(!hit)
+            {
+                switch(cacheType)
+                {
+                case CacheType::Texture:
+                    queueTexture(pipeline, path);
+                    break;
+                case CacheType::SpriteSheet:
+                    queueSpriteSheet(pipeline, path);
+                    break;
+                case CacheType::Properties:
+                    queueProperties(pipeline, path);
+                    break;
+                case CacheType::Effect:
+                    queueEffect(pipeline, path);
+                    break;
+                default:
+                    break;
+                }
+            }
+        });
+    }
+
+    void ResourceManager::loadLevelResources(std::string const & levelPath)
+    {
+        PROFILE();
+        finishPrefetch();
+        std::string const manifestPath = getManifestPath(levelPath);
+
+        if(manifestPath.empty())
+        {
+            return;
+        }
 
-        fileList.clear();
-        std::string const spriteSheetDirectory = "res/spritesheets";
-        gameplay::FileSystem::listFiles(spriteSheetDirectory.c_str(), fileList);
+        for(Cache & cache : _caches)
+        {
+            for(auto & cachePair : cache)
+            {
+                cachePair.second._levelResident = false;
+            }
+        }
 
-        for (std::string & fileName : fileList)
         {
-            STALL_SCOPE();
-            cacheSpriteSheet(spriteSheetDirectory + "/" + fileName);
+            LoadPipeline pipeline(LoadPipeline::getDefaultWorkerCount());
+            queueManifest(pipeline, levelPath);
+            finishLoading(pipeline, true);
         }
 
-        for(auto & propertyCachePair : _cachedProperties)
+        forEachManifestEntry(levelPath, [this](CacheType::Enum cacheType, std::string const & path)
         {
-            if(propertyCachePair.first.find("/physics/") != std::string::npos)
+            auto itr = _caches[cacheType].find(path);
+
+            if(itr != _caches[cacheType].end())
             {
-                gameplay::Properties * ns = propertyCachePair.second->get();
+                itr->second._levelResident = true;
+                touch(itr->second);
+            }
+        });
 
-                while(char const * propertyName = ns->getNextProperty())
+        evict();
+
+        std::unique_ptr<gameplay::Properties> manifest(gameplay::Properties::create(manifestPath.c_str()));
+
+        if(manifest && manifest->exists("next"))
+        {
+            // A single worker keeps the prefetch from competing with the frame for CPU time
+            _prefetchPipeline.reset(new LoadPipeline(std::min(1u, LoadPipeline::getDefaultWorkerCount())));
+            queueManifest(*_prefetchPipeline, manifest->getString("next"));
+        }
+    }
+
+    void ResourceManager::finishPrefetch()
+    {
+        if(_prefetchPipeline)
+        {
+            finishLoading(*_prefetchPipeline, false);
+            _prefetchPipeline.reset();
+        }
+    }
+
+    void releaseCacheRefs(gameplay::Ref * ref)
+    {
+        if (ref)
+        {
+            for(unsigned int i = 0; i < CACHE_REF_COUNT; ++i)
+            {
+                ref->release();
+            }
+        }
+    }
+
+    void ResourceManager::touch(CachedResource & entry)
+    {
+        _lru.splice(_lru.end(), _lru, entry._lruItr);
+    }
+
+    size_t ResourceManager::getCachedBytes() const
+    {
+        size_t totalBytes = 0;
+
+        for(CacheStats const & stats : _stats)
+        {
+            totalBytes += stats._bytes;
+        }
+
+        return totalBytes;
+    }
+
+    void ResourceManager::evict()
+    {
+        if(_budget == 0)
+        {
+            return;
+        }
+
+        size_t totalBytes = getCachedBytes();
+        bool evicted = true;
+
+        // Releasing a sprite sheet can leave its texture unreferenced after it was passed over, so passes repeat while they free something
+        while(totalBytes > _budget && evicted)
+        {
+            evicted = false;
+            size_t remaining = _lru.size();
+            auto lruItr = _lru.begin();
+
+            while(remaining > 0 && lruItr != _lru.end() && totalBytes > _budget)
+            {
+                --remaining;
+                auto const current = lruItr++;
+                auto const itr = _caches[current->first].find(current->second);
+                CachedResource & entry = itr->second;
+
+                if(entry._pinned || entry._levelResident)
                 {
-                    if(strcmp(propertyName, "group") == 0 || strcmp(propertyName, "mask") == 0 && ns->getType(propertyName) != gameplay::Properties::Type::NUMBER)
-                    {
-                        std::stringstream ss(ns->getString());
-                        std::string value;
-                        int collisionValue = 0;
-                        while (std::getline(ss, value, '|'))
-                        {
-                            collisionValue |= collision::fromString(value);
-                        }
-                        ns->setString(propertyName, toString(collisionValue).c_str());
-                    }
+                    continue;
+                }
+
+                // Anything referenced outside of the cache is in use
+                if(entry._resource->getRefCount() > CACHE_REF_COUNT)
+                {
+                    touch(entry);
+                    continue;
                 }
 
-                ns->rewind();
+                CacheStats & stats = _stats[current->first];
+                stats._bytes -= entry._bytes;
+                --stats._entries;
+                ++stats._evictions;
+                totalBytes -= entry._bytes;
+                releaseCacheRefs(entry._resource);
+                _caches[current->first].erase(itr);
+                _lru.erase(current);
+                evicted = true;
             }
         }
+    }
 
-        gameobjects::GameObjectController::getInstance().registerCallbackHandler(new GameObjectCallback());
+    static size_t getTextureBytes(gameplay::Texture * texture)
+    {
+        size_t const texels = texture->getWidth() * texture->getHeight();
+        size_t bytes = 0;
+
+        switch(texture->getFormat())
+        {
+        case gameplay::Texture::Format::RGBA:
+            bytes = texels * 4;
+            break;
+        case gameplay::Texture::Format::RGB:
+            bytes = texels * 3;
+            break;
+        case gameplay::Texture::Format::RGB565:
+        case gameplay::Texture::Format::RGBA4444:
+        case gameplay::Texture::Format::RGBA5551:
+            bytes = texels * 2;
+            break;
+        case gameplay::Texture::Format::ALPHA:
+            bytes = texels;
+            break;
+        default:
+            // Compressed formats average out at around 4 bits per texel
+            bytes = texels / 2;
+            break;
+        }
+
+        return texture->isMipmapped() ? bytes + bytes / 3 : bytes;
     }
 
-    void ResourceManager::cacheTexture(std::string const & texturePath)
+    static size_t getPropertiesBytes(gameplay::Properties * properties)
     {
-        if(_cachedTextures.find(texturePath) == _cachedTextures.end())
+        size_t bytes = sizeof(gameplay::Properties) + strlen(properties->getNamespace()) + strlen(properties->getId());
+
+        while(char const * name = properties->getNextProperty())
         {
-            PROFILE();
-            gameplay::Texture * texture = gameplay::Texture::create(texturePath.c_str(),
-                _mipMappedTextures.find(texturePath) != _mipMappedTextures.end());
-            texture->addRef();
-            _cachedTextures[texturePath] = texture;
+            bytes += (sizeof(std::string) * 2) + strlen(name) + strlen(properties->getString());
+        }
+
+        while(gameplay::Properties * child = properties->getNextNamespace())
+        {
+            bytes += getPropertiesBytes(child);
+        }
+
+        properties->rewind();
+        return bytes;
+    }
+
+    void ResourceManager::cache(CacheType::Enum cacheType, std::string const & path, gameplay::Ref * resource, size_t bytes)
+    {
+        resource->addRef();
+        CachedResource & entry = _caches[cacheType][path];
+        entry._resource = resource;
+        entry._bytes = bytes;
+        entry._lruItr = _lru.insert(_lru.end(), std::make_pair(cacheType, path));
+        // The gameobjects library keeps hold of the properties it is given without a ref
+        entry._pinned = _pinning || (cacheType == CacheType::Properties && path.find("/gameobjects/") != std::string::npos);
+        entry._levelResident = false;
+        _stats[cacheType]._bytes += bytes;
+        ++_stats[cacheType]._entries;
+    }
+
+    gameplay::Ref * ResourceManager::find(CacheType::Enum cacheType, std::string const & path)
+    {
+        auto itr = _caches[cacheType].find(path);
+
+        if(itr != _caches[cacheType].end())
+        {
+            touch(itr->second);
+            return itr->second._resource;
         }
+
+        return nullptr;
+    }
+
+    bool ResourceManager::isCached(CacheType::Enum cacheType, std::string const & path) const
+    {
+        return _caches[cacheType].find(path) != _caches[cacheType].end();
     }
 
     void ResourceManager::cacheTexture(std::string const & texturePath, gameplay::Texture * texture)
     {
-        texture->addRef();
-        _cachedTextures[texturePath] = texture;
+        if(isCached(CacheType::Texture, texturePath))
+        {
+            SAFE_RELEASE(texture);
+            return;
+        }
+
+        cache(CacheType::Texture, texturePath, texture, getTextureBytes(texture));
+    }
+
+    void ResourceManager::cacheProperties(std::string const & propertiesPath, gameplay::Properties * properties)
+    {
+        if(!properties || isCached(CacheType::Properties, propertiesPath))
+        {
+            SAFE_DELETE(properties);
+            return;
+        }
+
+        if(propertiesPath.find("/physics/") != std::string::npos)
+        {
+            while(char const * propertyName = properties->getNextProperty())
+            {
+                if(strcmp(propertyName, "group") == 0 || strcmp(propertyName, "mask") == 0 && properties->getType(propertyName) != gameplay::Properties::Type::NUMBER)
+                {
+                    std::stringstream ss(properties->getString());
+                    std::string value;
+                    int collisionValue = 0;
+                    while (std::getline(ss, value, '|'))
+                    {
+                        collisionValue |= collision::fromString(value);
+                    }
+                    properties->setString(propertyName, toString(collisionValue).c_str());
+                }
+            }
+
+            properties->rewind();
+        }
+
+        size_t const bytes = getPropertiesBytes(properties);
+        gameplay::PropertiesRef * propertiesRef = gameplay::PropertiesRef::create(properties);
+        cache(CacheType::Properties, propertiesPath, propertiesRef, bytes);
     }
 
     void ResourceManager::cacheSpriteSheet(std::string const & spritesheetPath)
     {
-        if(_cachedSpriteSheets.find(spritesheetPath) == _cachedSpriteSheets.end())
+        if(!isCached(CacheType::SpriteSheet, spritesheetPath))
         {
             PROFILE();
             SpriteSheet * spriteSheet = new SpriteSheet();
             spriteSheet->initialize(spritesheetPath);
-            spriteSheet->addRef();
-            _cachedSpriteSheets[spritesheetPath] = spriteSheet;
+            size_t bytes = sizeof(SpriteSheet);
+            for(auto const & spritePair : spriteSheet->_sprites)
+            {
+                bytes += sizeof(Sprite) + (spritePair.first.size() * 2);
+            }
+            cache(CacheType::SpriteSheet, spritesheetPath, spriteSheet, bytes);
         }
     }
 
-    void ResourceManager::cacheProperties(std::string const & propertiesPath)
+    void ResourceManager::cacheEffect(std::string const & effectId)
     {
-        if(_cachedProperties.find(propertiesPath) == _cachedProperties.end())
+        if(!isCached(CacheType::Effect, effectId))
         {
             PROFILE();
-            gameplay::PropertiesRef * childPropertiesRef = gameplay::PropertiesRef::create(gameplay::Properties::create(propertiesPath.c_str()));
-            childPropertiesRef->addRef();
-            _cachedProperties[propertiesPath] = childPropertiesRef;
+            // Effect ids are '<vertex shader>;<fragment shader>[;<define>...]'
+            size_t const vshEnd = effectId.find(';');
+            size_t const fshEnd = effectId.find(';', vshEnd + 1);
+            GAME_ASSERT(vshEnd != std::string::npos, "Effect '%s' should be '<vertex shader>;<fragment shader>'", effectId.c_str());
+            std::string const vshPath = effectId.substr(0, vshEnd);
+            std::string const fshPath = effectId.substr(vshEnd + 1, fshEnd == std::string::npos ? std::string::npos : fshEnd - vshEnd - 1);
+            std::string const defines = fshEnd == std::string::npos ? std::string() : effectId.substr(fshEnd + 1);
+
+            if(gameplay::Effect * effect = gameplay::Effect::createFromFile(vshPath.c_str(), fshPath.c_str(), defines.empty() ? nullptr : defines.c_str()))
+            {
+                // The size of a linked program isn't exposed by GL
+                cache(CacheType::Effect, effectId, effect, 0);
+            }
         }
     }
 
-    void releaseCacheRefs(gameplay::Ref * ref)
+    LoadPipeline::TaskId ResourceManager::queueTexture(LoadPipeline & pipeline, std::string const & texturePath)
     {
-        if (ref)
+        auto taskItr = _textureTasks.find(texturePath);
+
+        if(taskItr != _textureTasks.end())
+        {
+            return taskItr->second;
+        }
+
+        if(isCached(CacheType::Texture, texturePath))
+        {
+            return pipeline.add(nullptr, nullptr);
+        }
+
+        // Only PNGs are decoded ahead, other formats and compiled textures are uploaded by the texture on the main thread
+        bool const decodeImage = gameplay::FileSystem::getExtension(gameplay::FileSystem::resolvePath(texturePath.c_str())) == ".PNG" &&
+            !gameplay::Texture::isCompiled(texturePath.c_str());
+        bool const generateMipmaps = _mipMappedTextures.find(texturePath) != _mipMappedTextures.end();
+        std::shared_ptr<gameplay::Image *> image = std::make_shared<gameplay::Image *>(nullptr);
+        LoadPipeline::TaskId const taskId = pipeline.add([image, texturePath, decodeImage]()
         {
-            for(int i = 0; i < 2; ++i)
+            if(decodeImage)
             {
-                ref->release();
+                *image = gameplay::Image::create(texturePath.c_str());
             }
+        },
+        [this, image, texturePath, generateMipmaps]()
+        {
+            PROFILE();
+            gameplay::Texture * texture = *image ?
+                gameplay::Texture::create(texturePath.c_str(), *image, generateMipmaps) :
+                gameplay::Texture::create(texturePath.c_str(), generateMipmaps);
+            SAFE_RELEASE(*image);
+            cacheTexture(texturePath, texture);
+        });
+
+        _textureTasks[texturePath] = taskId;
+        return taskId;
+    }
+
+    LoadPipeline::TaskId ResourceManager::queueProperties(LoadPipeline & pipeline, std::string const & propertiesPath)
+    {
+        auto taskItr = _propertiesTasks.find(propertiesPath);
+
+        if(taskItr != _propertiesTasks.end())
+        {
+            return taskItr->second;
         }
+
+        if(isCached(CacheType::Properties, propertiesPath))
+        {
+            return pipeline.add(nullptr, nullptr);
+        }
+
+        std::shared_ptr<gameplay::Properties *> properties = std::make_shared<gameplay::Properties *>(nullptr);
+        LoadPipeline::TaskId const taskId = pipeline.add([properties, propertiesPath]()
+        {
+            *properties = gameplay::Properties::create(propertiesPath.c_str());
+        },
+        [this, properties, propertiesPath]()
+        {
+            cacheProperties(propertiesPath, *properties);
+        });
+
+        _propertiesTasks[propertiesPath] = taskId;
+        return taskId;
     }
 
-    void ResourceManager::finalize()
+    void ResourceManager::queuePropertiesNamespaces(LoadPipeline & pipeline, std::string const & propertiesPath)
     {
-        for(auto pair : _cachedProperties)
+        // Each top level namespace is cached under its own url e.g. 'res/physics/level.physics#platform'
+        typedef std::vector<std::pair<std::string, gameplay::Properties *>> NamespaceList;
+        std::shared_ptr<NamespaceList> namespaces = std::make_shared<NamespaceList>();
+        pipeline.add([namespaces, propertiesPath]()
         {
-            releaseCacheRefs(pair.second);
+            std::unique_ptr<gameplay::Properties> properties(gameplay::Properties::create(propertiesPath.c_str()));
 
-            if(pair.first.find("/gameobjects/") != std::string::npos)
+            if(properties)
             {
-                pair.second->release();
+                while(gameplay::Properties * topLevelChildNS = properties->getNextNamespace())
+                {
+                    std::string const url = propertiesPath + std::string("#") + topLevelChildNS->getId();
+                    namespaces->push_back(std::make_pair(url, gameplay::Properties::create(url.c_str())));
+                }
             }
-        }
+        },
+        [this, namespaces]()
+        {
+            for(auto & namespacePair : *namespaces)
+            {
+                cacheProperties(namespacePair.first, namespacePair.second);
+            }
+        });
+    }
 
-        for(auto pair : _cachedSpriteSheets)
+    void ResourceManager::queueSpriteSheet(LoadPipeline & pipeline, std::string const & spritesheetPath)
+    {
+        if(isCached(CacheType::SpriteSheet, spritesheetPath))
         {
-            releaseCacheRefs(pair.second);
+            return;
         }
 
-        for(auto pair : _cachedTextures)
+        // The texture a sprite sheet depends on is only known once its properties have been parsed
+        std::vector<LoadPipeline::TaskId> const propertiesTask(1, queueProperties(pipeline, spritesheetPath));
+        pipeline.add(nullptr, [this, &pipeline, spritesheetPath]()
         {
-            releaseCacheRefs(pair.second);
+            std::vector<LoadPipeline::TaskId> textureTask;
+
+            if(gameplay::PropertiesRef * propertiesRef = static_cast<gameplay::PropertiesRef *>(find(CacheType::Properties, spritesheetPath)))
+            {
+                gameplay::Properties * meta = propertiesRef->get() ? propertiesRef->get()->getNamespace("meta", true, false) : nullptr;
+
+                if(meta && meta->exists("image"))
+                {
+                    textureTask.push_back(queueTexture(pipeline, meta->getString("image")));
+                }
+            }
+
+            pipeline.add(nullptr, [this, spritesheetPath]()
+            {
+                cacheSpriteSheet(spritesheetPath);
+            }, textureTask);
+        }, propertiesTask);
+    }
+
+    void ResourceManager::queueEffect(LoadPipeline & pipeline, std::string const & effectId)
+    {
+        // Shaders are compiled (or loaded from the program cache) on the main thread as they need the GL context
+        pipeline.add(nullptr, [this, effectId]()
+        {
+            cacheEffect(effectId);
+        });
+    }
+
+    void ResourceManager::finishLoading(LoadPipeline & pipeline, bool renderOverlay)
+    {
+        PROFILE();
+
+        pipeline.finish(renderOverlay ? []()
+        {
+            STALL_SCOPE();
+        } : std::function<void()>(), LOAD_OVERLAY_INTERVAL_MS);
+
+        _textureTasks.clear();
+        _propertiesTasks.clear();
+    }
+
+    void ResourceManager::finalize()
+    {
+        finishPrefetch();
+        gameplay::Effect::saveProgramCache();
+
+        for(int cacheType = 0; cacheType < CacheType::Count; ++cacheType)
+        {
+            for(auto & cachePair : _caches[cacheType])
+            {
+                releaseCacheRefs(cachePair.second._resource);
+
+                if(cacheType == CacheType::Properties && cachePair.first.find("/gameobjects/") != std::string::npos)
+                {
+                    cachePair.second._resource->release();
+                }
+            }
+
+            _caches[cacheType].clear();
         }
 
-        _cachedProperties.clear();
-        _cachedSpriteSheets.clear();
-        _cachedTextures.clear();
+        _lru.clear();
+
+        memset(_stats, 0, sizeof(_stats));
 
 #ifndef _FINAL
         releaseCacheRefs(_debugFont);
 #endif
     }
 
-    gameplay::PropertiesRef * ResourceManager::getProperties(std::string const & url) const
+    gameplay::PropertiesRef * ResourceManager::getProperties(std::string const & url)
     {
-        auto itr = _cachedProperties.find(url);
+        bool const hit = isCached(CacheType::Properties, url);
+        ++(hit ? _stats[CacheType::Properties]._hits : _stats[CacheType::Properties]._misses);
 
-        if(itr != _cachedProperties.end())
+        if(!hit)
         {
-            itr->second->addRef();
-            return itr->second;
+            // Evicted or not part of a manifest, load it now
+            cacheProperties(url, gameplay::Properties::create(url.c_str()));
         }
 
-        return nullptr;
+        gameplay::Ref * propertiesRef = find(CacheType::Properties, url);
+
+        if(propertiesRef)
+        {
+            propertiesRef->addRef();
+        }
+
+        return static_cast<gameplay::PropertiesRef *>(propertiesRef);
     }
 
-    SpriteSheet * ResourceManager::getSpriteSheet(std::string const & url) const
+    SpriteSheet * ResourceManager::getSpriteSheet(std::string const & url)
     {
-        auto itr = _cachedSpriteSheets.find(url);
+        bool const hit = isCached(CacheType::SpriteSheet, url);
+        ++(hit ? _stats[CacheType::SpriteSheet]._hits : _stats[CacheType::SpriteSheet]._misses);
 
-        if(itr != _cachedSpriteSheets.end())
+        if(!hit)
         {
-            itr->second->addRef();
-            return itr->second;
+            cacheSpriteSheet(url);
         }
 
-        return nullptr;
+        gameplay::Ref * spriteSheet = find(CacheType::SpriteSheet, url);
+
+        if(spriteSheet)
+        {
+            spriteSheet->addRef();
+        }
+
+        return static_cast<SpriteSheet *>(spriteSheet);
+    }
+
+    ResourceManager::CacheStats const & ResourceManager::getCacheStats(CacheType::Enum cacheType) const
+    {
+        return _stats[cacheType];
+    }
+
+    size_t ResourceManager::getBudget() const
+    {
+        return _budget;
     }
 
     gameplay::SpriteBatch * ResourceManager::createSinglePixelSpritebatch()
     {
-        return gameplay::SpriteBatch::create(_cachedTextures[PIXEL_TEXTURE_PATH]);
+        return gameplay::SpriteBatch::create(static_cast<gameplay::Texture *>(find(CacheType::Texture, PIXEL_TEXTURE_PATH)));
     }
 
 #ifndef _FINAL
@@ -3,9 +3,12 @@
 
 #include <map>
 #include <functional>
+#include <list>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
+#include "LoadPipeline.h"
 #include "Ref.h"
 
 namespace gameplay
@@ -23,40 +26,108 @@ namespace game
 {
     class SpriteSheet;
 
-    /** @script{ignore} */
+    /**
+     * Caches the textures, sprite sheets, properties and effects used by the game.
+     *
+     * When a 'residency' namespace is present in the config, each level lists the resources it needs in a
+     * manifest which is loaded before the level and the manifest of the level that follows it is prefetched
+     * in the background. Cached resources that are no longer referenced outside of the cache are evicted in
+     * least recently used order whenever the cache exceeds its memory budget, anything requested after being
+     * evicted (or that wasn't in a manifest) is loaded on demand. A resource is used when it is requested, or
+     * when eviction finds it still referenced.
+     *
+     * @script{ignore}
+    */
     class ResourceManager
     {
     public:
+        struct CacheType
+        {
+            enum Enum
+            {
+                Texture,
+                SpriteSheet,
+                Properties,
+                Effect,
+                Count
+            };
+        };
+
+        struct CacheStats
+        {
+            size_t _bytes;
+            unsigned int _entries;
+            unsigned int _hits;
+            unsigned int _misses;
+            unsigned int _evictions;
+        };
+
         static ResourceManager & getInstance();
 
         void initializeForBoot();
         void initialize();
         void finalize();
+        void update();
+        void loadLevelResources(std::string const & levelPath);
 
         gameplay::SpriteBatch * createSinglePixelSpritebatch();
-        gameplay::PropertiesRef * getProperties(std::string const & url) const;
-        SpriteSheet * getSpriteSheet(std::string const & url) const;
+        gameplay::PropertiesRef * getProperties(std::string const & url);
+        SpriteSheet * getSpriteSheet(std::string const & url);
+        CacheStats const & getCacheStats(CacheType::Enum cacheType) const;
+        size_t getBudget() const;
 
 #ifndef _FINAL
         gameplay::Font * getDebugFront() const;
 #endif
     private:
+        // Least recently used first
+        typedef std::list<std::pair<CacheType::Enum, std::string>> LruList;
+
+        struct CachedResource
+        {
+            gameplay::Ref * _resource;
+            size_t _bytes;
+            LruList::iterator _lruItr;
+            bool _pinned;
+            bool _levelResident;
+        };
+
+        typedef std::map<std::string, CachedResource> Cache;
+
         explicit ResourceManager();
         ~ResourceManager();
         ResourceManager(ResourceManager const &);
 
-        void cacheTexture(std::string const & texturePath);
+        void cache(CacheType::Enum cacheType, std::string const & path, gameplay::Ref * resource, size_t bytes);
+        gameplay::Ref * find(CacheType::Enum cacheType, std::string const & path);
+        bool isCached(CacheType::Enum cacheType, std::string const & path) const;
         void cacheTexture(std::string const & texturePath, gameplay::Texture * texture);
+        void cacheProperties(std::string const & propertiesPath, gameplay::Properties * properties);
         void cacheSpriteSheet(std::string const & spritesheetPath);
-        void cacheProperties(std::string const & propertiesPath);
+        void cacheEffect(std::string const & effectId);
         void loadPixelSpritebatch();
-        gameplay::PropertiesRef * loadProperties(std::string const & propertyPath);
+        LoadPipeline::TaskId queueTexture(LoadPipeline & pipeline, std::string const & texturePath);
+        LoadPipeline::TaskId queueProperties(LoadPipeline & pipeline, std::string const & propertiesPath);
+        void queuePropertiesNamespaces(LoadPipeline & pipeline, std::string const & propertiesPath);
+        void queueSpriteSheet(LoadPipeline & pipeline, std::string const & spritesheetPath);
+        void queueEffect(LoadPipeline & pipeline, std::string const & effectId);
+        void queueManifest(LoadPipeline & pipeline, std::string const & levelPath);
+        void forEachManifestEntry(std::string const & levelPath, std::function<void(CacheType::Enum, std::string const &)> func) const;
+        void finishLoading(LoadPipeline & pipeline, bool renderOverlay);
+        void finishPrefetch();
+        void touch(CachedResource & entry);
+        size_t getCachedBytes() const;
+        void evict();
 
-        std::map<std::string, gameplay::Texture *> _cachedTextures;
-        std::map<std::string, gameplay::PropertiesRef *> _cachedProperties;
-        std::map<std::string, SpriteSheet *> _cachedSpriteSheets;
+        Cache _caches[CacheType::Count];
+        LruList _lru;
+        CacheStats _stats[CacheType::Count];
+        std::map<std::string, LoadPipeline::TaskId> _textureTasks;
+        std::map<std::string, LoadPipeline::TaskId> _propertiesTasks;
         std::set<std::string> _mipMappedTextures;
-        std::vector<std::function<void()>> _slowTasks;
+        std::unique_ptr<LoadPipeline> _prefetchPipeline;
+        size_t _budget;
+        bool _pinning;
 
 #ifndef _FINAL
         void loadDebugFont();
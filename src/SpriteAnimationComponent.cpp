@@ -25,6 +25,62 @@ namespace game
     }
 
     void SpriteAnimationComponent::initialize()
+    {
+        if (_autoStart)
+        {
+            play();
+        }
+    }
+
+    void SpriteAnimationComponent::readProperties(gameplay::Properties & properties)
+    {
+        _autoStart = properties.getBool("autostart", _autoStart);
+        _loop = properties.getBool("loop", _loop);
+        gameobjects::setIfExists(properties, "fps", _fps);
+        gameobjects::setIfExists(properties, "scale", _scale);
+        _spriteSheetPath = properties.getString("spritesheet", _spriteSheetPath.c_str());
+        GAME_ASSERT(gameplay::FileSystem::fileExists(_spriteSheetPath.c_str()), "Spritesheet '%s' not found", _spriteSheetPath.c_str());
+
+        if(!properties.exists("sprite"))
+        {
+            _spritePrefix = properties.getString("spriteprefix", _spritePrefix.c_str());
+            GAME_ASSERT(!_spritePrefix.empty(), "Sprite prefix cannot be empty");
+        }
+        else
+        {
+            while(char const * propertyName = properties.getNextProperty())
+            {
+                if(strcmp(propertyName, "sprite") == 0)
+                {
+                    _spriteNames.push_back(properties.getString());
+                }
+            }
+
+            properties.rewind();
+
+            GAME_ASSERT(!_spriteNames.empty(), "No sprites were specified");
+        }
+
+        // The sprites are resolved here rather than in initialize so that instances copied from a prototype skip the lookups
+        loadSprites();
+    }
+
+    bool SpriteAnimationComponent::copyProperties(gameobjects::Component const & prototype)
+    {
+        SpriteAnimationComponent const & other = static_cast<SpriteAnimationComponent const &>(prototype);
+        _frameCount = other._frameCount;
+        _scale = other._scale;
+        _fps = other._fps;
+        _autoStart = other._autoStart;
+        _loop = other._loop;
+        _spritePrefix = other._spritePrefix;
+        _spriteSheetPath = other._spriteSheetPath;
+        _sprites = other._sprites;
+        _spriteNames = other._spriteNames;
+        return true;
+    }
+
+    void SpriteAnimationComponent::loadSprites()
     {
         _fps = 1000.0f / _fps;
 
@@ -88,41 +144,6 @@ namespace game
         }
 
         SAFE_RELEASE(spriteSheet);
-
-        if (_autoStart)
-        {
-            play();
-        }
-    }
-
-    void SpriteAnimationComponent::readProperties(gameplay::Properties & properties)
-    {
-        _autoStart = properties.getBool("autostart", _autoStart);
-        _loop = properties.getBool("loop", _loop);
-        gameobjects::setIfExists(properties, "fps", _fps);
-        gameobjects::setIfExists(properties, "scale", _scale);
-        _spriteSheetPath = properties.getString("spritesheet", _spriteSheetPath.c_str());
-        GAME_ASSERT(gameplay::FileSystem::fileExists(_spriteSheetPath.c_str()), "Spritesheet '%s' not found", _spriteSheetPath.c_str());
-
-        if(!properties.exists("sprite"))
-        {
-            _spritePrefix = properties.getString("spriteprefix", _spritePrefix.c_str());
-            GAME_ASSERT(!_spritePrefix.empty(), "Sprite prefix cannot be empty");
-        }
-        else
-        {
-            while(char const * propertyName = properties.getNextProperty())
-            {
-                if(strcmp(propertyName, "sprite") == 0)
-                {
-                    _spriteNames.push_back(properties.getString());
-                }
-            }
-
-            properties.rewind();
-
-            GAME_ASSERT(!_spriteNames.empty(), "No sprites were specified");
-        }
     }
 
     void SpriteAnimationComponent::update(float dt)
@@ -43,6 +43,7 @@ namespace game
 
         virtual void initialize() override;
         virtual void readProperties(gameplay::Properties & properties) override;
+        virtual bool copyProperties(gameobjects::Component const & prototype) override;
 
         void play();
         void pause();
@@ -61,6 +62,8 @@ namespace game
     private:
         SpriteAnimationComponent(SpriteAnimationComponent const &);
 
+        void loadSprites();
+
         float _elapsed;
         int _frameCount;
         int _frameIndex;
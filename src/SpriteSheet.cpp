@@ -60,6 +60,7 @@ namespace game
             }
         }
 
+        properties->rewind();
         SAFE_RELEASE(propertyRef);
     }
 
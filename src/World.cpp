@@ -0,0 +1,251 @@
+#include "World.h"
+
+#include "AudioComponent.h"
+#include "CameraComponent.h"
+#include "Common.h"
+#include "EnemyComponent.h"
+#include "Game.h"
+#include "GameObjectController.h"
+#include "LevelActivationComponent.h"
+#include "LevelCollisionComponent.h"
+#include "LevelLoaderComponent.h"
+#include "LevelPlatformsComponent.h"
+#include "LevelRendererComponent.h"
+#include "Messages.h"
+#include "PhysicsLoaderComponent.h"
+#include "PlayerComponent.h"
+#include "PlayerInputComponent.h"
+#include "PlayerResetComponent.h"
+#include "ProfilerController.h"
+#include "Scene.h"
+#include "SpriteAnimationComponent.h"
+
+namespace game
+{
+    // The world made current on the calling thread, the main world is used when there isn't one
+    static thread_local World * currentWorld = nullptr;
+
+    World::Scope::Scope(World & world)
+        : _previous(currentWorld)
+    {
+        currentWorld = &world;
+        gameobjects::GameObjectController::setCurrent(world._gameObjectController);
+        gameplay::Game::setCurrentPhysicsController(world._physicsController);
+    }
+
+    World::Scope::~Scope()
+    {
+        currentWorld = _previous;
+        gameobjects::GameObjectController::setCurrent(_previous ? _previous->_gameObjectController : nullptr);
+        gameplay::Game::setCurrentPhysicsController(_previous ? _previous->_physicsController : nullptr);
+    }
+
+    World::Scope::Scope(Scope const &)
+    {
+    }
+
+    World::World(bool headless)
+        : _headless(headless)
+        , _gameObjectController(nullptr)
+        , _physicsController(nullptr)
+        , _levelLoader(nullptr)
+        , _levelRenderer(nullptr)
+        , _preSimulationUpdateMessage(nullptr)
+        , _simulationUpdateMessage(nullptr)
+        , _postSimulationUpdateMessage(nullptr)
+        , _renderSnapshotMessage(nullptr)
+    {
+    }
+
+    World::~World()
+    {
+    }
+
+    World::World(World const &)
+    {
+    }
+
+    World & World::getMain()
+    {
+        static World instance(false);
+        return instance;
+    }
+
+    World & World::getCurrent()
+    {
+        return currentWorld ? *currentWorld : getMain();
+    }
+
+    World * World::create(std::string const & level)
+    {
+        World * world = new World(true);
+        world->_gameObjectController = gameobjects::GameObjectController::create();
+        world->_physicsController = gameplay::Game::getInstance()->createPhysicsController();
+        world->initialize();
+        Scope scope(*world);
+        gameobjects::Message * loadLevel = QueueLevelLoadMessage::create();
+        QueueLevelLoadMessage::setAndBroadcast(loadLevel, level.c_str());
+        gameobjects::Message::destroy(&loadLevel);
+        world->_levelLoader->processLoadRequests();
+        return world;
+    }
+
+    void World::destroy(World ** world)
+    {
+        (*world)->finalize();
+        gameobjects::GameObjectController::destroy(&(*world)->_gameObjectController);
+        gameplay::Game::getInstance()->destroyPhysicsController((*world)->_physicsController);
+        SAFE_DELETE(*world);
+    }
+
+    void World::updateAll(std::vector<World *> const & worlds, float elapsedTime)
+    {
+        PROFILE();
+        gameplay::Game::getInstance()->getJobController()->parallelFor(worlds.size(), 1, [&worlds, elapsedTime](unsigned int begin, unsigned int end)
+        {
+            for(unsigned int i = begin; i < end; ++i)
+            {
+                worlds[i]->update(elapsedTime);
+            }
+        });
+
+        // Loading creates textures so it waits until the worlds are back on this thread
+        for(World * world : worlds)
+        {
+            world->processLoadRequests();
+        }
+    }
+
+    void World::initialize()
+    {
+        if(!_headless)
+        {
+            _gameObjectController = &gameobjects::GameObjectController::getInstance();
+            _physicsController = gameplay::Game::getInstance()->getPhysicsController();
+        }
+
+        Scope scope(*this);
+        _gameObjectController->registerComponent<CameraComponent>("camera");
+        _gameObjectController->registerComponent<PhysicsLoaderComponent>("physics_loader");
+        _gameObjectController->registerComponent<EnemyComponent>("enemy");
+        _gameObjectController->registerComponent<LevelLoaderComponent>("level_loader");
+        _gameObjectController->registerComponent<PlayerComponent>("player");
+        _gameObjectController->registerComponent<PlayerResetComponent>("player_reset");
+        _gameObjectController->registerComponent<SpriteAnimationComponent>("sprite_animation");
+        _gameObjectController->registerComponent<LevelCollisionComponent>("level_collision");
+        _gameObjectController->registerComponent<LevelPlatformsComponent>("level_platforms");
+        _gameObjectController->registerComponent<LevelActivationComponent>("level_activation");
+
+        if(_headless)
+        {
+            _gameObjectController->ignoreComponent("level_renderer");
+            _gameObjectController->ignoreComponent("audio");
+            _gameObjectController->ignoreComponent("player_input");
+        }
+        else
+        {
+            _gameObjectController->registerComponent<LevelRendererComponent>("level_renderer");
+            _gameObjectController->registerComponent<AudioComponent>("audio");
+            _gameObjectController->registerComponent<PlayerInputComponent>("player_input");
+        }
+
+        _gameObjectController->initialize();
+
+        _preSimulationUpdateMessage = PreSimulationUpdateMessage::create();
+        _simulationUpdateMessage = SimulationUpdateMessage::create();
+        _postSimulationUpdateMessage = PostSimulationUpdateMessage::create();
+        _renderSnapshotMessage = RenderSnapshotMessage::create();
+
+        gameplay::Game * game = gameplay::Game::getInstance();
+        float const unitInCM = 100;
+        float const unitInPixels = GAME_UNIT_SCALAR;
+        gameplay::Vector3 const gravity = _physicsController->getGravity() * (unitInCM * unitInPixels);
+        gameplay::Camera * camera = gameplay::Camera::createOrthographic(game->getWidth(), game->getHeight(), game->getWidth() / game->getHeight(), DEFAULT_NEAR_PLANE, DEFAULT_FAR_PLANE);
+        gameplay::Node * node = gameplay::Node::create("camera");
+        node->setCamera(camera);
+        _physicsController->setGravity(gravity);
+        _gameObjectController->getScene()->addNode(node);
+        gameobjects::GameObject * rootGameObject = _gameObjectController->createGameObject("root");
+        gameobjects::GameObject * levelGameObject = _gameObjectController->createGameObject("level", rootGameObject);
+        _levelLoader = levelGameObject->getComponent<LevelLoaderComponent>();
+        _levelRenderer = levelGameObject->getComponent<LevelRendererComponent>();
+        camera->release();
+        node->release();
+    }
+
+    void World::finalize()
+    {
+        Scope scope(*this);
+        gameobjects::Message * exitMessage = ExitMessage::create();
+        ExitMessage::setAndBroadcast(exitMessage);
+        _gameObjectController->finalize();
+        _levelLoader = nullptr;
+        _levelRenderer = nullptr;
+        gameobjects::Message::destroy(&exitMessage);
+        gameobjects::Message::destroy(&_preSimulationUpdateMessage);
+        gameobjects::Message::destroy(&_postSimulationUpdateMessage);
+        gameobjects::Message::destroy(&_simulationUpdateMessage);
+        gameobjects::Message::destroy(&_renderSnapshotMessage);
+    }
+
+    void World::update(float elapsedTime)
+    {
+        GAME_ASSERT(_headless, "The main world is stepped by the game");
+        Scope scope(*this);
+        preSimulationUpdate(elapsedTime);
+        // Steps the physics world which broadcasts the simulation update through the game, see Platformer::simulationUpdate()
+        gameplay::Game::getInstance()->updatePhysicsController(_physicsController, elapsedTime);
+        postSimulationUpdate(elapsedTime);
+    }
+
+    void World::preSimulationUpdate(float elapsedTime)
+    {
+        PreSimulationUpdateMessage::setAndBroadcast(_preSimulationUpdateMessage, elapsedTime);
+    }
+
+    void World::simulationUpdate(float elapsedTime)
+    {
+        SimulationUpdateMessage::setAndBroadcast(_simulationUpdateMessage, elapsedTime);
+    }
+
+    void World::postSimulationUpdate(float elapsedTime)
+    {
+        PostSimulationUpdateMessage::setAndBroadcast(_postSimulationUpdateMessage, elapsedTime);
+
+        if(!_headless)
+        {
+            // Captured after all updates so the next render, which may overlap the next physics step, sees a complete frame
+            RenderSnapshotMessage::setAndBroadcast(_renderSnapshotMessage);
+        }
+    }
+
+    void World::render(float elapsedTime)
+    {
+        // Not broadcast, the physics thread may be broadcasting the simulation update through the same controller
+        if(_levelRenderer)
+        {
+            _levelRenderer->render(elapsedTime);
+        }
+    }
+
+    void World::processLoadRequests()
+    {
+        Scope scope(*this);
+        _levelLoader->processLoadRequests();
+    }
+
+    bool World::isHeadless() const
+    {
+        return _headless;
+    }
+
+    gameobjects::GameObjectController * World::getGameObjectController() const
+    {
+        return _gameObjectController;
+    }
+
+    gameplay::PhysicsController * World::getPhysicsController() const
+    {
+        return _physicsController;
+    }
+}
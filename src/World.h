@@ -0,0 +1,92 @@
+#ifndef GAME_WORLD_H
+#define GAME_WORLD_H
+
+#include <string>
+#include <vector>
+#include "GameObjectMessage.h"
+
+namespace gameobjects
+{
+    class GameObjectController;
+}
+
+namespace gameplay
+{
+    class PhysicsController;
+}
+
+namespace game
+{
+    class LevelLoaderComponent;
+    class LevelRendererComponent;
+
+    /**
+     * A level being simulated, it owns a scene of game objects, a physics world and the messages used to step them.
+     *
+     * The main world wraps the default GameObjectController and the physics controller owned by the game, it is presented
+     * to the player. Headless worlds are created alongside it to simulate levels without rendering, audio or input, for
+     * automated playtesting and load generation. Their renderer, audio and input components are skipped.
+     *
+     * Code that uses GameObjectController::getInstance() or Game::getPhysicsController() reaches the world that is current
+     * on the calling thread, see World::Scope. Worlds can step concurrently on different threads, read only resources are
+     * shared through the ResourceManager while presentation, such as the ScreenOverlay and UI, belongs to the main world.
+     *
+     * @script{ignore}
+    */
+    class World
+    {
+    public:
+        /**
+         * Makes a world current on the calling thread until it goes out of scope
+         */
+        class Scope
+        {
+        public:
+            explicit Scope(World & world);
+            ~Scope();
+        private:
+            Scope(Scope const &);
+
+            World * _previous;
+        };
+
+        static World & getMain();
+        static World & getCurrent();
+        static World * create(std::string const & level);
+        static void destroy(World ** world);
+
+        /**
+         * Steps the worlds using the job controller, one job per world. Levels requested while stepping in a job
+         * are loaded afterwards on the calling thread.
+         */
+        static void updateAll(std::vector<World *> const & worlds, float elapsedTime);
+
+        void initialize();
+        void finalize();
+        void update(float elapsedTime);
+        void preSimulationUpdate(float elapsedTime);
+        void simulationUpdate(float elapsedTime);
+        void postSimulationUpdate(float elapsedTime);
+        void render(float elapsedTime);
+        void processLoadRequests();
+        bool isHeadless() const;
+        gameobjects::GameObjectController * getGameObjectController() const;
+        gameplay::PhysicsController * getPhysicsController() const;
+    private:
+        explicit World(bool headless);
+        ~World();
+        World(World const &);
+
+        bool _headless;
+        gameobjects::GameObjectController * _gameObjectController;
+        gameplay::PhysicsController * _physicsController;
+        LevelLoaderComponent * _levelLoader;
+        LevelRendererComponent * _levelRenderer;
+        gameobjects::Message * _preSimulationUpdateMessage;
+        gameobjects::Message * _simulationUpdateMessage;
+        gameobjects::Message * _postSimulationUpdateMessage;
+        gameobjects::Message * _renderSnapshotMessage;
+    };
+}
+
+#endif